@@ -17,6 +17,7 @@ public class CPP_Tests : ModuleRules
 			"EnhancedInput",
 			"AIModule",
 			"NavigationSystem",
+			"GameplayTags",
 			"StateTreeModule",
 			"GameplayStateTreeModule",
 			"UMG",
@@ -11,6 +11,7 @@
 #include "Kismet/KismetSystemLibrary.h"
 
 #include "CPP_Tests.h"
+#include "CPP_TestsStats.h"
 #include "Interactable.h"
 #include "Engine/Engine.h"
 
@@ -20,6 +21,8 @@
 #include "EquipmentComponent.h"
 
 #include "LockOnTargetable.h"
+#include "PickupSubsystem.h"
+#include "HazardSubsystem.h"
 
 DEFINE_LOG_CATEGORY(LogTemplateCharacter);
 
@@ -82,6 +85,24 @@ void ACPP_TestsCharacter::BeginPlay()
 
     LockOnDisengageHeldSeconds = 0.f;
     LastLockOnLookInputTime = -1.f;
+
+    if (UHazardSubsystem* Hazards = GetWorld()->GetSubsystem<UHazardSubsystem>())
+    {
+        Hazards->RegisterSubject(this);
+    }
+}
+
+void ACPP_TestsCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UWorld* World = GetWorld())
+    {
+        if (UHazardSubsystem* Hazards = World->GetSubsystem<UHazardSubsystem>())
+        {
+            Hazards->UnregisterSubject(this);
+        }
+    }
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void ACPP_TestsCharacter::Landed(const FHitResult& Hit)
@@ -198,11 +219,6 @@ void ACPP_TestsCharacter::Tick(float DeltaSeconds)
     const FVector Vel = GetVelocity();
     const bool bIsMoving = Vel.SizeSquared2D() > 5.f;
 
-    if (StatusEffects && Stats)
-    {
-        StatusEffects->TickEffects(DeltaSeconds, Stats, bIsMoving);
-    }
-
     float MoveMult = StatusEffects ? StatusEffects->GetMoveSpeedMultiplier() : 1.f;
     MoveMult *= GetLowHealthMoveMultiplier();
 
@@ -234,14 +250,40 @@ void ACPP_TestsCharacter::Tick(float DeltaSeconds)
 
     if (Stats)
     {
-        const float MagicMult = StatusEffects ? StatusEffects->GetMagicRegenMultiplier() : 1.f;
-        Stats->TickMagic(DeltaSeconds, MagicMult);
+        const float Step = 1.f / FMath::Max(1.f, StatSimulationHz);
+        StatSimulationAccumulator += DeltaSeconds;
+
+        int32 Steps = 0;
+        while (StatSimulationAccumulator >= Step && Steps < MaxStatStepsPerFrame)
+        {
+            StatSimulationAccumulator -= Step;
+            ++Steps;
+            SimulateStatsStep(Step, bIsFalling, bIsMoving);
+        }
 
-        if (!bIsFalling)
+        if (Steps >= MaxStatStepsPerFrame)
         {
-            const float RegenMult = StatusEffects ? StatusEffects->GetStaminaRegenMultiplier() : 1.f;
-            Stats->TickStamina(DeltaSeconds, bSprintHeld, bIsMoving, RegenMult);
+            StatSimulationAccumulator = FMath::Min(StatSimulationAccumulator, Step);
         }
+
+        // The HUD blends between the last two steps with this
+        Stats->SetDisplayAlpha(StatSimulationAccumulator / Step);
+    }
+}
+
+void ACPP_TestsCharacter::SimulateStatsStep(float StepSeconds, bool bIsFalling, bool bIsMoving)
+{
+    Stats->CaptureDisplaySnapshot();
+
+    FScopedStatTransaction StatTransaction(Stats);
+
+    const float MagicMult = StatusEffects ? StatusEffects->GetMagicRegenMultiplier() : 1.f;
+    Stats->TickMagic(StepSeconds, MagicMult);
+
+    if (!bIsFalling)
+    {
+        const float RegenMult = StatusEffects ? StatusEffects->GetStaminaRegenMultiplier() : 1.f;
+        Stats->TickStamina(StepSeconds, bSprintHeld, bIsMoving, RegenMult);
     }
 }
 
@@ -502,17 +544,22 @@ void ACPP_TestsCharacter::DoInteract()
     FCollisionQueryParams Params(SCENE_QUERY_STAT(InteractTrace), true, this);
 
     const bool bHit = GetWorld()->LineTraceSingleByChannel(Hit, Start, End, ECC_Visibility, Params);
-    if (!bHit)
+
+    AActor* HitActor = bHit ? Hit.GetActor() : nullptr;
+    if (HitActor && HitActor->GetClass()->ImplementsInterface(UInteractable::StaticClass()))
     {
+        IInteractable::Execute_Interact(HitActor, this);
         return;
     }
 
-    AActor* HitActor = Hit.GetActor();
-    if (!HitActor) return;
-
-    if (HitActor->GetClass()->ImplementsInterface(UInteractable::StaticClass()))
+    // Record pickups have no collision; check the unblocked part of the trace against the pickup grid
+    if (UPickupSubsystem* Pickups = GetWorld()->GetSubsystem<UPickupSubsystem>())
     {
-        IInteractable::Execute_Interact(HitActor, this);
+        const FVector QueryEnd = bHit ? Hit.ImpactPoint : End;
+        if (const int32 PickupId = Pickups->FindPickupAlongSegment(Start, QueryEnd))
+        {
+            Pickups->InteractWithPickup(PickupId, this);
+        }
     }
 }
 
@@ -577,6 +624,8 @@ FVector ACPP_TestsCharacter::GetLockOnAimPoint(AActor* Target) const
 
 AActor* ACPP_TestsCharacter::FindBestLockOnTarget() const
 {
+    CPPTESTS_SCOPE(STAT_CPPTests_FindLockOnTarget, Player_FindBestLockOnTarget);
+
     UWorld* World = GetWorld();
     if (!World) return nullptr;
 
@@ -69,6 +69,14 @@ protected:
     UPROPERTY(EditAnywhere, Category="Movement|Stamina")
     float JumpStaminaCost = 15.f;
 
+    // Stamina/health/magic regen runs at this fixed rate, whatever the framerate
+    UPROPERTY(EditAnywhere, Category="Stats|Simulation", meta=(ClampMin="1.0", Units="Hz"))
+    float StatSimulationHz = 20.f;
+
+    // After a hitch the rest of the backlog is dropped rather than simulated in one frame
+    UPROPERTY(EditAnywhere, Category="Stats|Simulation", meta=(ClampMin="1"))
+    int32 MaxStatStepsPerFrame = 4;
+
     // Lock-on settings
     UPROPERTY(EditAnywhere, Category="Combat|LockOn", meta=(ClampMin="0.0"))
     float LockOnSearchRadius = 2000.f;
@@ -126,6 +134,7 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void Tick(float DeltaSeconds) override;
     virtual void Landed(const FHitResult& Hit) override;
 
@@ -142,6 +151,10 @@ protected:
 
     float AirLockedSpeed = 600.f;
 
+    float StatSimulationAccumulator = 0.f;
+
+    void SimulateStatsStep(float StepSeconds, bool bIsFalling, bool bIsMoving);
+
     UFUNCTION(BlueprintCallable, Category="Input")
     virtual void DoAim(float Yaw, float Pitch);
 
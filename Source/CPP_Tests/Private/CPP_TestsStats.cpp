@@ -0,0 +1,94 @@
+#include "CPP_TestsStats.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/LowLevelMemStats.h"
+#include "Misc/OutputDevice.h"
+
+DEFINE_STAT(STAT_CPPTests_BrainTick);
+DEFINE_STAT(STAT_CPPTests_RebuildForest);
+DEFINE_STAT(STAT_CPPTests_RefreshInventoryGrid);
+DEFINE_STAT(STAT_CPPTests_ConfirmTrade);
+DEFINE_STAT(STAT_CPPTests_StatusEffectStep);
+DEFINE_STAT(STAT_CPPTests_HazardApply);
+DEFINE_STAT(STAT_CPPTests_FindLockOnTarget);
+
+DEFINE_STAT(STAT_CPPTests_NPCsWander);
+DEFINE_STAT(STAT_CPPTests_NPCsChase);
+DEFINE_STAT(STAT_CPPTests_NPCsFlee);
+DEFINE_STAT(STAT_CPPTests_NPCsReturnHome);
+
+DEFINE_STAT(STAT_CPPTests_NavQueries);
+DEFINE_STAT(STAT_CPPTests_WidgetRebuilds);
+DEFINE_STAT(STAT_CPPTests_WidgetsCreated);
+DEFINE_STAT(STAT_CPPTests_InstancesGenerated);
+
+CSV_DEFINE_CATEGORY(CPPTests, true);
+
+// -------------------------
+// LLM
+// -------------------------
+
+DECLARE_LLM_MEMORY_STAT(TEXT("CPPTests"), STAT_CPPTestsLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("CPPTests Forest"), STAT_CPPTestsLLM_Forest, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("CPPTests NPCs"), STAT_CPPTestsLLM_NPCs, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("CPPTests NPC Nav"), STAT_CPPTestsLLM_NPCNav, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("CPPTests NPC Widgets"), STAT_CPPTestsLLM_NPCWidgets, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("CPPTests Menu"), STAT_CPPTestsLLM_Menu, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("CPPTests Merchant"), STAT_CPPTestsLLM_Merchant, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("CPPTests Status Effects"), STAT_CPPTestsLLM_StatusEffects, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("CPPTests Pickups"), STAT_CPPTestsLLM_Pickups, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("CPPTests"), STAT_CPPTestsSummaryLLM, STATGROUP_LLM);
+
+LLM_DEFINE_TAG(CPPTests, NAME_None, NAME_None, GET_STATFNAME(STAT_CPPTestsLLM), GET_STATFNAME(STAT_CPPTestsSummaryLLM));
+LLM_DEFINE_TAG(CPPTests_Forest, TEXT("Forest"), TEXT("CPPTests"), GET_STATFNAME(STAT_CPPTestsLLM_Forest), GET_STATFNAME(STAT_CPPTestsSummaryLLM));
+LLM_DEFINE_TAG(CPPTests_NPCs, TEXT("NPCs"), TEXT("CPPTests"), GET_STATFNAME(STAT_CPPTestsLLM_NPCs), GET_STATFNAME(STAT_CPPTestsSummaryLLM));
+LLM_DEFINE_TAG(CPPTests_NPCNav, TEXT("NPC Nav"), TEXT("CPPTests"), GET_STATFNAME(STAT_CPPTestsLLM_NPCNav), GET_STATFNAME(STAT_CPPTestsSummaryLLM));
+LLM_DEFINE_TAG(CPPTests_NPCWidgets, TEXT("NPC Widgets"), TEXT("CPPTests"), GET_STATFNAME(STAT_CPPTestsLLM_NPCWidgets), GET_STATFNAME(STAT_CPPTestsSummaryLLM));
+LLM_DEFINE_TAG(CPPTests_Menu, TEXT("Menu"), TEXT("CPPTests"), GET_STATFNAME(STAT_CPPTestsLLM_Menu), GET_STATFNAME(STAT_CPPTestsSummaryLLM));
+LLM_DEFINE_TAG(CPPTests_Merchant, TEXT("Merchant"), TEXT("CPPTests"), GET_STATFNAME(STAT_CPPTestsLLM_Merchant), GET_STATFNAME(STAT_CPPTestsSummaryLLM));
+LLM_DEFINE_TAG(CPPTests_StatusEffects, TEXT("Status Effects"), TEXT("CPPTests"), GET_STATFNAME(STAT_CPPTestsLLM_StatusEffects), GET_STATFNAME(STAT_CPPTestsSummaryLLM));
+LLM_DEFINE_TAG(CPPTests_Pickups, TEXT("Pickups"), TEXT("CPPTests"), GET_STATFNAME(STAT_CPPTestsLLM_Pickups), GET_STATFNAME(STAT_CPPTestsSummaryLLM));
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+
+// Also listed under [MemReportCommands] in DefaultEngine.ini, so it lands in every memreport
+static FAutoConsoleCommandWithOutputDevice GCPPTestsLLMCmd(
+	TEXT("CPPTests.LLM"),
+	TEXT("Dumps current LLM totals for each CPP_Tests feature tag (needs -llm)."),
+	FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice& Ar)
+	{
+		FLowLevelMemTracker& LLM = FLowLevelMemTracker::Get();
+		if (!LLM.IsEnabled())
+		{
+			Ar.Logf(TEXT("CPPTests.LLM: LLM is off, run with -llm"));
+			return;
+		}
+
+		const FName Tags[] =
+		{
+			LLM_TAG_NAME(CPPTests),
+			LLM_TAG_NAME(CPPTests_Forest),
+			LLM_TAG_NAME(CPPTests_NPCs),
+			LLM_TAG_NAME(CPPTests_NPCNav),
+			LLM_TAG_NAME(CPPTests_NPCWidgets),
+			LLM_TAG_NAME(CPPTests_Menu),
+			LLM_TAG_NAME(CPPTests_Merchant),
+			LLM_TAG_NAME(CPPTests_StatusEffects),
+			LLM_TAG_NAME(CPPTests_Pickups)
+		};
+
+		Ar.Logf(TEXT("CPP_Tests LLM totals:"));
+
+		int64 TotalBytes = 0;
+		for (const FName Tag : Tags)
+		{
+			const int64 Bytes = LLM.GetTagAmountForTracker(ELLMTracker::Default, Tag, ELLMTagSet::None);
+			TotalBytes += Bytes;
+			Ar.Logf(TEXT("  %-24s %10.2f MB"), *Tag.ToString(), Bytes / (1024.0 * 1024.0));
+		}
+
+		Ar.Logf(TEXT("  %-24s %10.2f MB"), TEXT("Total"), TotalBytes / (1024.0 * 1024.0));
+	})
+);
+
+#endif
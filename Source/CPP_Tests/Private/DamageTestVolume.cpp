@@ -1,26 +1,29 @@
 #include "DamageTestVolume.h"
 
 #include "Components/BoxComponent.h"
+#include "Engine/CollisionProfile.h"
 #include "CPP_TestsCharacter.h"
+#include "HazardSubsystem.h"
 #include "NPCCharacter.h"
 
 #include "PlayerStatsComponent.h"
 #include "StatusEffectComponent.h"
+#include "StatusEffectSubsystem.h"
 
 #include "Kismet/GameplayStatics.h"
 #include "Engine/Engine.h"
-#include "TimerManager.h"
 
 ADamageTestVolume::ADamageTestVolume()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	// Effects are applied by UHazardSubsystem
+	PrimaryActorTick.bCanEverTick = false;
 
 	Box = CreateDefaultSubobject<UBoxComponent>(TEXT("Box"));
 	SetRootComponent(Box);
 
-	// Trigger is the simplest, most reliable overlap setup for Pawns
-	Box->SetCollisionProfileName(TEXT("Trigger"));
-	Box->SetGenerateOverlapEvents(true);
+	// The box is only a shape for UHazardSubsystem's grid; no physics overlaps needed
+	Box->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+	Box->SetGenerateOverlapEvents(false);
 
 	Box->InitBoxExtent(FVector(100.f, 100.f, 100.f));
 }
@@ -31,244 +34,117 @@ void ADamageTestVolume::BeginPlay()
 
 	if (!Box) return;
 
-	Box->OnComponentBeginOverlap.AddDynamic(this, &ADamageTestVolume::OnBoxBegin);
-	Box->OnComponentEndOverlap.AddDynamic(this, &ADamageTestVolume::OnBoxEnd);
+	UHazardSubsystem* Hazards = GetWorld() ? GetWorld()->GetSubsystem<UHazardSubsystem>() : nullptr;
+	if (!Hazards) return;
 
-	// Helps, but not always enough by itself; tick-reconcile below is the real fix
-	Box->UpdateOverlaps();
+	Hazards->AddHazard(this);
 
-	// Seed once on next tick (after engine resolves initial overlaps)
-	if (UWorld* World = GetWorld())
+	if (Box->Mobility == EComponentMobility::Movable)
 	{
-		World->GetTimerManager().SetTimerForNextTick(
-			FTimerDelegate::CreateWeakLambda(this, [this]()
-			{
-				if (!Box) return;
-
-				Box->UpdateOverlaps();
-
-				TArray<AActor*> InitialOverlaps;
-				Box->GetOverlappingActors(InitialOverlaps);
-
-				const FHitResult DummyHit;
-				for (AActor* A : InitialOverlaps)
-				{
-					OnBoxBegin(Box, A, nullptr, 0, false, DummyHit);
-				}
-
-				if (bPrintDebug && GEngine)
-				{
-					const FString Msg = FString::Printf(TEXT("Seeded initial overlaps: %d"), InitialOverlaps.Num());
-					GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Cyan, Msg);
-				}
-			})
-		);
+		Box->TransformUpdated.AddUObject(this, &ADamageTestVolume::OnBoxTransformUpdated);
 	}
 }
 
-void ADamageTestVolume::Tick(float DeltaSeconds)
+void ADamageTestVolume::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaSeconds);
-
-	if (!Box || DeltaSeconds <= 0.f)
+	if (Box)
 	{
-		return;
+		Box->TransformUpdated.RemoveAll(this);
 	}
 
-	// --- Reconcile overlaps every tick (fixes start-overlap edge cases) ---
-	TArray<AActor*> CurrentOverlaps;
-	Box->GetOverlappingActors(CurrentOverlaps);
-
-	TSet<TWeakObjectPtr<ACPP_TestsCharacter>> CurrentPlayers;
-	TSet<TWeakObjectPtr<ANPCCharacter>> CurrentNPCs;
-
-	// Build current sets and fire "enter" if needed
+	if (UWorld* World = GetWorld())
 	{
-		const FHitResult DummyHit;
-
-		for (AActor* A : CurrentOverlaps)
+		if (UHazardSubsystem* Hazards = World->GetSubsystem<UHazardSubsystem>())
 		{
-			if (!IsValid(A)) continue;
-
-			if (ACPP_TestsCharacter* P = Cast<ACPP_TestsCharacter>(A))
-			{
-				CurrentPlayers.Add(P);
-
-				if (!OverlappingPlayers.Contains(P))
-				{
-					OnBoxBegin(Box, P, nullptr, 0, false, DummyHit);
-				}
-				continue;
-			}
-
-			if (ANPCCharacter* N = Cast<ANPCCharacter>(A))
-			{
-				CurrentNPCs.Add(N);
-
-				if (!OverlappingNPCs.Contains(N))
-				{
-					OnBoxBegin(Box, N, nullptr, 0, false, DummyHit);
-				}
-				continue;
-			}
+			Hazards->RemoveHazard(this);
 		}
 	}
 
-	// Fire "exit" for anything that used to be inside but isn't anymore.
-	// Important: collect first, then call OnBoxEnd, so we don't mutate sets while iterating.
-	TArray<ACPP_TestsCharacter*> PlayersToEnd;
-	TArray<ANPCCharacter*> NPCsToEnd;
-	{
-		for (const TWeakObjectPtr<ACPP_TestsCharacter>& WeakPlayer : OverlappingPlayers)
-		{
-			ACPP_TestsCharacter* P = WeakPlayer.Get();
-			if (IsValid(P) && !CurrentPlayers.Contains(P))
-			{
-				PlayersToEnd.Add(P);
-			}
-		}
-
-		for (const TWeakObjectPtr<ANPCCharacter>& WeakNPC : OverlappingNPCs)
-		{
-			ANPCCharacter* N = WeakNPC.Get();
-			if (IsValid(N) && !CurrentNPCs.Contains(N))
-			{
-				NPCsToEnd.Add(N);
-			}
-		}
-	}
-
-	for (ACPP_TestsCharacter* P : PlayersToEnd)
-	{
-		OnBoxEnd(Box, P, nullptr, 0);
-	}
+	Super::EndPlay(EndPlayReason);
+}
 
-	for (ANPCCharacter* N : NPCsToEnd)
+void ADamageTestVolume::OnBoxTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	if (UHazardSubsystem* Hazards = GetWorld() ? GetWorld()->GetSubsystem<UHazardSubsystem>() : nullptr)
 	{
-		OnBoxEnd(Box, N, nullptr, 0);
+		Hazards->AddHazard(this);
 	}
+}
 
-	// Replace sets with current (authoritative)
-	OverlappingPlayers = MoveTemp(CurrentPlayers);
-	OverlappingNPCs = MoveTemp(CurrentNPCs);
+void ADamageTestVolume::HandleSubjectEnter(const FHazardSubject& Subject)
+{
+	const bool bIsPlayer = Subject.Player.IsValid();
 
-	// --- Apply effect each tick ---
-	for (auto It = OverlappingPlayers.CreateIterator(); It; ++It)
+	// Burn is “sticky”: apply once on entry (optional). Players only: the built-in burn never decays and NPCs have nothing to cure it.
+	if (bIsPlayer && !CustomEffect && EffectType == EStatusEffectType::Burn && bApplyBurnOnEnter)
 	{
-		ACPP_TestsCharacter* P = It->Get();
-		if (!IsValid(P))
+		if (UStatusEffectSubsystem* Effects = GetWorld() ? GetWorld()->GetSubsystem<UStatusEffectSubsystem>() : nullptr)
 		{
-			It.RemoveCurrent();
-			continue;
+			Effects->ApplyEffect(Subject.Actor.Get(), EStatusEffectType::Burn, 1.f);
 		}
-		ApplyToPlayer(P, DeltaSeconds);
 	}
 
-	for (auto It = OverlappingNPCs.CreateIterator(); It; ++It)
+	if (bPrintDebug && GEngine)
 	{
-		ANPCCharacter* N = It->Get();
-		if (!IsValid(N))
-		{
-			It.RemoveCurrent();
-			continue;
-		}
-		ApplyToNPC(N, DeltaSeconds);
+		GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Yellow,
+			bIsPlayer ? TEXT("Entered Hazard Volume (Player)") : TEXT("Entered Hazard Volume (NPC)"));
 	}
 }
 
-void ADamageTestVolume::OnBoxBegin(UPrimitiveComponent* OverlappedComp, AActor* OtherActor,
-	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& Sweep)
+void ADamageTestVolume::HandleSubjectExit(const FHazardSubject& Subject)
 {
-	if (!IsValid(OtherActor)) return;
-
-	// Player
-	if (ACPP_TestsCharacter* Player = Cast<ACPP_TestsCharacter>(OtherActor))
+	if (bPrintDebug && GEngine)
 	{
-		const bool bWasAlreadyInside = OverlappingPlayers.Contains(Player);
-		OverlappingPlayers.Add(Player);
-
-		// Burn is “sticky”: apply once on entry (optional)
-		if (!bWasAlreadyInside && EffectType == EStatusEffectType::Burn && bApplyBurnOnEnter)
-		{
-			if (UStatusEffectComponent* Effects = Player->FindComponentByClass<UStatusEffectComponent>())
-			{
-				Effects->ApplyBurn(true);
-			}
-		}
-
-		if (bPrintDebug && GEngine && !bWasAlreadyInside)
-		{
-			GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Yellow, TEXT("Entered Hazard Volume (Player)"));
-		}
-		return;
+		GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Yellow,
+			Subject.Player.IsValid() ? TEXT("Exited Hazard Volume (Player)") : TEXT("Exited Hazard Volume (NPC)"));
 	}
+}
 
-	// NPC
-	if (ANPCCharacter* NPC = Cast<ANPCCharacter>(OtherActor))
+void ADamageTestVolume::ApplyToSubject(const FHazardSubject& Subject, float DeltaSeconds)
+{
+	if (Subject.Player.IsValid())
 	{
-		const bool bWasAlreadyInside = OverlappingNPCs.Contains(NPC);
-		OverlappingNPCs.Add(NPC);
-
-		if (bPrintDebug && GEngine && !bWasAlreadyInside)
-		{
-			GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Yellow, TEXT("Entered Hazard Volume (NPC)"));
-		}
-		return;
+		ApplyToPlayer(Subject, DeltaSeconds);
+	}
+	else if (ANPCCharacter* NPC = Subject.NPC.Get())
+	{
+		ApplyToNPC(NPC, DeltaSeconds);
 	}
 }
 
-void ADamageTestVolume::OnBoxEnd(UPrimitiveComponent* OverlappedComp, AActor* OtherActor,
-	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+void ADamageTestVolume::ApplyToPlayer(const FHazardSubject& Subject, float DeltaSeconds)
 {
-	if (!IsValid(OtherActor)) return;
+	if (DeltaSeconds <= 0.f) return;
 
-	if (ACPP_TestsCharacter* Player = Cast<ACPP_TestsCharacter>(OtherActor))
-	{
-		const bool bWasInside = OverlappingPlayers.Contains(Player);
-		OverlappingPlayers.Remove(Player);
+	UPlayerStatsComponent* Stats = Subject.Stats.Get();
+	if (!Stats) return;
 
-		if (bPrintDebug && GEngine && bWasInside)
-		{
-			GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Yellow, TEXT("Exited Hazard Volume (Player)"));
-		}
-		return;
-	}
+	ApplyEffectTo(Subject.Actor.Get(), DeltaSeconds);
 
-	if (ANPCCharacter* NPC = Cast<ANPCCharacter>(OtherActor))
+	if (EffectType == EStatusEffectType::None && !CustomEffect && DamagePerSecond > 0.f)
 	{
-		const bool bWasInside = OverlappingNPCs.Contains(NPC);
-		OverlappingNPCs.Remove(NPC);
-
-		if (bPrintDebug && GEngine && bWasInside)
-		{
-			GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Yellow, TEXT("Exited Hazard Volume (NPC)"));
-		}
-		return;
+		Stats->ModifyHealth(-DamagePerSecond * DeltaSeconds);
 	}
 }
 
-void ADamageTestVolume::ApplyToPlayer(ACPP_TestsCharacter* Player, float DeltaSeconds)
+void ADamageTestVolume::ApplyEffectTo(AActor* Target, float DeltaSeconds)
 {
-	if (!IsValid(Player) || DeltaSeconds <= 0.f) return;
+	UWorld* World = GetWorld();
+	UStatusEffectSubsystem* Effects = World ? World->GetSubsystem<UStatusEffectSubsystem>() : nullptr;
+	if (!Effects || !Target) return;
 
-	UPlayerStatsComponent* Stats = Player->FindComponentByClass<UPlayerStatsComponent>();
-	UStatusEffectComponent* Effects = Player->FindComponentByClass<UStatusEffectComponent>();
-	if (!Stats || !Effects) return;
+	const UStatusEffectDataAsset* Effect = CustomEffect ? CustomEffect.Get() : Effects->GetDefinitionFor(Target, EffectType);
+	if (!Effect) return;
 
-	switch (EffectType)
-	{
-	case EStatusEffectType::None:   break;
-	case EStatusEffectType::Poison: Effects->ApplyPoisonExposure(); break;
-	case EStatusEffectType::Fear:   Effects->AddFearPoints(PointsPerSecond * DeltaSeconds); break;
-	case EStatusEffectType::Burn:   break; // applied on enter
-	case EStatusEffectType::Frost:  Effects->AddFrostPoints(PointsPerSecond * DeltaSeconds); break;
-	case EStatusEffectType::Bleed:  Effects->AddBleedPoints(PointsPerSecond * DeltaSeconds); break;
-	default: break;
-	}
+	// Built-in burn is applied on enter
+	if (!CustomEffect && EffectType == EStatusEffectType::Burn) return;
 
-	if (EffectType == EStatusEffectType::None && DamagePerSecond > 0.f)
+	Effects->ApplyEffect(Target, Effect, PointsPerSecond * DeltaSeconds);
+
+	// Points only land every hazard step, so keep decay paused until the next one
+	if (const UHazardSubsystem* Hazards = World->GetSubsystem<UHazardSubsystem>())
 	{
-		Stats->ModifyHealth(-DamagePerSecond * DeltaSeconds);
+		Effects->HoldExposure(Target, Effect, Hazards->GetApplyInterval() * 1.5f);
 	}
 }
 
@@ -276,6 +152,8 @@ void ADamageTestVolume::ApplyToNPC(ANPCCharacter* NPC, float DeltaSeconds)
 {
 	if (!IsValid(NPC) || DeltaSeconds <= 0.f) return;
 
+	ApplyEffectTo(NPC, DeltaSeconds);
+
 	if (DamagePerSecond > 0.f)
 	{
 		const float DamageThisTick = DamagePerSecond * DeltaSeconds;
@@ -2,6 +2,7 @@
 
 #include "Components/HierarchicalInstancedStaticMeshComponent.h"
 #include "Components/StaticMeshComponent.h"
+#include "CPP_TestsStats.h"
 #include "DrawDebugHelpers.h"
 #include "Engine/StaticMesh.h"
 
@@ -425,6 +426,9 @@ FForestInstanceSphere AForestChunkModularTrees::MakeBranchSphere(const FTransfor
 
 void AForestChunkModularTrees::RebuildForest()
 {
+	CPPTESTS_SCOPE(STAT_CPPTests_RebuildForest, Forest_RebuildForest);
+	LLM_SCOPE_BYTAG(CPPTests_Forest);
+
 	ClearForest();
 
 	if (!TrunkMesh || !BranchMesh)
@@ -594,6 +598,8 @@ void AForestChunkModularTrees::RebuildForest()
 		}
 	}
 
+	CPPTESTS_COUNT(STAT_CPPTests_InstancesGenerated, InstancesGenerated, SpawnedTrunks + SpawnedBranches);
+
 	UE_LOG(LogTemp, Log, TEXT("ForestChunk: Rebuild complete. Trunks=%d, Branches=%d, Grid=%dx%d"),
 		SpawnedTrunks, SpawnedBranches, CountX, CountY);
 
@@ -0,0 +1,341 @@
+#include "HazardSubsystem.h"
+
+#include "Components/BoxComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "CPP_TestsStats.h"
+#include "CPP_TestsCharacter.h"
+#include "DamageTestVolume.h"
+#include "Engine/World.h"
+#include "NPCCharacter.h"
+#include "PlayerStatsComponent.h"
+#include "StatusEffectComponent.h"
+
+bool FHazardShape::Contains(const FVector& Location, const FVector& Padding) const
+{
+	const FVector Local = BoxTransform.InverseTransformPosition(Location);
+	const FVector Reach = Extent + Padding;
+	return FMath::Abs(Local.X) <= Reach.X && FMath::Abs(Local.Y) <= Reach.Y && FMath::Abs(Local.Z) <= Reach.Z;
+}
+
+void UHazardSubsystem::Deinitialize()
+{
+	Hazards.Reset();
+	VolumeToId.Reset();
+	Cells.Reset();
+	Subjects.Reset();
+	PendingSubjects.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UHazardSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UHazardSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UHazardSubsystem, STATGROUP_Tickables);
+}
+
+FIntPoint UHazardSubsystem::ToCell(const FVector& Location) const
+{
+	return FIntPoint(
+		FMath::FloorToInt(Location.X / CellSize),
+		FMath::FloorToInt(Location.Y / CellSize)
+	);
+}
+
+// -------------------------
+// Grid
+// -------------------------
+void UHazardSubsystem::AddHazard(ADamageTestVolume* Volume)
+{
+	UBoxComponent* Box = IsValid(Volume) ? Volume->Box : nullptr;
+	if (!Box)
+	{
+		return;
+	}
+
+	int32 Id = 0;
+	if (const int32* Existing = VolumeToId.Find(Volume))
+	{
+		Id = *Existing;
+		UnbinShape(Id, Hazards.FindChecked(Id));
+	}
+	else
+	{
+		Id = NextId++;
+		VolumeToId.Add(Volume, Id);
+	}
+
+	FHazardShape& Shape = Hazards.FindOrAdd(Id);
+	Shape.Volume = Volume;
+	Shape.BoxTransform = Box->GetComponentTransform();
+	Shape.Extent = Box->GetUnscaledBoxExtent();
+
+	const FBox WorldBounds = Box->CalcBounds(Shape.BoxTransform).GetBox();
+	Shape.MinCell = ToCell(WorldBounds.Min);
+	Shape.MaxCell = ToCell(WorldBounds.Max);
+
+	for (int32 Y = Shape.MinCell.Y; Y <= Shape.MaxCell.Y; ++Y)
+	{
+		for (int32 X = Shape.MinCell.X; X <= Shape.MaxCell.X; ++X)
+		{
+			Cells.FindOrAdd(FIntPoint(X, Y)).Add(Id);
+		}
+	}
+}
+
+void UHazardSubsystem::RemoveHazard(ADamageTestVolume* Volume)
+{
+	int32 Id = 0;
+	if (!VolumeToId.RemoveAndCopyValue(Volume, Id))
+	{
+		return;
+	}
+
+	FHazardShape Shape;
+	if (Hazards.RemoveAndCopyValue(Id, Shape))
+	{
+		UnbinShape(Id, Shape);
+	}
+}
+
+void UHazardSubsystem::UnbinShape(int32 Id, const FHazardShape& Shape)
+{
+	for (int32 Y = Shape.MinCell.Y; Y <= Shape.MaxCell.Y; ++Y)
+	{
+		for (int32 X = Shape.MinCell.X; X <= Shape.MaxCell.X; ++X)
+		{
+			const FIntPoint Cell(X, Y);
+			if (TArray<int32>* CellIds = Cells.Find(Cell))
+			{
+				CellIds->RemoveSingleSwap(Id, EAllowShrinking::No);
+				if (CellIds->Num() == 0)
+				{
+					Cells.Remove(Cell);
+				}
+			}
+		}
+	}
+}
+
+void UHazardSubsystem::FindHazardIds(const FVector& Location, TArray<int32, TInlineAllocator<2>>& OutIds, const FVector& Padding) const
+{
+	// A padded subject near a cell edge can reach into the neighbouring cells
+	const FIntPoint MinCell = ToCell(Location - Padding);
+	const FIntPoint MaxCell = ToCell(Location + Padding);
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			const TArray<int32>* CellIds = Cells.Find(FIntPoint(X, Y));
+			if (!CellIds)
+			{
+				continue;
+			}
+
+			for (const int32 Id : *CellIds)
+			{
+				const FHazardShape& Shape = Hazards.FindChecked(Id);
+				if (!OutIds.Contains(Id) && Shape.Volume.IsValid() && Shape.Contains(Location, Padding))
+				{
+					OutIds.Add(Id);
+				}
+			}
+		}
+	}
+}
+
+void UHazardSubsystem::GetHazardsAt(const FVector& Location, TArray<ADamageTestVolume*>& OutVolumes) const
+{
+	TArray<int32, TInlineAllocator<2>> Ids;
+	FindHazardIds(Location, Ids);
+
+	for (const int32 Id : Ids)
+	{
+		OutVolumes.Add(Hazards.FindChecked(Id).Volume.Get());
+	}
+}
+
+bool UHazardSubsystem::IsLocationHazardous(const FVector& Location) const
+{
+	TArray<int32, TInlineAllocator<2>> Ids;
+	FindHazardIds(Location, Ids);
+	return Ids.Num() > 0;
+}
+
+// -------------------------
+// Subjects
+// -------------------------
+void UHazardSubsystem::RegisterSubject(AActor* Actor)
+{
+	if (!IsValid(Actor))
+	{
+		return;
+	}
+
+	// Subjects can't grow mid-pass (effects hold references into it), so park new ones until the pass ends
+	if (bApplying)
+	{
+		PendingSubjects.AddUnique(Actor);
+		return;
+	}
+
+	AddSubjectNow(Actor);
+}
+
+void UHazardSubsystem::AddSubjectNow(AActor* Actor)
+{
+	if (!IsValid(Actor) || Subjects.ContainsByPredicate([Actor](const FHazardSubject& Subject) { return Subject.Actor.Get() == Actor; }))
+	{
+		return;
+	}
+
+	ACPP_TestsCharacter* Player = Cast<ACPP_TestsCharacter>(Actor);
+	ANPCCharacter* NPC = Player ? nullptr : Cast<ANPCCharacter>(Actor);
+	if (!Player && !NPC)
+	{
+		return;
+	}
+
+	FHazardSubject& Subject = Subjects.AddDefaulted_GetRef();
+	Subject.Actor = Actor;
+	Subject.Player = Player;
+	Subject.NPC = NPC;
+
+	if (Player)
+	{
+		Subject.Stats = Player->FindComponentByClass<UPlayerStatsComponent>();
+		Subject.Effects = Player->FindComponentByClass<UStatusEffectComponent>();
+	}
+
+	if (const UCapsuleComponent* Capsule = CastChecked<ACharacter>(Actor)->GetCapsuleComponent())
+	{
+		const float Radius = Capsule->GetScaledCapsuleRadius();
+		Subject.Padding = FVector(Radius, Radius, Capsule->GetScaledCapsuleHalfHeight());
+	}
+}
+
+void UHazardSubsystem::UnregisterSubject(AActor* Actor)
+{
+	PendingSubjects.Remove(Actor);
+
+	const int32 Index = Subjects.IndexOfByPredicate([Actor](const FHazardSubject& Subject) { return Subject.Actor.Get() == Actor; });
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (bApplying)
+	{
+		// Compacted at the start of the next pass
+		Subjects[Index].Actor.Reset();
+		return;
+	}
+
+	Subjects.RemoveAtSwap(Index, EAllowShrinking::No);
+}
+
+// -------------------------
+// Fixed-rate pass
+// -------------------------
+void UHazardSubsystem::Tick(float DeltaTime)
+{
+	if (Subjects.Num() == 0 || Hazards.Num() == 0)
+	{
+		return;
+	}
+
+	const float Interval = GetApplyInterval();
+	ApplyAccumulator = FMath::Min(ApplyAccumulator + DeltaTime, Interval * MaxCatchUpSteps);
+	if (ApplyAccumulator < Interval)
+	{
+		return;
+	}
+
+	// Every effect is linear in time, so the whole backlog goes out as one step
+	const int32 Steps = FMath::FloorToInt(ApplyAccumulator / Interval);
+	ApplyAccumulator -= Steps * Interval;
+	ApplyAll(Steps * Interval);
+}
+
+void UHazardSubsystem::ApplyAll(float StepSeconds)
+{
+	CPPTESTS_SCOPE(STAT_CPPTests_HazardApply, Hazard_ApplyAll);
+
+	Subjects.RemoveAllSwap([](const FHazardSubject& Subject) { return !Subject.Actor.IsValid(); }, EAllowShrinking::No);
+
+	bApplying = true;
+	for (int32 i = 0; i < Subjects.Num(); ++i)
+	{
+		StepSubject(i, StepSeconds);
+	}
+	bApplying = false;
+
+	for (const TWeakObjectPtr<AActor>& Pending : PendingSubjects)
+	{
+		AddSubjectNow(Pending.Get());
+	}
+	PendingSubjects.Reset();
+}
+
+void UHazardSubsystem::StepSubject(int32 SubjectIndex, float StepSeconds)
+{
+	FHazardSubject& Subject = Subjects[SubjectIndex];
+	AActor* Actor = Subject.Actor.Get();
+	if (!Actor)
+	{
+		return;
+	}
+
+	// Pooled or dead NPCs are treated as having left everything
+	const ANPCCharacter* NPC = Subject.NPC.Get();
+	const bool bAffectable = !NPC || (!NPC->IsInPool() && !NPC->IsDead());
+
+	TArray<int32, TInlineAllocator<2>> Previous = MoveTemp(Subject.Inside);
+	Subject.Inside.Reset();
+	if (bAffectable)
+	{
+		FindHazardIds(Actor->GetActorLocation(), Subject.Inside, Subject.Padding);
+	}
+
+	// Volumes are resolved up front; enter/apply can kill an NPC or move things around
+	TArray<ADamageTestVolume*, TInlineAllocator<2>> Current;
+	for (const int32 Id : Subject.Inside)
+	{
+		Current.Add(Hazards.FindChecked(Id).Volume.Get());
+	}
+
+	for (const int32 Id : Previous)
+	{
+		if (!Subject.Inside.Contains(Id))
+		{
+			if (const FHazardShape* Shape = Hazards.Find(Id))
+			{
+				if (ADamageTestVolume* Volume = Shape->Volume.Get())
+				{
+					Volume->HandleSubjectExit(Subject);
+				}
+			}
+		}
+	}
+
+	for (int32 i = 0; i < Current.Num(); ++i)
+	{
+		ADamageTestVolume* Volume = Current[i];
+		if (!IsValid(Volume) || !Subject.Actor.IsValid())
+		{
+			continue;
+		}
+
+		if (!Previous.Contains(Subject.Inside[i]))
+		{
+			Volume->HandleSubjectEnter(Subject);
+		}
+
+		Volume->ApplyToSubject(Subject, StepSeconds);
+	}
+}
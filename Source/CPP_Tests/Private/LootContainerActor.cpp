@@ -0,0 +1,15 @@
+#include "LootContainerActor.h"
+
+#include "Components/StaticMeshComponent.h"
+#include "UObject/ConstructorHelpers.h"
+
+ALootContainerActor::ALootContainerActor()
+{
+	// Placeholder crate until a Blueprint container is assigned on the archetype
+	static ConstructorHelpers::FObjectFinder<UStaticMesh> CubeMesh(TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (CubeMesh.Succeeded())
+	{
+		Mesh->SetStaticMesh(CubeMesh.Object);
+		Mesh->SetRelativeScale3D(FVector(0.3f));
+	}
+}
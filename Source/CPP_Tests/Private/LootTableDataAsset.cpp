@@ -0,0 +1,185 @@
+#include "LootTableDataAsset.h"
+
+#include "ItemDataAsset.h"
+
+void FLootAliasTable::Build(TConstArrayView<float> Weights)
+{
+	Prob.Reset();
+	Alias.Reset();
+
+	const int32 N = Weights.Num();
+	double Total = 0.0;
+	for (const float W : Weights)
+	{
+		Total += FMath::Max(0.0f, W);
+	}
+
+	if (N == 0 || Total <= 0.0)
+	{
+		return;
+	}
+
+	Prob.SetNumUninitialized(N);
+	Alias.SetNumUninitialized(N);
+
+	// Scale so the average bucket is exactly 1, then pair each short bucket with a tall one
+	TArray<double> Scaled;
+	Scaled.SetNumUninitialized(N);
+
+	TArray<int32> Small;
+	TArray<int32> Large;
+	Small.Reserve(N);
+	Large.Reserve(N);
+
+	for (int32 i = 0; i < N; ++i)
+	{
+		Scaled[i] = double(FMath::Max(0.0f, Weights[i])) * N / Total;
+		Alias[i] = i;
+		(Scaled[i] < 1.0 ? Small : Large).Add(i);
+	}
+
+	while (Small.Num() > 0 && Large.Num() > 0)
+	{
+		const int32 Less = Small.Pop(EAllowShrinking::No);
+		const int32 More = Large.Pop(EAllowShrinking::No);
+
+		Prob[Less] = float(Scaled[Less]);
+		Alias[Less] = More;
+
+		Scaled[More] = (Scaled[More] + Scaled[Less]) - 1.0;
+		(Scaled[More] < 1.0 ? Small : Large).Add(More);
+	}
+
+	// Leftovers are 1 up to float error
+	for (const int32 i : Large)
+	{
+		Prob[i] = 1.0f;
+	}
+	for (const int32 i : Small)
+	{
+		Prob[i] = 1.0f;
+	}
+}
+
+int32 FLootAliasTable::Sample(const FRandomStream& Rng) const
+{
+	if (Prob.Num() == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 Column = Rng.RandRange(0, Prob.Num() - 1);
+	return Rng.GetFraction() < Prob[Column] ? Column : Alias[Column];
+}
+
+void ULootTableDataAsset::PostLoad()
+{
+	Super::PostLoad();
+
+	bTablesBuilt = false;
+}
+
+#if WITH_EDITOR
+void ULootTableDataAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	bTablesBuilt = false;
+}
+#endif
+
+void ULootTableDataAsset::BuildTables() const
+{
+	TArray<float> Weights;
+	Weights.Reserve(Entries.Num() + 1);
+	for (const FLootTableEntry& Entry : Entries)
+	{
+		Weights.Add(Entry.Item ? Entry.Weight : 0.0f);
+	}
+	Weights.Add(NothingWeight);
+
+	EntryTable.Build(Weights);
+	RarityTable.Build(RarityWeights);
+	bTablesBuilt = true;
+}
+
+EItemRarity ULootTableDataAsset::RollRarity(const FRandomStream& Rng) const
+{
+	if (!bTablesBuilt)
+	{
+		BuildTables();
+	}
+
+	const int32 Index = RarityTable.Sample(Rng);
+	return Index == INDEX_NONE ? EItemRarity::Garbage : EItemRarity(FMath::Clamp(Index, 0, int32(EItemRarity::Perfect)));
+}
+
+void ULootTableDataAsset::MergeStack(TArray<FItemStack>& Stacks, UItemDataAsset* Item, int32 Quantity, EItemRarity Rarity)
+{
+	if (!Item || Quantity <= 0)
+	{
+		return;
+	}
+
+	for (FItemStack& Stack : Stacks)
+	{
+		if (Stack.Item == Item && Stack.Rarity == Rarity)
+		{
+			Stack.Quantity += Quantity;
+			return;
+		}
+	}
+
+	FItemStack& NewStack = Stacks.AddDefaulted_GetRef();
+	NewStack.Item = Item;
+	NewStack.Quantity = Quantity;
+	NewStack.Rarity = Rarity;
+}
+
+void ULootTableDataAsset::RollLootInto(int32 NumKills, const FRandomStream& Rng, TArray<FItemStack>& OutStacks) const
+{
+	if (!bTablesBuilt)
+	{
+		BuildTables();
+	}
+
+	if (EntryTable.IsEmpty() || NumKills <= 0)
+	{
+		return;
+	}
+
+	const int32 LowRolls = FMath::Max(0, MinRolls);
+	const int32 HighRolls = FMath::Max(LowRolls, MaxRolls);
+
+	for (int32 Kill = 0; Kill < NumKills; ++Kill)
+	{
+		const int32 Rolls = Rng.RandRange(LowRolls, HighRolls);
+		for (int32 Roll = 0; Roll < Rolls; ++Roll)
+		{
+			const int32 Index = EntryTable.Sample(Rng);
+			if (!Entries.IsValidIndex(Index))
+			{
+				continue; // "nothing"
+			}
+
+			const FLootTableEntry& Entry = Entries[Index];
+			const int32 Low = FMath::Max(1, Entry.MinQuantity);
+			const int32 Quantity = Rng.RandRange(Low, FMath::Max(Low, Entry.MaxQuantity));
+			const EItemRarity Rarity = Entry.bFixedRarity ? Entry.FixedRarity : RollRarity(Rng);
+
+			MergeStack(OutStacks, Entry.Item, Quantity, Rarity);
+		}
+	}
+}
+
+TArray<FItemStack> ULootTableDataAsset::RollLoot() const
+{
+	return RollLootBatch(1);
+}
+
+TArray<FItemStack> ULootTableDataAsset::RollLootBatch(int32 NumKills) const
+{
+	TArray<FItemStack> Stacks;
+	RollLootInto(NumKills, FRandomStream(FMath::Rand()), Stacks);
+	return Stacks;
+}
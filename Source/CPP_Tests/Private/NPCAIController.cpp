@@ -0,0 +1,44 @@
+#include "NPCAIController.h"
+
+#include "Components/StateTreeAIComponent.h"
+#include "StateTree.h"
+
+ANPCAIController::ANPCAIController()
+{
+	StateTreeComponent = CreateDefaultSubobject<UStateTreeAIComponent>(TEXT("StateTree"));
+
+	// Asset comes from the pawn at BeginPlay, nothing to start on our own
+	StateTreeComponent->SetStartLogicAutomatically(false);
+}
+
+void ANPCAIController::RunBehaviorStateTree(UStateTree* StateTree)
+{
+	if (!StateTreeComponent || !StateTree)
+	{
+		return;
+	}
+
+	StateTreeComponent->SetStateTree(StateTree);
+	StateTreeComponent->StartLogic();
+}
+
+void ANPCAIController::StopBehaviorStateTree()
+{
+	if (StateTreeComponent && StateTreeComponent->IsRunning())
+	{
+		StateTreeComponent->StopLogic(TEXT("NPC stopped"));
+	}
+}
+
+bool ANPCAIController::IsRunningBehaviorStateTree() const
+{
+	return StateTreeComponent && StateTreeComponent->IsRunning();
+}
+
+void ANPCAIController::SendBehaviorEvent(const FGameplayTag& Tag)
+{
+	if (IsRunningBehaviorStateTree())
+	{
+		StateTreeComponent->SendStateTreeEvent(Tag);
+	}
+}
@@ -0,0 +1,429 @@
+#include "NPCAmbientSubsystem.h"
+
+#include "Components/CapsuleComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "CPP_TestsStats.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "Kismet/GameplayStatics.h"
+#include "NavigationSystem.h"
+#include "NPCCharacter.h"
+#include "NPCPoolSubsystem.h"
+#include "NPCSafeZone.h"
+
+void UNPCAmbientSubsystem::Deinitialize()
+{
+	Batches.Reset();
+	Candidates.Reset();
+	ProxyMeshes.Reset();
+	ProxyHost = nullptr;
+
+	Super::Deinitialize();
+}
+
+bool UNPCAmbientSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UNPCAmbientSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNPCAmbientSubsystem, STATGROUP_Tickables);
+}
+
+int32 UNPCAmbientSubsystem::GetNumAmbientNPCs() const
+{
+	int32 Total = 0;
+	for (const FAmbientBatch& Batch : Batches)
+	{
+		Total += Batch.Num();
+	}
+	return Total;
+}
+
+void UNPCAmbientSubsystem::RegisterCandidate(ANPCCharacter* NPC)
+{
+	if (IsValid(NPC))
+	{
+		Candidates.AddUnique(NPC);
+	}
+}
+
+void UNPCAmbientSubsystem::UnregisterCandidate(ANPCCharacter* NPC)
+{
+	Candidates.RemoveSwap(NPC);
+}
+
+void UNPCAmbientSubsystem::AddAmbientNPC(TSubclassOf<ANPCCharacter> NPCClass, FVector Location, ANPCSafeZone* Zone)
+{
+	if (!NPCClass)
+	{
+		return;
+	}
+
+	const ANPCCharacter* CDO = NPCClass->GetDefaultObject<ANPCCharacter>();
+
+	FNPCAmbientState State = CDO->CaptureAmbientState();
+	State.Location = Location;
+	State.Yaw = FMath::FRandRange(0.0f, 360.0f);
+	State.HomeCenter = IsValid(Zone) ? Zone->GetActorLocation() : Location;
+	State.SafeZone = Zone;
+
+	if (FAmbientBatch* Batch = FindOrAddBatch(NPCClass, nullptr))
+	{
+		AddRecord(*Batch, State);
+	}
+}
+
+UNPCAmbientSubsystem::FAmbientBatch* UNPCAmbientSubsystem::FindOrAddBatch(TSubclassOf<ANPCCharacter> NPCClass, const ANPCCharacter* Source)
+{
+	UWorld* World = GetWorld();
+	if (!World || !NPCClass)
+	{
+		return nullptr;
+	}
+
+	// Mesh, offset and height come from the archetype / overrides, so NPCs of one class can still need separate batches
+	const ANPCCharacter* MeshSource = Source ? Source : NPCClass->GetDefaultObject<ANPCCharacter>();
+	UStaticMesh* ProxyMesh = MeshSource->GetAmbientProxyMesh();
+	if (!ProxyMesh)
+	{
+		return nullptr;
+	}
+
+	const FTransform MeshOffset = MeshSource->GetAmbientProxyMeshOffset();
+	const float HalfHeight = MeshSource->GetCapsuleComponent() ? MeshSource->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() : 0.0f;
+
+	for (FAmbientBatch& Batch : Batches)
+	{
+		if (Batch.NPCClass == NPCClass && Batch.ProxyMesh == ProxyMesh
+			&& Batch.MeshOffset.Equals(MeshOffset) && FMath::IsNearlyEqual(Batch.HalfHeight, HalfHeight))
+		{
+			return &Batch;
+		}
+	}
+
+	LLM_SCOPE_BYTAG(CPPTests_NPCs);
+
+	if (!ProxyHost)
+	{
+		FActorSpawnParameters Params;
+		Params.ObjectFlags |= RF_Transient;
+		ProxyHost = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, Params);
+
+		if (!ProxyHost)
+		{
+			return nullptr;
+		}
+
+		USceneComponent* Root = NewObject<USceneComponent>(ProxyHost, TEXT("Root"));
+		ProxyHost->SetRootComponent(Root);
+		Root->RegisterComponent();
+	}
+
+	UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(ProxyHost);
+	ISM->SetStaticMesh(ProxyMesh);
+	ISM->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	ISM->SetCanEverAffectNavigation(false);
+	ISM->SetupAttachment(ProxyHost->GetRootComponent());
+	ISM->RegisterComponent();
+	ProxyMeshes.Add(ISM);
+
+	FAmbientBatch& Batch = Batches.AddDefaulted_GetRef();
+	Batch.NPCClass = NPCClass;
+	Batch.ProxyMesh = ProxyMesh;
+	Batch.Mesh = ISM;
+	Batch.MeshOffset = MeshOffset;
+	Batch.HalfHeight = HalfHeight;
+	return &Batch;
+}
+
+void UNPCAmbientSubsystem::AddRecord(FAmbientBatch& Batch, const FNPCAmbientState& InState)
+{
+	const float Now = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
+
+	// Demoted actors can be mid-step or mid-fall and AddAmbientNPC gets whatever Z the caller had;
+	// put the record on the ground so the proxy doesn't float and the actor doesn't pop when it comes back
+	FNPCAmbientState State = InState;
+	SnapToGround(Batch, State.Location);
+
+	Batch.Locations.Add(State.Location);
+	Batch.Yaws.Add(State.Yaw);
+	Batch.Healths.Add(State.Health);
+	Batch.HomeCenters.Add(State.HomeCenter);
+	Batch.WanderRadii.Add(State.WanderRadius);
+	Batch.WanderSpeeds.Add(State.WanderSpeed);
+	Batch.SafeZones.Add(State.SafeZone);
+	Batch.Archetypes.Add(State.Archetype);
+	Batch.WanderTargets.Add(State.Location);
+	Batch.WaitUntil.Add(Now + FMath::FRandRange(WanderWaitMin, WanderWaitMax));
+
+	const FTransform Instance = Batch.MeshOffset * FTransform(FRotator(0.0f, State.Yaw, 0.0f), State.Location);
+	Batch.Mesh->AddInstance(Instance, /*bWorldSpace=*/true);
+	CPPTESTS_COUNT(STAT_CPPTests_InstancesGenerated, InstancesGenerated, 1);
+}
+
+bool UNPCAmbientSubsystem::SnapToGround(const FAmbientBatch& Batch, FVector& InOutLocation) const
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return false;
+	}
+
+	// Navmesh first: it's where the actor will walk once promoted
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World))
+	{
+		FNavLocation NavLoc;
+		const FVector Extent(50.0f, 50.0f, Batch.HalfHeight + GroundProbeDepth);
+		CPPTESTS_COUNT(STAT_CPPTests_NavQueries, NavQueries, 1);
+		if (NavSys->ProjectPointToNavigation(InOutLocation, NavLoc, Extent))
+		{
+			InOutLocation.Z = NavLoc.Location.Z + Batch.HalfHeight;
+			return true;
+		}
+	}
+
+	// Off the navmesh (or none built): plain ground trace
+	FHitResult Hit;
+	const FVector Start = InOutLocation + FVector(0.0f, 0.0f, GroundProbeDepth);
+	const FVector End = InOutLocation - FVector(0.0f, 0.0f, Batch.HalfHeight + GroundProbeDepth);
+	const FCollisionQueryParams Params(SCENE_QUERY_STAT(NPCAmbientGround), false);
+	if (World->LineTraceSingleByChannel(Hit, Start, End, ECC_WorldStatic, Params))
+	{
+		InOutLocation.Z = Hit.ImpactPoint.Z + Batch.HalfHeight;
+		return true;
+	}
+
+	return false;
+}
+
+void UNPCAmbientSubsystem::RemoveRecordAtSwap(FAmbientBatch& Batch, int32 Index)
+{
+	const int32 Last = Batch.Num() - 1;
+
+	// Mirror the swap on the ISM so record i keeps matching instance i
+	if (Index != Last)
+	{
+		FTransform LastTransform;
+		Batch.Mesh->GetInstanceTransform(Last, LastTransform, /*bWorldSpace=*/true);
+		Batch.Mesh->UpdateInstanceTransform(Index, LastTransform, /*bWorldSpace=*/true, /*bMarkRenderStateDirty=*/false, /*bTeleport=*/true);
+	}
+	Batch.Mesh->RemoveInstance(Last);
+
+	Batch.Locations.RemoveAtSwap(Index, EAllowShrinking::No);
+	Batch.Yaws.RemoveAtSwap(Index, EAllowShrinking::No);
+	Batch.Healths.RemoveAtSwap(Index, EAllowShrinking::No);
+	Batch.HomeCenters.RemoveAtSwap(Index, EAllowShrinking::No);
+	Batch.WanderRadii.RemoveAtSwap(Index, EAllowShrinking::No);
+	Batch.WanderSpeeds.RemoveAtSwap(Index, EAllowShrinking::No);
+	Batch.SafeZones.RemoveAtSwap(Index, EAllowShrinking::No);
+	Batch.Archetypes.RemoveAtSwap(Index, EAllowShrinking::No);
+	Batch.WanderTargets.RemoveAtSwap(Index, EAllowShrinking::No);
+	Batch.WaitUntil.RemoveAtSwap(Index, EAllowShrinking::No);
+}
+
+FNPCAmbientState UNPCAmbientSubsystem::GetRecordState(const FAmbientBatch& Batch, int32 Index) const
+{
+	FNPCAmbientState State;
+	State.Location = Batch.Locations[Index];
+	State.Yaw = Batch.Yaws[Index];
+	State.Health = Batch.Healths[Index];
+	State.HomeCenter = Batch.HomeCenters[Index];
+	State.WanderRadius = Batch.WanderRadii[Index];
+	State.WanderSpeed = Batch.WanderSpeeds[Index];
+	State.SafeZone = Batch.SafeZones[Index];
+	State.Archetype = Batch.Archetypes[Index];
+	return State;
+}
+
+void UNPCAmbientSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Candidates.Num() == 0 && Batches.Num() == 0)
+	{
+		return;
+	}
+
+	TimeUntilMovementUpdate -= DeltaTime;
+	if (TimeUntilMovementUpdate <= 0.0f)
+	{
+		UpdateProxyMovement(MovementUpdateInterval - TimeUntilMovementUpdate);
+		TimeUntilMovementUpdate = MovementUpdateInterval;
+	}
+
+	TimeUntilConversionCheck -= DeltaTime;
+	if (TimeUntilConversionCheck > 0.0f)
+	{
+		return;
+	}
+	TimeUntilConversionCheck = ConversionCheckInterval;
+
+	APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+	if (!PlayerPawn)
+	{
+		return;
+	}
+
+	const FVector PlayerLoc = PlayerPawn->GetActorLocation();
+	PromoteNearProxies(PlayerLoc);
+	DemoteFarActors(PlayerLoc);
+}
+
+void UNPCAmbientSubsystem::DemoteFarActors(const FVector& PlayerLoc)
+{
+	const float DemoteDistSq = FMath::Square(DemoteDistance);
+	int32 Budget = MaxConversionsPerCheck;
+
+	for (int32 i = Candidates.Num() - 1; i >= 0 && Budget > 0; --i)
+	{
+		ANPCCharacter* NPC = Candidates[i].Get();
+		if (!NPC)
+		{
+			Candidates.RemoveAtSwap(i);
+			continue;
+		}
+
+		if (FVector::DistSquared2D(NPC->GetActorLocation(), PlayerLoc) < DemoteDistSq || !NPC->CanBecomeAmbientProxy())
+		{
+			continue;
+		}
+
+		FAmbientBatch* Batch = FindOrAddBatch(NPC->GetClass(), NPC);
+		if (!Batch)
+		{
+			continue;
+		}
+
+		AddRecord(*Batch, NPC->CaptureAmbientState());
+
+		Candidates.RemoveAtSwap(i);
+
+		// Parked in the pool so promotion doesn't pay for a full spawn
+		if (UNPCPoolSubsystem* Pool = GetWorld()->GetSubsystem<UNPCPoolSubsystem>())
+		{
+			Pool->ReleaseNPC(NPC);
+		}
+		else
+		{
+			NPC->Destroy();
+		}
+		--Budget;
+	}
+}
+
+void UNPCAmbientSubsystem::PromoteNearProxies(const FVector& PlayerLoc)
+{
+	const float PromoteDistSq = FMath::Square(PromoteDistance);
+	int32 Budget = MaxConversionsPerCheck;
+
+	for (FAmbientBatch& Batch : Batches)
+	{
+		for (int32 i = Batch.Num() - 1; i >= 0 && Budget > 0; --i)
+		{
+			if (FVector::DistSquared2D(Batch.Locations[i], PlayerLoc) > PromoteDistSq)
+			{
+				continue;
+			}
+
+			// Spawn can fail if something is standing on the spot; try again next check
+			if (SpawnActorFromState(Batch.NPCClass, GetRecordState(Batch, i)))
+			{
+				RemoveRecordAtSwap(Batch, i);
+				--Budget;
+			}
+		}
+	}
+}
+
+bool UNPCAmbientSubsystem::SpawnActorFromState(TSubclassOf<ANPCCharacter> NPCClass, const FNPCAmbientState& State)
+{
+	UWorld* World = GetWorld();
+	if (!World || !NPCClass)
+	{
+		return false;
+	}
+
+	LLM_SCOPE_BYTAG(CPPTests_NPCs);
+
+	const FTransform SpawnTransform(FRotator(0.0f, State.Yaw, 0.0f), State.Location);
+
+	ANPCCharacter* NPC = nullptr;
+	if (UNPCPoolSubsystem* Pool = World->GetSubsystem<UNPCPoolSubsystem>())
+	{
+		NPC = Pool->AcquireNPC(NPCClass, SpawnTransform, State.SafeZone.Get(), State.Archetype.Get());
+	}
+	else
+	{
+		NPC = World->SpawnActorDeferred<ANPCCharacter>(NPCClass, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButDontSpawnIfColliding);
+		if (NPC)
+		{
+			NPC->SetArchetype(State.Archetype.Get());
+			NPC->FinishSpawning(SpawnTransform);
+		}
+	}
+
+	if (!NPC)
+	{
+		return false;
+	}
+
+	NPC->RestoreFromAmbientState(State);
+	return true;
+}
+
+void UNPCAmbientSubsystem::UpdateProxyMovement(float DeltaTime)
+{
+	const float Now = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
+
+	for (FAmbientBatch& Batch : Batches)
+	{
+		const int32 Count = Batch.Num();
+		if (Count == 0)
+		{
+			continue;
+		}
+
+		ScratchTransforms.SetNumUninitialized(Count, EAllowShrinking::No);
+
+		// Straight-line hops inside the home disc; no nav, no collision, nobody is close enough to tell
+		for (int32 i = 0; i < Count; ++i)
+		{
+			FVector& Loc = Batch.Locations[i];
+
+			if (Now >= Batch.WaitUntil[i])
+			{
+				const FVector2D ToTarget(Batch.WanderTargets[i] - Loc);
+				const float Dist = ToTarget.Size();
+				const float Step = Batch.WanderSpeeds[i] * DeltaTime;
+
+				if (Dist <= Step || Dist <= KINDA_SMALL_NUMBER)
+				{
+					Loc = Batch.WanderTargets[i];
+
+					// Targets are grounded when picked; one that can't be stays put until the next pick
+					const FVector2D Offset = FMath::RandPointInCircle(Batch.WanderRadii[i]);
+					FVector NewTarget(Batch.HomeCenters[i].X + Offset.X, Batch.HomeCenters[i].Y + Offset.Y, Loc.Z);
+					Batch.WanderTargets[i] = SnapToGround(Batch, NewTarget) ? NewTarget : Loc;
+					Batch.WaitUntil[i] = Now + FMath::FRandRange(WanderWaitMin, WanderWaitMax);
+				}
+				else
+				{
+					// Height follows the hop linearly, close enough for proxies nobody is near
+					const float Alpha = Step / Dist;
+					const FVector2D Dir = ToTarget / Dist;
+					Loc.X += Dir.X * Step;
+					Loc.Y += Dir.Y * Step;
+					Loc.Z += (Batch.WanderTargets[i].Z - Loc.Z) * Alpha;
+					Batch.Yaws[i] = FMath::RadiansToDegrees(FMath::Atan2(Dir.Y, Dir.X));
+				}
+			}
+
+			ScratchTransforms[i] = Batch.MeshOffset * FTransform(FRotator(0.0f, Batch.Yaws[i], 0.0f), Loc);
+		}
+
+		Batch.Mesh->BatchUpdateInstancesTransforms(0, ScratchTransforms, /*bWorldSpace=*/true, /*bMarkRenderStateDirty=*/true, /*bTeleport=*/true);
+	}
+}
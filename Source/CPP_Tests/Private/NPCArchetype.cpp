@@ -0,0 +1,94 @@
+#include "NPCArchetype.h"
+
+#include "PickupItemActor.h"
+#include "LootTableDataAsset.h"
+#include "NPCHealthBarWidget.h"
+#include "StateTree.h"
+#include "Engine/StaticMesh.h"
+#include "Animation/AnimMontage.h"
+
+void FNPCTuning::ClampToValidRanges()
+{
+	MaxHealth = FMath::Max(1.0f, MaxHealth);
+	LowHealthSpeedThreshold = FMath::Clamp(LowHealthSpeedThreshold, 0.0f, 1.0f);
+	LowHealthMoveSpeedMultiplier = FMath::Max(0.0f, LowHealthMoveSpeedMultiplier);
+	RestoreHealthDelaySeconds = FMath::Max(0.0f, RestoreHealthDelaySeconds);
+
+	InteractionFaceSeconds = FMath::Max(0.0f, InteractionFaceSeconds);
+	InteractionFaceInterpSpeed = FMath::Max(0.0f, InteractionFaceInterpSpeed);
+
+	DestroyDelaySeconds = FMath::Max(0.0f, DestroyDelaySeconds);
+	DropScatterRadius = FMath::Max(0.0f, DropScatterRadius);
+	DropSpawnZOffset = FMath::Clamp(DropSpawnZOffset, -200.0f, 200.0f);
+	RagdollImpulseStrength = FMath::Max(0.0f, RagdollImpulseStrength);
+
+	MaxCurrency = FMath::Max(0, MaxCurrency);
+	PreferredItemSellMultiplier = FMath::Max(1.0f, PreferredItemSellMultiplier);
+	SellMultiplier_Garbage = FMath::Max(0.0f, SellMultiplier_Garbage);
+	SellMultiplier_Acceptable = FMath::Max(0.0f, SellMultiplier_Acceptable);
+	SellMultiplier_Fair = FMath::Max(0.0f, SellMultiplier_Fair);
+	SellMultiplier_Perfect = FMath::Max(0.0f, SellMultiplier_Perfect);
+	ResaleBuyPriceMultiplier = FMath::Max(1.0f, ResaleBuyPriceMultiplier);
+	ResaleMinRelationshipLevel = FMath::Clamp(ResaleMinRelationshipLevel, 0, 5);
+
+	LockOnAimHeightRatio = FMath::Clamp(LockOnAimHeightRatio, 0.0f, 1.0f);
+
+	ReactionRange = FMath::Max(0.0f, ReactionRange);
+	NoticeFOVDegrees = FMath::Clamp(NoticeFOVDegrees, 1.0f, 180.0f);
+	LoseInterestSeconds = FMath::Max(0.0f, LoseInterestSeconds);
+	ReactionRepathInterval = FMath::Max(0.05f, ReactionRepathInterval);
+	SleepShellSlack = FMath::Max(0.0f, SleepShellSlack);
+
+	BrainTickSeconds = FMath::Max(0.05f, BrainTickSeconds);
+	ChaseAcceptanceRadius = FMath::Max(50.0f, ChaseAcceptanceRadius);
+	FleeDistance = FMath::Max(100.0f, FleeDistance);
+	ReturnHomeAcceptanceRadius = FMath::Max(50.0f, ReturnHomeAcceptanceRadius);
+	StuckAbortSeconds = FMath::Max(0.0f, StuckAbortSeconds);
+	FleeSampleTries = FMath::Max(1, FleeSampleTries);
+	FleeAngleJitterDegrees = FMath::Clamp(FleeAngleJitterDegrees, 0.0f, 180.0f);
+	FleeNavSearchRadius = FMath::Max(10.0f, FleeNavSearchRadius);
+
+	WanderRadius = FMath::Max(50.0f, WanderRadius);
+	WanderAcceptanceRadius = FMath::Max(10.0f, WanderAcceptanceRadius);
+	WanderWaitMin = FMath::Max(0.0f, WanderWaitMin);
+	WanderWaitMax = FMath::Max(0.0f, WanderWaitMax);
+
+	WanderSpeed = FMath::Max(0.0f, WanderSpeed);
+	MaxReactionSpeed = FMath::Max(0.0f, MaxReactionSpeed);
+	WanderRampSeconds = FMath::Max(0.05f, WanderRampSeconds);
+	RotationRateYaw = FMath::Max(0.0f, RotationRateYaw);
+
+	HealthBarHideDelaySeconds = FMath::Max(0.1f, HealthBarHideDelaySeconds);
+}
+
+const FNPCTuning& UNPCArchetype::GetDefaultTuning()
+{
+	static const FNPCTuning Defaults;
+	return Defaults;
+}
+
+void UNPCArchetype::ApplyOverrides(const FNPCTuning& Base, const TArray<FNPCTuningOverride>& Overrides, FNPCTuning& OutTuning, const UObject* LogContext)
+{
+	OutTuning = Base;
+
+	const UScriptStruct* Struct = FNPCTuning::StaticStruct();
+
+	for (const FNPCTuningOverride& Override : Overrides)
+	{
+		const FProperty* Prop = Struct->FindPropertyByName(Override.Property);
+		if (!Prop)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("NPC '%s': unknown tuning override '%s'"), *GetNameSafe(LogContext), *Override.Property.ToString());
+			continue;
+		}
+
+		void* ValuePtr = Prop->ContainerPtrToValuePtr<void>(&OutTuning);
+		if (!Prop->ImportText_Direct(*Override.Value, ValuePtr, nullptr, PPF_None))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("NPC '%s': couldn't parse '%s' for tuning override '%s'"),
+				*GetNameSafe(LogContext), *Override.Value, *Override.Property.ToString());
+		}
+	}
+
+	OutTuning.ClampToValidRanges();
+}
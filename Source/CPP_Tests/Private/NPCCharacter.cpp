@@ -1,12 +1,25 @@
 #include "NPCCharacter.h"
 
-#include "NPCHealthBarWidget.h"
+#include "NPCHealthBarSubsystem.h"
 #include "CPP_TestsPlayerController.h"
 #include "InventoryComponent.h"
 #include "PlayerStatsComponent.h"
 
 #include "AIController.h"
+#include "NPCAIController.h"
+#include "NPCGameplayTags.h"
 #include "NPCSafeZone.h"
+#include "NPCNavFieldSubsystem.h"
+#include "NPCPathCacheSubsystem.h"
+#include "NPCPerceptionSubsystem.h"
+#include "NPCAmbientSubsystem.h"
+#include "NPCPoolSubsystem.h"
+#include "NPCRagdollSubsystem.h"
+#include "NPCDamageFlushSubsystem.h"
+#include "NPCMovementSpeedSubsystem.h"
+#include "HazardSubsystem.h"
+#include "StatusEffectSubsystem.h"
+#include "CPP_TestsStats.h"
 #include "NavigationSystem.h"
 #include "Navigation/PathFollowingComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
@@ -15,7 +28,7 @@
 #include "Components/CapsuleComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/SkeletalMeshComponent.h"
-#include "Components/WidgetComponent.h"
+#include "Animation/AnimMontage.h"
 
 #include "Engine/Engine.h"
 #include "Engine/LocalPlayer.h"
@@ -25,32 +38,26 @@
 
 #include "ItemDataAsset.h"
 #include "PickupItemActor.h"
+#include "LootContainerActor.h"
+#include "LootTableDataAsset.h"
+#include "PickupSubsystem.h"
 
 ANPCCharacter::ANPCCharacter()
 {
-	PrimaryActorTick.bCanEverTick = true;
-	PrimaryActorTick.bStartWithTickEnabled = false;
+	// Speed ramps run in UNPCMovementSpeedSubsystem; nothing here needs actor Tick
+	PrimaryActorTick.bCanEverTick = false;
 
 	AutoPossessAI = EAutoPossessAI::PlacedInWorldOrSpawned;
-	AIControllerClass = AAIController::StaticClass();
+	AIControllerClass = ANPCAIController::StaticClass();
 
 	bUseControllerRotationYaw = false;
 
-	HealthBarComponent = CreateDefaultSubobject<UWidgetComponent>(TEXT("HealthBar"));
-	HealthBarComponent->SetupAttachment(GetCapsuleComponent());
-	HealthBarComponent->SetWidgetSpace(EWidgetSpace::Screen);
-	HealthBarComponent->SetDrawAtDesiredSize(true);
-	HealthBarComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-	HealthBarComponent->SetTwoSided(true);
-	HealthBarComponent->SetHiddenInGame(true);
-	HealthBarComponent->SetVisibility(false, true);
-
 	if (UCharacterMovementComponent* MoveComp = GetCharacterMovement())
 	{
 		MoveComp->bOrientRotationToMovement = true;
 		MoveComp->bUseControllerDesiredRotation = false;
-		MoveComp->RotationRate = FRotator(0.0f, RotationRateYaw, 0.0f);
-		MoveComp->MaxWalkSpeed = WanderSpeed;
+		MoveComp->RotationRate = FRotator(0.0f, GetTuning().RotationRateYaw, 0.0f);
+		MoveComp->MaxWalkSpeed = GetTuning().WanderSpeed;
 
 		MoveComp->bRequestedMoveUseAcceleration = true;
 
@@ -71,9 +78,6 @@ ANPCCharacter::ANPCCharacter()
 		VisualMesh->SetWorldScale3D(FVector(0.8f));
 	}
 
-	// Default relationship thresholds if user never sets them
-	RelationshipPointsToNextLevel = { 10, 15, 20, 25, 30 };
-
 	ApplyCollisionDefaults();
 	ApplyVisualDefaults();
 	ApplyAnimationDefaults();
@@ -114,9 +118,9 @@ int32 ANPCCharacter::GetPointsRequiredForNextLevel(int32 Level) const
 	if (Level < 0) Level = 0;
 	if (Level >= 5) return 0;
 
-	if (RelationshipPointsToNextLevel.Num() >= 5)
+	if (GetTuning().RelationshipPointsToNextLevel.Num() >= 5)
 	{
-		return FMath::Max(0, RelationshipPointsToNextLevel[Level]);
+		return FMath::Max(0, GetTuning().RelationshipPointsToNextLevel[Level]);
 	}
 
 	// fallback safety
@@ -128,10 +132,10 @@ float ANPCCharacter::GetRaritySellMultiplier(EItemRarity Rarity) const
 {
 	switch (Rarity)
 	{
-	case EItemRarity::Garbage:    return FMath::Max(0.f, SellMultiplier_Garbage);
-	case EItemRarity::Acceptable: return FMath::Max(0.f, SellMultiplier_Acceptable);
-	case EItemRarity::Fair:       return FMath::Max(0.f, SellMultiplier_Fair);
-	case EItemRarity::Perfect:    return FMath::Max(0.f, SellMultiplier_Perfect);
+	case EItemRarity::Garbage:    return FMath::Max(0.f, GetTuning().SellMultiplier_Garbage);
+	case EItemRarity::Acceptable: return FMath::Max(0.f, GetTuning().SellMultiplier_Acceptable);
+	case EItemRarity::Fair:       return FMath::Max(0.f, GetTuning().SellMultiplier_Fair);
+	case EItemRarity::Perfect:    return FMath::Max(0.f, GetTuning().SellMultiplier_Perfect);
 	default:                      return 1.f;
 	}
 }
@@ -178,7 +182,7 @@ float ANPCCharacter::GetPreferredSellMultiplier(const UItemDataAsset* Item) cons
 	}
 
 	// legacy fallback
-	return IsPreferredItem(Item) ? FMath::Max(0.f, PreferredItemSellMultiplier) : 1.f;
+	return IsPreferredItem(Item) ? FMath::Max(0.f, GetTuning().PreferredItemSellMultiplier) : 1.f;
 }
 
 int32 ANPCCharacter::GetPreferredRelationshipPointsPerUnit(const UItemDataAsset* Item) const
@@ -201,7 +205,7 @@ int32 ANPCCharacter::GetResaleBuyPricePerUnit(const UItemDataAsset* Item) const
 	const int32 Base = FMath::Max(0, Item->BaseSellValue);
 	if (Base <= 0) return 0;
 
-	const float Mult = FMath::Max(1.f, ResaleBuyPriceMultiplier);
+	const float Mult = FMath::Max(1.f, GetTuning().ResaleBuyPriceMultiplier);
 	return FMath::Max(1, FMath::RoundToInt((float)Base * Mult));
 }
 
@@ -210,7 +214,7 @@ void ANPCCharacter::ModifyMerchantCurrency(int32 Delta)
 	if (!bIsMerchant) return;
 
 	const int32 NewVal = CurrentCurrency + Delta;
-	CurrentCurrency = FMath::Clamp(NewVal, 0, MaxCurrency);
+	CurrentCurrency = FMath::Clamp(NewVal, 0, GetMaxCurrency());
 }
 
 void ANPCCharacter::AddResaleStock(UItemDataAsset* Item, int32 Quantity)
@@ -232,12 +236,14 @@ void ANPCCharacter::AddResaleStock(UItemDataAsset* Item, int32 Quantity)
 		return;
 	}
 
+	LLM_SCOPE_BYTAG(CPPTests_Merchant);
+
 	// Create a resale entry
 	FMerchantInventoryEntry NewEntry;
 	NewEntry.Item = Item;
 	NewEntry.bInfiniteStock = false;
 	NewEntry.Stock = Quantity;
-	NewEntry.MinRelationship = FMath::Clamp(ResaleMinRelationshipLevel, 0, 5);
+	NewEntry.MinRelationship = FMath::Clamp(GetTuning().ResaleMinRelationshipLevel, 0, 5);
 	NewEntry.BuyPrice = GetResaleBuyPricePerUnit(Item);
 
 	MerchantInventoryRuntime.Add(NewEntry);
@@ -345,8 +351,7 @@ void ANPCCharacter::ApplyAnimationDefaults()
 float ANPCCharacter::GetHealthPercent01() const
 {
 	if (!bHealthInitialized) return 1.0f;
-	if (MaxHealth <= 0.0f) return 1.0f;
-	return FMath::Clamp(CurrentHealth / MaxHealth, 0.0f, 1.0f);
+	return FMath::Clamp(CurrentHealth / GetMaxHealth(), 0.0f, 1.0f);
 }
 
 float ANPCCharacter::GetLowHealthMoveMultiplier() const
@@ -354,11 +359,11 @@ float ANPCCharacter::GetLowHealthMoveMultiplier() const
 	if (bIsDead) return 1.0f;
 
 	const float Pct = GetHealthPercent01();
-	const float Threshold = FMath::Clamp(LowHealthSpeedThreshold, 0.0f, 1.0f);
+	const float Threshold = FMath::Clamp(GetTuning().LowHealthSpeedThreshold, 0.0f, 1.0f);
 
 	if (Pct <= Threshold)
 	{
-		return FMath::Max(0.0f, LowHealthMoveSpeedMultiplier);
+		return FMath::Max(0.0f, GetTuning().LowHealthMoveSpeedMultiplier);
 	}
 
 	return 1.0f;
@@ -366,10 +371,12 @@ float ANPCCharacter::GetLowHealthMoveMultiplier() const
 
 void ANPCCharacter::CancelSpeedRamp()
 {
-	if (bSpeedRamping)
+	if (UWorld* World = GetWorld())
 	{
-		bSpeedRamping = false;
-		SetActorTickEnabled(false);
+		if (UNPCMovementSpeedSubsystem* SpeedSubsystem = World->GetSubsystem<UNPCMovementSpeedSubsystem>())
+		{
+			SpeedSubsystem->CancelRamp(this);
+		}
 	}
 }
 
@@ -382,7 +389,7 @@ void ANPCCharacter::ReapplyMoveSpeedFromLastRequest()
 	if (LastRequestedBaseSpeed <= 0.0f)
 	{
 		const bool bReactionMode = (CurrentMode == ENPCMode::Chase) || (CurrentMode == ENPCMode::Flee);
-		LastRequestedBaseSpeed = bReactionMode ? MaxReactionSpeed : WanderSpeed;
+		LastRequestedBaseSpeed = bReactionMode ? GetTuning().MaxReactionSpeed : GetTuning().WanderSpeed;
 	}
 
 	if (UCharacterMovementComponent* MoveComp = GetCharacterMovement())
@@ -400,26 +407,20 @@ void ANPCCharacter::InitializeRuntimeState()
 		bIsAggressive = false;
 	}
 
-	MaxHealth = FMath::Max(1.0f, MaxHealth);
+	const float MaxHP = GetMaxHealth();
 
 	if (CurrentHealth <= 0.0f)
 	{
-		CurrentHealth = MaxHealth;
+		CurrentHealth = MaxHP;
 	}
-	CurrentHealth = FMath::Clamp(CurrentHealth, 0.0f, MaxHealth);
+	CurrentHealth = FMath::Clamp(CurrentHealth, 0.0f, MaxHP);
 
 	bIsDead = (CurrentHealth <= 0.0f);
 
-	// Ensure relationship thresholds valid
-	if (RelationshipPointsToNextLevel.Num() < 5)
-	{
-		RelationshipPointsToNextLevel = { 10, 15, 20, 25, 30 };
-	}
-
 	if (bIsMerchant)
 	{
 		RelationshipLevel = FMath::Clamp(RelationshipLevel, 0, 5);
-		MaxCurrency = FMath::Max(0, MaxCurrency);
+		const int32 MaxCurrency = FMath::Max(0, GetTuning().MaxCurrency);
 
 		if (CurrentCurrency <= 0)
 		{
@@ -429,6 +430,7 @@ void ANPCCharacter::InitializeRuntimeState()
 
 		RelationshipPoints = FMath::Max(0, RelationshipPoints);
 
+		LLM_SCOPE_BYTAG(CPPTests_Merchant);
 		MerchantInventoryRuntime.Reset();
 		if (MerchantInventoryData)
 		{
@@ -446,58 +448,142 @@ void ANPCCharacter::InitializeRuntimeState()
 
 	if (LastRequestedBaseSpeed <= 0.0f)
 	{
-		LastRequestedBaseSpeed = WanderSpeed;
+		LastRequestedBaseSpeed = GetTuning().WanderSpeed;
 	}
 
 	ReapplyMoveSpeedFromLastRequest();
 }
 
-void ANPCCharacter::OnConstruction(const FTransform& Transform)
+void ANPCCharacter::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
 {
-	Super::OnConstruction(Transform);
+	Super::AddReferencedObjects(InThis, Collector);
 
-	if (UCharacterMovementComponent* MoveComp = GetCharacterMovement())
+	// Overridden copy isn't a UPROPERTY, so report its asset refs ourselves
+	ANPCCharacter* This = CastChecked<ANPCCharacter>(InThis);
+	if (This->OverriddenTuning)
 	{
-		MoveComp->RotationRate = FRotator(0.0f, RotationRateYaw, 0.0f);
-		MoveComp->bRequestedMoveUseAcceleration = true;
+		Collector.AddPropertyReferences(FNPCTuning::StaticStruct(), This->OverriddenTuning.Get(), This);
+	}
+}
 
-		if (FNavMovementProperties* NavProps = MoveComp->GetNavMovementProperties())
-		{
-			NavProps->bUseAccelerationForPaths = true;
-		}
+void ANPCCharacter::RebuildTuning()
+{
+	if (TuningOverrides.Num() == 0)
+	{
+		OverriddenTuning.Reset();
+		return;
+	}
+
+	if (!OverriddenTuning)
+	{
+		OverriddenTuning = MakeUnique<FNPCTuning>();
+	}
+
+	const FNPCTuning& Base = Archetype ? Archetype->Tuning : UNPCArchetype::GetDefaultTuning();
+	UNPCArchetype::ApplyOverrides(Base, TuningOverrides, *OverriddenTuning, this);
+}
+
+TArray<FName> ANPCCharacter::GetTuningOverrideOptions() const
+{
+	TArray<FName> Names;
+	for (TFieldIterator<FProperty> It(FNPCTuning::StaticStruct()); It; ++It)
+	{
+#if WITH_EDITORONLY_DATA
+		const FString& Category = It->GetMetaData(TEXT("Category"));
+		if (!bIsMerchant && Category.StartsWith(TEXT("Merchant"))) continue;
+		if (bIsStationary && (Category == TEXT("Wander") || Category == TEXT("Ambient"))) continue;
+#endif
+		Names.Add(It->GetFName());
 	}
+	return Names;
+}
+
+void ANPCCharacter::PostLoad()
+{
+	Super::PostLoad();
+
+#if WITH_EDITORONLY_DATA
+	MigrateDeprecatedTuning();
+#endif
+}
+
+#if WITH_EDITORONLY_DATA
+void ANPCCharacter::MigrateDeprecatedTuning()
+{
+	// The old properties kept their old defaults, so anything that differs from the native CDO was set on a BP or a placed NPC
+	const ANPCCharacter* NativeDefaults = GetDefault<ANPCCharacter>();
+	if (this == NativeDefaults) return;
 
-	if (HealthBarComponent)
+	bool bMigrated = false;
+	for (TFieldIterator<FProperty> It(FNPCTuning::StaticStruct()); It; ++It)
 	{
-		HealthBarComponent->SetRelativeLocation(HealthBarWorldOffset);
+		const FProperty* OldProp = StaticClass()->FindPropertyByName(FName(*(It->GetName() + TEXT("_DEPRECATED"))));
+		if (!OldProp || OldProp->Identical_InContainer(this, NativeDefaults)) continue;
 
-		if (HealthBarWidgetClass)
+		FString Value;
+		OldProp->ExportText_InContainer(0, Value, this, nullptr, this, PPF_None);
+
+		// Replace by name: placed NPCs inherit the entries their BP already migrated
+		const FName Name = It->GetFName();
+		FNPCTuningOverride* Entry = TuningOverrides.FindByPredicate([Name](const FNPCTuningOverride& O) { return O.Property == Name; });
+		if (!Entry)
 		{
-			HealthBarComponent->SetWidgetClass(HealthBarWidgetClass);
-			HealthBarComponent->InitWidget();
+			Entry = &TuningOverrides.AddDefaulted_GetRef();
+			Entry->Property = Name;
 		}
+		Entry->Value = Value;
 
-		HealthBarComponent->SetHiddenInGame(true);
-		HealthBarComponent->SetVisibility(false, true);
+		OldProp->CopyCompleteValue_InContainer(this, NativeDefaults);
+		bMigrated = true;
 	}
 
-	InitializeRuntimeState();
+	if (bMigrated)
+	{
+		UE_LOG(LogTemp, Log, TEXT("NPC '%s': moved old per-NPC tuning into TuningOverrides, resave to keep it"), *GetPathName());
+		RebuildTuning();
+	}
+}
+#endif
+
+void ANPCCharacter::PostInitializeComponents()
+{
+	// Placed NPCs loaded from a cooked level never run OnConstruction, so resolve tuning here too
+	RebuildTuning();
+
+	Super::PostInitializeComponents();
+}
+
+// Everything derived from the archetype + class config. Pooled NPCs that switch archetype rerun it too.
+void ANPCCharacter::ApplyArchetypeSetup()
+{
+	RebuildTuning();
+
+	if (UCharacterMovementComponent* MoveComp = GetCharacterMovement())
+	{
+		MoveComp->RotationRate = FRotator(0.0f, GetTuning().RotationRateYaw, 0.0f);
+		MoveComp->bRequestedMoveUseAcceleration = true;
+
+		if (FNavMovementProperties* NavProps = MoveComp->GetNavMovementProperties())
+		{
+			NavProps->bUseAccelerationForPaths = true;
+		}
+	}
 
 	ApplyCollisionDefaults();
 	ApplyVisualDefaults();
 	ApplyAnimationDefaults();
+}
 
-	if (LastRegisteredZone.IsValid() && LastRegisteredZone.Get() != SafeZone)
-	{
-		LastRegisteredZone->UnregisterNPC(this);
-		LastRegisteredZone = nullptr;
-	}
+void ANPCCharacter::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
 
-	if (IsValid(SafeZone))
-	{
-		SafeZone->RegisterNPC(this);
-		LastRegisteredZone = SafeZone;
-	}
+	ApplyArchetypeSetup();
+
+	InitializeRuntimeState();
+
+	// No-op when a batch spawner already recorded the zone
+	BindToSafeZone(SafeZone);
 }
 
 void ANPCCharacter::BeginPlay()
@@ -506,6 +592,7 @@ void ANPCCharacter::BeginPlay()
 
 	HomeLocation = GetActorLocation();
 	InitializeRuntimeState();
+	SetModeCounted(true);
 
 	if (UWorld* World = GetWorld())
 	{
@@ -516,29 +603,9 @@ void ANPCCharacter::BeginPlay()
 		LastDamageTimeSeconds = 0.0f;
 	}
 
-	if (HealthBarComponent)
-	{
-		if (APlayerController* PC = UGameplayStatics::GetPlayerController(this, 0))
-		{
-			if (ULocalPlayer* LP = PC->GetLocalPlayer())
-			{
-				HealthBarComponent->SetOwnerPlayer(LP);
-			}
-		}
-
-		if (HealthBarWidgetClass)
-		{
-			HealthBarComponent->SetWidgetClass(HealthBarWidgetClass);
-			HealthBarComponent->InitWidget();
-		}
-
-		HealthBarComponent->SetHiddenInGame(true);
-		HealthBarComponent->SetVisibility(false, true);
-	}
-
 	if (GetWorld())
 	{
-		NextWanderAllowedTime = GetWorld()->GetTimeSeconds() + FMath::FRandRange(WanderWaitMin, WanderWaitMax);
+		NextWanderAllowedTime = GetWorld()->GetTimeSeconds() + FMath::FRandRange(GetTuning().WanderWaitMin, GetTuning().WanderWaitMax);
 	}
 
 	if (UCharacterMovementComponent* MoveComp = GetCharacterMovement())
@@ -553,66 +620,89 @@ void ANPCCharacter::BeginPlay()
 
 	ApplyAnimationDefaults();
 
-	GetWorldTimerManager().SetTimer(
-		BrainTimerHandle,
-		this,
-		&ANPCCharacter::BrainTick,
-		BrainTickSeconds,
-		true
-	);
+	if (GetTuning().BehaviorStateTree)
+	{
+		if (ANPCAIController* NPCController = Cast<ANPCAIController>(GetController()))
+		{
+			NPCController->RunBehaviorStateTree(GetTuning().BehaviorStateTree);
+			bStateTreeDriven = NPCController->IsRunningBehaviorStateTree();
+		}
+	}
+
+	StartBrainTimer();
+
+	if (GetTuning().bAllowAmbientProxy)
+	{
+		if (UNPCAmbientSubsystem* Ambient = GetWorld()->GetSubsystem<UNPCAmbientSubsystem>())
+		{
+			Ambient->RegisterCandidate(this);
+		}
+	}
+
+	if (UHazardSubsystem* Hazards = GetWorld()->GetSubsystem<UHazardSubsystem>())
+	{
+		Hazards->RegisterSubject(this);
+	}
 }
 
-void ANPCCharacter::ShowHealthBarNow()
+void ANPCCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	if (!HealthBarComponent || bIsDead) return;
+	ExitBrainSleep();
+	SetModeCounted(false);
 
-	if (!HealthBarComponent->GetUserWidgetObject() && HealthBarWidgetClass)
+	if (UWorld* World = GetWorld())
 	{
-		HealthBarComponent->SetWidgetClass(HealthBarWidgetClass);
-		HealthBarComponent->InitWidget();
+		if (UNPCAmbientSubsystem* Ambient = World->GetSubsystem<UNPCAmbientSubsystem>())
+		{
+			Ambient->UnregisterCandidate(this);
+		}
+
+		if (UHazardSubsystem* Hazards = World->GetSubsystem<UHazardSubsystem>())
+		{
+			Hazards->UnregisterSubject(this);
+		}
 	}
 
-	UNPCHealthBarWidget* W = Cast<UNPCHealthBarWidget>(HealthBarComponent->GetUserWidgetObject());
-	if (!W) return;
+	if (LastRegisteredZone.IsValid())
+	{
+		LastRegisteredZone->UnregisterNPC(this);
+		LastRegisteredZone.Reset();
+	}
 
-	HealthBarComponent->SetHiddenInGame(false);
-	HealthBarComponent->SetVisibility(true, true);
+	Super::EndPlay(EndPlayReason);
+}
 
-	const float Pct = (MaxHealth > 0.f) ? (CurrentHealth / MaxHealth) : 0.f;
-	W->SetHealthPercent(Pct);
-	W->ShowInstant();
+void ANPCCharacter::ShowHealthBarNow()
+{
+	if (bIsDead || !GetWorld()) return;
 
-	GetWorldTimerManager().ClearTimer(HealthBarHideTimerHandle);
-	GetWorldTimerManager().SetTimer(
-		HealthBarHideTimerHandle,
-		this,
-		&ANPCCharacter::FadeHealthBar,
-		HealthBarHideDelaySeconds,
-		false
-	);
+	// Bar lives in the shared overlay; it handles the hide delay and fade
+	if (UNPCHealthBarSubsystem* Bars = GetWorld()->GetSubsystem<UNPCHealthBarSubsystem>())
+	{
+		Bars->ShowBar(this, CurrentHealth / GetMaxHealth());
+	}
 }
 
-void ANPCCharacter::FadeHealthBar()
+void ANPCCharacter::HideHealthBar()
 {
-	if (!HealthBarComponent || bIsDead) return;
-
-	if (UNPCHealthBarWidget* W = Cast<UNPCHealthBarWidget>(HealthBarComponent->GetUserWidgetObject()))
+	if (UNPCHealthBarSubsystem* Bars = GetWorld() ? GetWorld()->GetSubsystem<UNPCHealthBarSubsystem>() : nullptr)
 	{
-		W->PlayFadeOut();
+		Bars->HideBar(this);
 	}
 }
 
-void ANPCCharacter::EnterRagdoll(AActor* DamageCauser)
+bool ANPCCharacter::EnterRagdoll(AActor* DamageCauser)
 {
 	USkeletalMeshComponent* SkelMesh = GetMesh();
-	if (!SkelMesh) return;
+	if (!SkelMesh) return false;
 
 	if (!SkelMesh->GetPhysicsAsset())
 	{
 		UE_LOG(LogTemp, Warning, TEXT("NPC '%s' has no PhysicsAsset; ragdoll skipped."), *GetName());
-		return;
+		return false;
 	}
 
+	PreRagdollMeshProfile = SkelMesh->GetCollisionProfileName();
 	SkelMesh->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
 
 	SkelMesh->SetCollisionProfileName(TEXT("Ragdoll"));
@@ -623,36 +713,50 @@ void ANPCCharacter::EnterRagdoll(AActor* DamageCauser)
 	SkelMesh->WakeAllRigidBodies();
 	SkelMesh->bBlendPhysics = true;
 
-	if (RagdollImpulseStrength > 0.0f && IsValid(DamageCauser))
+	if (GetTuning().RagdollImpulseStrength > 0.0f && IsValid(DamageCauser))
 	{
 		const FVector Dir = (SkelMesh->GetComponentLocation() - DamageCauser->GetActorLocation()).GetSafeNormal();
-		SkelMesh->AddImpulse(Dir * RagdollImpulseStrength, NAME_None, true);
+		SkelMesh->AddImpulse(Dir * GetTuning().RagdollImpulseStrength, NAME_None, true);
 	}
+
+	return true;
 }
 
-void ANPCCharacter::Tick(float DeltaTime)
+void ANPCCharacter::FreezeRagdoll()
 {
-	Super::Tick(DeltaTime);
-
-	if (!bSpeedRamping || !GetWorld())
+	USkeletalMeshComponent* SkelMesh = GetMesh();
+	if (!SkelMesh || !SkelMesh->IsSimulatingPhysics())
 	{
 		return;
 	}
 
-	const float Now = GetWorld()->GetTimeSeconds();
-	const float Alpha = FMath::Clamp((Now - RampStartTime) / FMath::Max(RampDuration, KINDA_SMALL_NUMBER), 0.0f, 1.0f);
+	// Bodies stay where they landed but drop out of the solver; no mesh tick means the pose stops updating too
+	SkelMesh->PutAllRigidBodiesToSleep();
+	SkelMesh->SetEnableGravity(false);
+	SkelMesh->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	SkelMesh->SetComponentTickEnabled(false);
+}
 
-	const float NewSpeedActual = FMath::Lerp(RampStartSpeed, RampTargetSpeed, Alpha);
+void ANPCCharacter::AbandonRagdoll()
+{
+	ExitRagdoll();
 
-	if (UCharacterMovementComponent* MoveComp = GetCharacterMovement())
+	if (GetTuning().DeathMontage)
+	{
+		PlayCheapDeath();
+	}
+	else
 	{
-		MoveComp->MaxWalkSpeed = NewSpeedActual;
+		// Pool reactivation unhides it; otherwise the destroy / pool timer takes it away
+		SetActorHiddenInGame(true);
 	}
+}
 
-	if (Alpha >= 1.0f)
+void ANPCCharacter::PlayCheapDeath()
+{
+	if (UAnimMontage* Montage = GetTuning().DeathMontage)
 	{
-		bSpeedRamping = false;
-		SetActorTickEnabled(false);
+		PlayAnimMontage(Montage);
 	}
 }
 
@@ -664,7 +768,7 @@ void ANPCCharacter::BeginInteractionPause(AActor* Interactor)
 	}
 
 	InteractionFaceTarget = Interactor;
-	InteractionPauseUntilTime = GetWorld()->GetTimeSeconds() + FMath::Max(0.f, InteractionFaceSeconds);
+	InteractionPauseUntilTime = GetWorld()->GetTimeSeconds() + FMath::Max(0.f, GetTuning().InteractionFaceSeconds);
 
 	if (AAIController* AIC = Cast<AAIController>(GetController()))
 	{
@@ -704,7 +808,7 @@ void ANPCCharacter::UpdateFaceTarget(float DeltaSeconds)
 	}
 
 	const FRotator Desired(0.f, To.Rotation().Yaw, 0.f);
-	const FRotator NewRot = FMath::RInterpTo(GetActorRotation(), Desired, DeltaSeconds, FMath::Max(0.f, InteractionFaceInterpSpeed));
+	const FRotator NewRot = FMath::RInterpTo(GetActorRotation(), Desired, DeltaSeconds, FMath::Max(0.f, GetTuning().InteractionFaceInterpSpeed));
 	SetActorRotation(NewRot);
 }
 
@@ -721,6 +825,7 @@ void ANPCCharacter::Interact_Implementation(AActor* Interactor)
 		return;
 	}
 
+	WakeBrain();
 	BeginInteractionPause(Interactor);
 
 	if (bIsMerchant)
@@ -866,42 +971,89 @@ float ANPCCharacter::TakeDamage(float DamageAmount, FDamageEvent const& DamageEv
 		LastDamageTimeSeconds = World->GetTimeSeconds();
 	}
 
-	CurrentHealth = FMath::Clamp(CurrentHealth - Actual, 0.0f, MaxHealth);
-
-	ReapplyMoveSpeedFromLastRequest();
+	WakeBrain();
 
-	OnNPCDamaged.Broadcast(this, Actual, DamageCauser);
-	BP_OnDamaged(Actual, DamageCauser);
+	CurrentHealth = FMath::Clamp(CurrentHealth - Actual, 0.0f, GetMaxHealth());
 
-	ShowHealthBarNow();
+	// Health is live; everything that only reports it waits for the flush
+	PendingDamage += Actual;
+	PendingDamageCauser = DamageCauser;
 
-	if (bIsImmortal)
+	if (GetTuning().bIsImmortal)
 	{
 		if (CurrentHealth <= 0.0f)
 		{
 			CurrentHealth = 1.0f;
 		}
+	}
+	else if (CurrentHealth <= 0.0f)
+	{
+		// Death can't wait for the batch
+		FlushPendingDamage();
+		HandleDeath(DamageCauser);
 		return Actual;
 	}
 
-	if (CurrentHealth <= 0.0f && !bIsDead)
+	if (!bDamageFlushQueued)
 	{
-		HandleDeath(DamageCauser);
+		UNPCDamageFlushSubsystem* Flusher = GetWorld() ? GetWorld()->GetSubsystem<UNPCDamageFlushSubsystem>() : nullptr;
+		if (Flusher)
+		{
+			bDamageFlushQueued = true;
+			Flusher->QueueFlush(this);
+		}
+		else
+		{
+			FlushPendingDamage();
+		}
 	}
 
 	return Actual;
 }
 
+void ANPCCharacter::FlushPendingDamage()
+{
+	bDamageFlushQueued = false;
+
+	const float Amount = PendingDamage;
+	AActor* Causer = PendingDamageCauser.Get();
+
+	PendingDamage = 0.0f;
+	PendingDamageCauser.Reset();
+
+	if (Amount <= 0.0f)
+	{
+		return;
+	}
+
+	ReapplyMoveSpeedFromLastRequest();
+
+	OnNPCDamaged.Broadcast(this, Amount, Causer);
+	BP_OnDamaged(Amount, Causer);
+
+	ShowHealthBarNow();
+}
+
 void ANPCCharacter::HandleDeath(AActor* Killer)
 {
 	bIsDead = true;
 	CurrentHealth = 0.0f;
+	SetModeCounted(false);
 
 	CancelSpeedRamp();
 	GetWorldTimerManager().ClearTimer(BrainTimerHandle);
+	ExitBrainSleep();
+
+	if (ANPCAIController* NPCController = Cast<ANPCAIController>(GetController()))
+	{
+		NPCController->StopBehaviorStateTree();
+	}
+	bStateTreeDriven = false;
 
 	if (AAIController* AIC = Cast<AAIController>(GetController()))
 	{
+		// Kept so a pooled respawn can re-possess instead of spawning a new controller
+		PooledController = AIC;
 		AIC->StopMovement();
 		AIC->UnPossess();
 	}
@@ -917,16 +1069,26 @@ void ANPCCharacter::HandleDeath(AActor* Killer)
 		Capsule->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 	}
 
-	if (HealthBarComponent)
+	HideHealthBar();
+
+	if (GetTuning().bRagdollOnDeath)
 	{
-		GetWorldTimerManager().ClearTimer(HealthBarHideTimerHandle);
-		HealthBarComponent->SetHiddenInGame(true);
-		HealthBarComponent->SetVisibility(false, true);
+		UNPCRagdollSubsystem* Ragdolls = GetWorld()->GetSubsystem<UNPCRagdollSubsystem>();
+		if (!Ragdolls || Ragdolls->ShouldUseFullRagdoll(this))
+		{
+			if (EnterRagdoll(Killer) && Ragdolls)
+			{
+				Ragdolls->AddRagdoll(this);
+			}
+		}
+		else
+		{
+			PlayCheapDeath();
+		}
 	}
-
-	if (bRagdollOnDeath)
+	else
 	{
-		EnterRagdoll(Killer);
+		PlayCheapDeath();
 	}
 
 	SpawnDrops();
@@ -934,125 +1096,450 @@ void ANPCCharacter::HandleDeath(AActor* Killer)
 	OnNPCDied.Broadcast(this, Killer);
 	BP_OnDied(Killer);
 
-	if (bDestroyOnDeath)
+	if (GetTuning().bDestroyOnDeath)
 	{
-		SetLifeSpan(FMath::Max(0.01f, DestroyDelaySeconds));
+		if (GetTuning().bReturnToPoolOnDeath && GetWorld()->GetSubsystem<UNPCPoolSubsystem>())
+		{
+			GetWorldTimerManager().SetTimer(PoolReturnTimerHandle, this, &ANPCCharacter::ReturnToPool, FMath::Max(0.01f, GetTuning().DestroyDelaySeconds), false);
+		}
+		else
+		{
+			SetLifeSpan(FMath::Max(0.01f, GetTuning().DestroyDelaySeconds));
+		}
 	}
 }
 
-void ANPCCharacter::SpawnDrops()
+void ANPCCharacter::ReturnToPool()
 {
-	if (!GetWorld() || DropsOnDeath.Num() == 0)
+	if (UNPCPoolSubsystem* Pool = GetWorld() ? GetWorld()->GetSubsystem<UNPCPoolSubsystem>() : nullptr)
 	{
-		return;
+		Pool->ReleaseNPC(this);
 	}
-
-	const FVector BaseLoc = GetActorLocation() + FVector(0, 0, DropSpawnZOffset);
-
-	for (TSubclassOf<APickupItemActor> DropClass : DropsOnDeath)
+	else
 	{
-		if (!DropClass)
-		{
-			continue;
-		}
-
-		const FVector Rand2D = FVector(FMath::FRandRange(-1.f, 1.f), FMath::FRandRange(-1.f, 1.f), 0.f).GetSafeNormal();
-		const FVector Offset = Rand2D * FMath::FRandRange(0.f, DropScatterRadius);
-
-		FActorSpawnParameters Params;
-		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-
-		GetWorld()->SpawnActor<APickupItemActor>(
-			DropClass,
-			BaseLoc + Offset,
-			FRotator::ZeroRotator,
-			Params
-		);
+		Destroy();
 	}
 }
 
-// -------------------------
-// LockOnTargetable
-// -------------------------
-FVector ANPCCharacter::GetLockOnWorldLocation_Implementation() const
+void ANPCCharacter::DeactivateForPool()
 {
-	const UCapsuleComponent* Capsule = GetCapsuleComponent();
-	if (!Capsule)
-	{
-		return GetActorLocation();
-	}
+	bInPool = true;
+	SetModeCounted(false);
 
-	const float Half = Capsule->GetScaledCapsuleHalfHeight();
-	const float Z = Half * FMath::Clamp(LockOnAimHeightRatio, 0.0f, 1.0f);
+	// A queued flush finds nothing to report
+	PendingDamage = 0.0f;
+	PendingDamageCauser.Reset();
 
-	FVector Loc = GetActorLocation();
-	Loc.Z += Z;
-	return Loc;
-}
+	ExitBrainSleep();
+	CancelSpeedRamp();
+	GetWorldTimerManager().ClearAllTimersForObject(this);
 
-bool ANPCCharacter::IsLockOnAllowed_Implementation() const
-{
-	// Lock-on works for ALL NPCs (merchant, enemy, neutral), as long as they aren't dead.
-	return !bIsDead;
-}
+	if (UStatusEffectSubsystem* Effects = GetWorld()->GetSubsystem<UStatusEffectSubsystem>())
+	{
+		Effects->ClearEffects(this);
+	}
 
-// -------------------------
-// AI helpers (unchanged logic + auto-restore)
-// -------------------------
-bool ANPCCharacter::IsAIMoving(const AAIController* AIC) const
-{
-	if (!AIC)
+	if (ANPCAIController* NPCController = Cast<ANPCAIController>(GetController()))
 	{
-		return false;
+		NPCController->StopBehaviorStateTree();
 	}
-	return AIC->GetMoveStatus() == EPathFollowingStatus::Moving;
-}
+	bStateTreeDriven = false;
 
-bool ANPCCharacter::IsPlayerInReactionRange(const APawn* PlayerPawn) const
-{
-	if (!IsValid(PlayerPawn))
+	// Living NPCs released straight to the pool still hold their controller
+	if (AController* C = GetController())
 	{
-		return false;
+		PooledController = C;
+		C->StopMovement();
+		C->UnPossess();
 	}
-	return FVector::Dist2D(GetActorLocation(), PlayerPawn->GetActorLocation()) <= ReactionRange;
-}
 
-bool ANPCCharacter::CanNoticePlayerCone(const APawn* PlayerPawn) const
-{
-	if (!IsValid(PlayerPawn))
+	if (UNPCAmbientSubsystem* Ambient = GetWorld()->GetSubsystem<UNPCAmbientSubsystem>())
 	{
-		return false;
+		Ambient->UnregisterCandidate(this);
 	}
 
-	const FVector MyLoc = GetActorLocation();
-	const FVector PlayerLoc = PlayerPawn->GetActorLocation();
+	BindToSafeZone(nullptr);
 
-	const FVector ToPlayer2D(PlayerLoc.X - MyLoc.X, PlayerLoc.Y - MyLoc.Y, 0.0f);
-	const float Dist2D = ToPlayer2D.Size();
+	ExitRagdoll();
 
-	if (Dist2D > ReactionRange || Dist2D <= KINDA_SMALL_NUMBER)
+	if (UCharacterMovementComponent* MoveComp = GetCharacterMovement())
 	{
-		return false;
+		MoveComp->StopMovementImmediately();
+		MoveComp->DisableMovement();
+		MoveComp->SetComponentTickEnabled(false);
 	}
 
-	const FVector Forward2D(GetActorForwardVector().X, GetActorForwardVector().Y, 0.0f);
-	const FVector ForwardN = Forward2D.GetSafeNormal();
-	const FVector DirN = ToPlayer2D.GetSafeNormal();
-
-	const float HalfAngleRad = FMath::DegreesToRadians(NoticeFOVDegrees * 0.5f);
-	const float CosThreshold = FMath::Cos(HalfAngleRad);
+	HideHealthBar();
 
-	return FVector::DotProduct(ForwardN, DirN) >= CosThreshold;
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
 }
 
-void ANPCCharacter::UpdateLoseInterestTimer(bool bPlayerInRange)
+void ANPCCharacter::ReactivateFromPool(const FTransform& SpawnTransform, ANPCSafeZone* Zone, bool bRegisterWithZone)
 {
-	if (!GetWorld())
-	{
-		return;
-	}
+	UWorld* World = GetWorld();
+	if (!World) return;
 
-	const float Now = GetWorld()->GetTimeSeconds();
+	bInPool = false;
+
+	SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+
+	if (bRegisterWithZone)
+	{
+		SafeZone = Zone;
+		BindToSafeZone(Zone);
+	}
+	else
+	{
+		SetSafeZone(Zone, false);
+	}
+
+	// Fresh-spawn state; InitializeRuntimeState refills health when it's zero
+	bIsDead = false;
+	CurrentHealth = 0.0f;
+	SetMode(ENPCMode::Wander);
+	InteractionPauseUntilTime = -1.0f;
+	InteractionFaceTarget.Reset();
+	LastReactionMoveTime = -1000.0f;
+	StuckStartTime = -1.0f;
+	bWasMovingLastTick = false;
+	ClearLoseInterestTimer();
+	ResetReturnHomeCache();
+
+	InitializeRuntimeState();
+	SetModeCounted(true);
+
+	HomeLocation = GetActorLocation();
+	LastDamageTimeSeconds = World->GetTimeSeconds();
+	NextWanderAllowedTime = LastDamageTimeSeconds + FMath::FRandRange(GetTuning().WanderWaitMin, GetTuning().WanderWaitMax);
+
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	ApplyCollisionDefaults();
+	ApplyVisualDefaults();
+
+	if (UCharacterMovementComponent* MoveComp = GetCharacterMovement())
+	{
+		MoveComp->SetComponentTickEnabled(true);
+		MoveComp->SetMovementMode(MOVE_Walking);
+	}
+
+	if (AController* C = PooledController.Get())
+	{
+		C->Possess(this);
+	}
+	else
+	{
+		SpawnDefaultController();
+	}
+	PooledController.Reset();
+
+	if (GetTuning().BehaviorStateTree)
+	{
+		if (ANPCAIController* NPCController = Cast<ANPCAIController>(GetController()))
+		{
+			NPCController->RunBehaviorStateTree(GetTuning().BehaviorStateTree);
+			bStateTreeDriven = NPCController->IsRunningBehaviorStateTree();
+		}
+	}
+
+	SetSpeedImmediate(GetTuning().WanderSpeed);
+
+	StartBrainTimer();
+
+	if (GetTuning().bAllowAmbientProxy)
+	{
+		if (UNPCAmbientSubsystem* Ambient = World->GetSubsystem<UNPCAmbientSubsystem>())
+		{
+			Ambient->RegisterCandidate(this);
+		}
+	}
+}
+
+void ANPCCharacter::SetSafeZone(ANPCSafeZone* Zone, bool bRegisterWithZone)
+{
+	SafeZone = Zone;
+
+	if (!bRegisterWithZone)
+	{
+		if (LastRegisteredZone.IsValid() && LastRegisteredZone.Get() != Zone)
+		{
+			LastRegisteredZone->UnregisterNPC(this);
+		}
+		LastRegisteredZone = Zone;
+		return;
+	}
+
+	// Before BeginPlay OnConstruction does the registration
+	if (HasActorBegunPlay())
+	{
+		BindToSafeZone(Zone);
+	}
+}
+
+void ANPCCharacter::SetArchetype(UNPCArchetype* NewArchetype)
+{
+	if (!NewArchetype)
+	{
+		NewArchetype = GetClass()->GetDefaultObject<ANPCCharacter>()->Archetype;
+	}
+
+	if (Archetype == NewArchetype)
+	{
+		return;
+	}
+
+	Archetype = NewArchetype;
+	ApplyArchetypeSetup();
+}
+
+void ANPCCharacter::StartBrainTimer()
+{
+	// Random first delay so a batch spawned on one frame doesn't think on the same frame forever after
+	const float Interval = FMath::Max(0.01f, GetTuning().BrainTickSeconds);
+
+	GetWorldTimerManager().SetTimer(
+		BrainTimerHandle,
+		this,
+		&ANPCCharacter::BrainTick,
+		Interval,
+		true,
+		FMath::FRandRange(0.01f, Interval)
+	);
+}
+
+void ANPCCharacter::BindToSafeZone(ANPCSafeZone* Zone)
+{
+	if (LastRegisteredZone.Get() == Zone)
+	{
+		return;
+	}
+
+	if (LastRegisteredZone.IsValid())
+	{
+		LastRegisteredZone->UnregisterNPC(this);
+	}
+	LastRegisteredZone = Zone;
+
+	if (IsValid(Zone))
+	{
+		Zone->RegisterNPC(this);
+	}
+}
+
+void ANPCCharacter::ExitRagdoll()
+{
+	StopAnimMontage();
+
+	USkeletalMeshComponent* SkelMesh = GetMesh();
+	if (!SkelMesh || !SkelMesh->IsSimulatingPhysics())
+	{
+		return;
+	}
+
+	if (UNPCRagdollSubsystem* Ragdolls = GetWorld()->GetSubsystem<UNPCRagdollSubsystem>())
+	{
+		Ragdolls->RemoveRagdoll(this);
+	}
+
+	SkelMesh->SetAllBodiesSimulatePhysics(false);
+	SkelMesh->SetSimulatePhysics(false);
+	SkelMesh->bBlendPhysics = false;
+
+	// Undo FreezeRagdoll
+	SkelMesh->SetEnableGravity(true);
+	SkelMesh->SetComponentTickEnabled(true);
+
+	if (PreRagdollMeshProfile != NAME_None)
+	{
+		SkelMesh->SetCollisionProfileName(PreRagdollMeshProfile);
+	}
+
+	SkelMesh->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+	ApplyVisualDefaults();
+}
+
+void ANPCCharacter::SpawnDrops()
+{
+	const FNPCTuning& Tuning = GetTuning();
+	if (!GetWorld() || (!Tuning.LootTable && Tuning.DropsOnDeath.Num() == 0))
+	{
+		return;
+	}
+
+	const FVector BaseLoc = GetActorLocation() + FVector(0, 0, Tuning.DropSpawnZOffset);
+	auto ScatteredTransform = [&Tuning, &BaseLoc]()
+	{
+		const FVector Rand2D = FVector(FMath::FRandRange(-1.f, 1.f), FMath::FRandRange(-1.f, 1.f), 0.f).GetSafeNormal();
+		return FTransform(BaseLoc + Rand2D * FMath::FRandRange(0.f, Tuning.DropScatterRadius));
+	};
+
+	TArray<FItemStack> Stacks;
+
+	if (Tuning.LootTable)
+	{
+		Tuning.LootTable->RollLootInto(1, FRandomStream(FMath::Rand()), Stacks);
+	}
+
+	if (Tuning.bSpawnDropsAsActors)
+	{
+		// Opt-in: each legacy drop keeps its own Blueprint actor
+		FActorSpawnParameters Params;
+		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+		for (TSubclassOf<APickupItemActor> DropClass : Tuning.DropsOnDeath)
+		{
+			if (DropClass)
+			{
+				GetWorld()->SpawnActor<APickupItemActor>(DropClass, ScatteredTransform(), Params);
+			}
+		}
+	}
+	else
+	{
+		// Legacy drops join the loot roll, so one death is one pile
+		for (TSubclassOf<APickupItemActor> DropClass : Tuning.DropsOnDeath)
+		{
+			if (const APickupItemActor* DropCDO = DropClass ? DropClass->GetDefaultObject<APickupItemActor>() : nullptr)
+			{
+				DropCDO->GetAllStacks(Stacks);
+			}
+		}
+	}
+
+	if (Stacks.Num() == 0)
+	{
+		return;
+	}
+
+	const FTransform SpawnTransform = ScatteredTransform();
+
+	TSubclassOf<APickupItemActor> ContainerClass = Tuning.LootContainerClass;
+	if (!ContainerClass)
+	{
+		// No custom container: drop as an instanced record when the items have ground meshes
+		if (UPickupSubsystem* Pickups = GetWorld()->GetSubsystem<UPickupSubsystem>())
+		{
+			if (Pickups->AddPickup(Stacks, SpawnTransform) != 0)
+			{
+				return;
+			}
+		}
+
+		ContainerClass = ALootContainerActor::StaticClass();
+	}
+
+	APickupItemActor* Container = GetWorld()->SpawnActorDeferred<APickupItemActor>(ContainerClass, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+	if (!Container)
+	{
+		return;
+	}
+
+	Container->ItemData = nullptr;
+	Container->Quantity = 0;
+	Container->Contents = MoveTemp(Stacks);
+	Container->FinishSpawning(SpawnTransform);
+}
+
+// -------------------------
+// LockOnTargetable
+// -------------------------
+FVector ANPCCharacter::GetLockOnWorldLocation_Implementation() const
+{
+	const UCapsuleComponent* Capsule = GetCapsuleComponent();
+	if (!Capsule)
+	{
+		return GetActorLocation();
+	}
+
+	const float Half = Capsule->GetScaledCapsuleHalfHeight();
+	const float Z = Half * FMath::Clamp(GetTuning().LockOnAimHeightRatio, 0.0f, 1.0f);
+
+	FVector Loc = GetActorLocation();
+	Loc.Z += Z;
+	return Loc;
+}
+
+bool ANPCCharacter::IsLockOnAllowed_Implementation() const
+{
+	// Lock-on works for ALL NPCs (merchant, enemy, neutral), as long as they aren't dead.
+	return !bIsDead;
+}
+
+// -------------------------
+// AI helpers (unchanged logic + auto-restore)
+// -------------------------
+bool ANPCCharacter::IsAIMoving(const AAIController* AIC) const
+{
+	if (!AIC)
+	{
+		return false;
+	}
+	return AIC->GetMoveStatus() == EPathFollowingStatus::Moving;
+}
+
+void ANPCCharacter::MoveToLocationCached(AAIController* AIC, const FVector& Dest, float AcceptanceRadius)
+{
+	if (!AIC || !GetWorld()) return;
+
+	// Neighbours heading to the same spot share one path query
+	if (UNPCPathCacheSubsystem* PathCache = GetWorld()->GetSubsystem<UNPCPathCacheSubsystem>())
+	{
+		if (PathCache->RequestCachedMove(AIC, Dest, AcceptanceRadius))
+		{
+			return;
+		}
+	}
+
+	CPPTESTS_COUNT(STAT_CPPTests_NavQueries, NavQueries, 1);
+	AIC->MoveToLocation(Dest, AcceptanceRadius);
+}
+
+bool ANPCCharacter::IsPlayerInReactionRange(const APawn* PlayerPawn) const
+{
+	if (!IsValid(PlayerPawn))
+	{
+		return false;
+	}
+	return FVector::Dist2D(GetActorLocation(), PlayerPawn->GetActorLocation()) <= GetTuning().ReactionRange;
+}
+
+bool ANPCCharacter::CanNoticePlayerCone(const APawn* PlayerPawn) const
+{
+	if (!IsValid(PlayerPawn))
+	{
+		return false;
+	}
+
+	const FVector MyLoc = GetActorLocation();
+	const FVector PlayerLoc = PlayerPawn->GetActorLocation();
+
+	const FVector ToPlayer2D(PlayerLoc.X - MyLoc.X, PlayerLoc.Y - MyLoc.Y, 0.0f);
+	const float Dist2D = ToPlayer2D.Size();
+
+	if (Dist2D > GetTuning().ReactionRange || Dist2D <= KINDA_SMALL_NUMBER)
+	{
+		return false;
+	}
+
+	const FVector Forward2D(GetActorForwardVector().X, GetActorForwardVector().Y, 0.0f);
+	const FVector ForwardN = Forward2D.GetSafeNormal();
+	const FVector DirN = ToPlayer2D.GetSafeNormal();
+
+	const float HalfAngleRad = FMath::DegreesToRadians(GetTuning().NoticeFOVDegrees * 0.5f);
+	const float CosThreshold = FMath::Cos(HalfAngleRad);
+
+	return FVector::DotProduct(ForwardN, DirN) >= CosThreshold;
+}
+
+void ANPCCharacter::UpdateLoseInterestTimer(bool bPlayerInRange)
+{
+	if (!GetWorld())
+	{
+		return;
+	}
+
+	const float Now = GetWorld()->GetTimeSeconds();
 
 	if (bPlayerInRange)
 	{
@@ -1072,10 +1559,11 @@ void ANPCCharacter::UpdateLoseInterestTimer(bool bPlayerInRange)
 		return;
 	}
 
-	if ((Now - OutOfRangeStartTime) >= LoseInterestSeconds)
+	if ((Now - OutOfRangeStartTime) >= GetTuning().LoseInterestSeconds)
 	{
-		CurrentMode = ENPCMode::ReturnHome;
 		ClearLoseInterestTimer();
+
+		SetMode(ENPCMode::ReturnHome);
 		ResetReturnHomeCache();
 	}
 }
@@ -1102,43 +1590,37 @@ void ANPCCharacter::SetSpeedImmediate(float Speed)
 
 void ANPCCharacter::StartSpeedRampTo(float TargetSpeed, float DurationSeconds, bool bFromZero)
 {
-	if (!GetWorld())
+	UWorld* World = GetWorld();
+	if (!World)
 	{
 		return;
 	}
 
-	if (UCharacterMovementComponent* MoveComp = GetCharacterMovement())
+	UNPCMovementSpeedSubsystem* SpeedSubsystem = World->GetSubsystem<UNPCMovementSpeedSubsystem>();
+	if (!SpeedSubsystem)
 	{
-		LastRequestedBaseSpeed = TargetSpeed;
-
-		RampStartTime = GetWorld()->GetTimeSeconds();
-		RampDuration = DurationSeconds;
-
-		RampStartSpeed = bFromZero ? 0.0f : MoveComp->MaxWalkSpeed;
-		RampTargetSpeed = TargetSpeed * GetLowHealthMoveMultiplier();
-
-		bSpeedRamping = true;
-		SetActorTickEnabled(true);
-
-		MoveComp->MaxWalkSpeed = RampStartSpeed;
+		SetSpeedImmediate(TargetSpeed);
+		return;
 	}
+
+	LastRequestedBaseSpeed = TargetSpeed;
+	SpeedSubsystem->StartRamp(this, TargetSpeed, DurationSeconds, bFromZero);
 }
 
 void ANPCCharacter::TryAutoRestoreHealth(float NowSeconds)
 {
-	if (!bAutoRestoreHealthWhenCalm) return;
+	if (!GetTuning().bAutoRestoreHealthWhenCalm) return;
 	if (bIsDead) return;
-	if (bIsImmortal) return;
+	if (GetTuning().bIsImmortal) return;
 
-	if (MaxHealth <= 0.0f) return;
-	if (CurrentHealth >= MaxHealth) return;
+	if (CurrentHealth >= GetMaxHealth()) return;
 
 	if (CurrentMode == ENPCMode::Chase || CurrentMode == ENPCMode::Flee)
 	{
 		return;
 	}
 
-	const float Delay = FMath::Max(0.0f, RestoreHealthDelaySeconds);
+	const float Delay = FMath::Max(0.0f, GetTuning().RestoreHealthDelaySeconds);
 	if ((NowSeconds - LastDamageTimeSeconds) < Delay)
 	{
 		return;
@@ -1154,21 +1636,10 @@ void ANPCCharacter::TryAutoRestoreHealth(float NowSeconds)
 		return;
 	}
 
-	CurrentHealth = MaxHealth;
+	CurrentHealth = GetMaxHealth();
 	ReapplyMoveSpeedFromLastRequest();
 
-	if (HealthBarComponent)
-	{
-		GetWorldTimerManager().ClearTimer(HealthBarHideTimerHandle);
-
-		if (UNPCHealthBarWidget* W = Cast<UNPCHealthBarWidget>(HealthBarComponent->GetUserWidgetObject()))
-		{
-			W->SetHealthPercent(1.0f);
-		}
-
-		HealthBarComponent->SetHiddenInGame(true);
-		HealthBarComponent->SetVisibility(false, true);
-	}
+	HideHealthBar();
 }
 
 bool ANPCCharacter::FindFleeDestination(APawn* PlayerPawn, FVector& OutDest) const
@@ -1202,17 +1673,18 @@ bool ANPCCharacter::FindFleeDestination(APawn* PlayerPawn, FVector& OutDest) con
 		return false;
 	}
 
-	const float HalfJitter = FleeAngleJitterDegrees * 0.5f;
+	const float HalfJitter = GetTuning().FleeAngleJitterDegrees * 0.5f;
 
-	for (int32 i = 0; i < FleeSampleTries; ++i)
+	for (int32 i = 0; i < GetTuning().FleeSampleTries; ++i)
 	{
 		const float Angle = FMath::FRandRange(-HalfJitter, HalfJitter);
 		const FVector RotDir = AwayDir.RotateAngleAxis(Angle, FVector::UpVector);
 
-		const FVector Desired = MyLoc + RotDir * FleeDistance;
+		const FVector Desired = MyLoc + RotDir * GetTuning().FleeDistance;
 
 		FNavLocation NavLoc;
-		if (NavSys->GetRandomReachablePointInRadius(Desired, FleeNavSearchRadius, NavLoc))
+		CPPTESTS_COUNT(STAT_CPPTests_NavQueries, NavQueries, 1);
+		if (NavSys->GetRandomReachablePointInRadius(Desired, GetTuning().FleeNavSearchRadius, NavLoc))
 		{
 			OutDest = NavLoc.Location;
 			return true;
@@ -1220,7 +1692,8 @@ bool ANPCCharacter::FindFleeDestination(APawn* PlayerPawn, FVector& OutDest) con
 	}
 
 	FNavLocation NavLoc;
-	if (NavSys->GetRandomReachablePointInRadius(MyLoc, FleeDistance, NavLoc))
+	CPPTESTS_COUNT(STAT_CPPTests_NavQueries, NavQueries, 1);
+	if (NavSys->GetRandomReachablePointInRadius(MyLoc, GetTuning().FleeDistance, NavLoc))
 	{
 		OutDest = NavLoc.Location;
 		return true;
@@ -1242,13 +1715,44 @@ bool ANPCCharacter::IsInsideSafeZone2D() const
 
 void ANPCCharacter::ResetReturnHomeCache()
 {
-	bHasReturnTarget = false;
-	CachedReturnTarget = FVector::ZeroVector;
-	LastReturnTargetPickTime = -1000.0f;
+	ReturnHomeState.Reset();
+}
+
+void ANPCCharacter::AdjustModeStat(ENPCMode Mode, int32 Delta)
+{
+	switch (Mode)
+	{
+	case ENPCMode::Wander:     INC_DWORD_STAT_BY(STAT_CPPTests_NPCsWander, Delta); break;
+	case ENPCMode::Chase:      INC_DWORD_STAT_BY(STAT_CPPTests_NPCsChase, Delta); break;
+	case ENPCMode::Flee:       INC_DWORD_STAT_BY(STAT_CPPTests_NPCsFlee, Delta); break;
+	case ENPCMode::ReturnHome: INC_DWORD_STAT_BY(STAT_CPPTests_NPCsReturnHome, Delta); break;
+	default: break;
+	}
+}
+
+void ANPCCharacter::SetMode(ENPCMode NewMode)
+{
+	if (bModeCounted && NewMode != CurrentMode)
+	{
+		AdjustModeStat(CurrentMode, -1);
+		AdjustModeStat(NewMode, 1);
+	}
+	CurrentMode = NewMode;
+}
+
+void ANPCCharacter::SetModeCounted(bool bCounted)
+{
+	if (bModeCounted != bCounted)
+	{
+		bModeCounted = bCounted;
+		AdjustModeStat(CurrentMode, bCounted ? 1 : -1);
+	}
 }
 
 void ANPCCharacter::BrainTick()
 {
+	CPPTESTS_SCOPE(STAT_CPPTests_BrainTick, NPC_BrainTick);
+
 	if (bIsDead)
 	{
 		return;
@@ -1273,13 +1777,17 @@ void ANPCCharacter::BrainTick()
 		}
 		else
 		{
-			UpdateFaceTarget(BrainTickSeconds);
+			UpdateFaceTarget(GetTuning().BrainTickSeconds);
 			return;
 		}
 	}
 
 	if (bIsStationary)
 	{
+		if (CanBrainSleep(nullptr))
+		{
+			EnterBrainSleep(nullptr);
+		}
 		return;
 	}
 
@@ -1298,7 +1806,7 @@ void ANPCCharacter::BrainTick()
 		{
 			StuckStartTime = Now;
 		}
-		else if ((Now - StuckStartTime) >= StuckAbortSeconds)
+		else if ((Now - StuckStartTime) >= GetTuning().StuckAbortSeconds)
 		{
 			AIC->StopMovement();
 			StuckStartTime = -1.0f;
@@ -1311,7 +1819,7 @@ void ANPCCharacter::BrainTick()
 
 	if (bWasMovingLastTick && !bMovingNow && CurrentMode == ENPCMode::Wander)
 	{
-		NextWanderAllowedTime = Now + FMath::FRandRange(WanderWaitMin, WanderWaitMax);
+		NextWanderAllowedTime = Now + FMath::FRandRange(GetTuning().WanderWaitMin, GetTuning().WanderWaitMax);
 	}
 	bWasMovingLastTick = bMovingNow;
 
@@ -1324,19 +1832,45 @@ void ANPCCharacter::BrainTick()
 	{
 		ClearLoseInterestTimer();
 
-		if (bIsAggressive && IsValid(PlayerPawn))
+		if (bStateTreeDriven)
+		{
+			// Tree picks Chase/Flee from the NPC's role
+			if ((bIsAggressive || bIsScaredOfPlayer) && IsValid(PlayerPawn))
+			{
+				SendBehaviorEvent(NPCTags::Event_PlayerNoticed);
+			}
+		}
+		else if (bIsAggressive && IsValid(PlayerPawn))
 		{
-			CurrentMode = ENPCMode::Chase;
+			SetMode(ENPCMode::Chase);
 		}
 		else if (bIsScaredOfPlayer && IsValid(PlayerPawn))
 		{
-			CurrentMode = ENPCMode::Flee;
+			SetMode(ENPCMode::Flee);
 		}
 	}
 
-	UpdateLoseInterestTimer(bInRange);
+	// Tree tasks own Chase/Flee/ReturnHome (including losing interest); the brain only senses and keeps idle wandering going
+	if (!bStateTreeDriven)
+	{
+		UpdateLoseInterestTimer(bInRange);
+	}
+
+	if (bStateTreeDriven)
+	{
+		if (CurrentMode == ENPCMode::Wander)
+		{
+			Wander(AIC);
+
+			if (CanBrainSleep(PlayerPawn))
+			{
+				EnterBrainSleep(AIC);
+			}
+		}
+		return;
+	}
 
-	const bool bCanRepathNow = (Now - LastReactionMoveTime) >= ReactionRepathInterval;
+	const bool bCanRepathNow = (Now - LastReactionMoveTime) >= GetTuning().ReactionRepathInterval;
 
 	if (CurrentMode == ENPCMode::Chase)
 	{
@@ -1360,72 +1894,379 @@ void ANPCCharacter::BrainTick()
 
 	if (CurrentMode == ENPCMode::ReturnHome)
 	{
-		ReturnHome(AIC);
-
-		if (CurrentMode == ENPCMode::Wander)
+		if (ReturnHome(AIC, ReturnHomeState))
 		{
 			Wander(AIC);
 		}
 		return;
 	}
 
-	CurrentMode = ENPCMode::Wander;
+	SetMode(ENPCMode::Wander);
 	Wander(AIC);
+
+	// Nothing to react to: stop polling until the player gets close or we take damage
+	if (CanBrainSleep(PlayerPawn))
+	{
+		EnterBrainSleep(AIC);
+	}
+}
+
+bool ANPCCharacter::CanBecomeAmbientProxy() const
+{
+	if (!GetTuning().bAllowAmbientProxy || bIsDead || bIsStationary || !IsNeutral())
+	{
+		return false;
+	}
+
+	// Only calm, untouched wanderers; anything mid-reaction stays an actor
+	if (CurrentMode != ENPCMode::Wander || InteractionPauseUntilTime > 0.f)
+	{
+		return false;
+	}
+
+	const UNPCHealthBarSubsystem* Bars = GetWorld() ? GetWorld()->GetSubsystem<UNPCHealthBarSubsystem>() : nullptr;
+	return !Bars || !Bars->IsBarShown(this);
+}
+
+FNPCAmbientState ANPCCharacter::CaptureAmbientState() const
+{
+	FNPCAmbientState State;
+	State.Location = GetActorLocation();
+	State.Yaw = GetActorRotation().Yaw;
+	State.Health = (CurrentHealth > 0.0f) ? CurrentHealth : GetMaxHealth();
+	State.HomeCenter = GetHomeCenter();
+	State.WanderRadius = IsValid(SafeZone) ? FMath::Min(GetTuning().WanderRadius, SafeZone->GetZoneRadius()) : GetTuning().WanderRadius;
+	State.WanderSpeed = GetTuning().WanderSpeed;
+	State.SafeZone = SafeZone;
+	State.Archetype = Archetype;
+	return State;
+}
+
+void ANPCCharacter::RestoreFromAmbientState(const FNPCAmbientState& State)
+{
+	CurrentHealth = FMath::Clamp(State.Health, 1.0f, GetMaxHealth());
+	ReapplyMoveSpeedFromLastRequest();
+
+	if (ANPCSafeZone* Zone = State.SafeZone.Get())
+	{
+		SafeZone = Zone;
+		HomeLocation = Zone->GetActorLocation();
+		BindToSafeZone(Zone);
+	}
+	else
+	{
+		HomeLocation = State.HomeCenter;
+	}
+}
+
+UStaticMesh* ANPCCharacter::GetAmbientProxyMesh() const
+{
+	if (GetTuning().AmbientProxyMesh)
+	{
+		return GetTuning().AmbientProxyMesh;
+	}
+	return VisualMesh ? VisualMesh->GetStaticMesh() : nullptr;
+}
+
+FTransform ANPCCharacter::GetAmbientProxyMeshOffset() const
+{
+	if (GetTuning().AmbientProxyMesh || !VisualMesh)
+	{
+		return FTransform::Identity;
+	}
+	return VisualMesh->GetRelativeTransform();
+}
+
+void ANPCCharacter::SendBehaviorEvent(const FGameplayTag& Tag)
+{
+	if (ANPCAIController* NPCController = Cast<ANPCAIController>(GetController()))
+	{
+		NPCController->SendBehaviorEvent(Tag);
+	}
+}
+
+bool ANPCCharacter::CanBrainSleep(const APawn* PlayerPawn) const
+{
+	if (!GetTuning().bAllowBrainSleep || bBrainAsleep || bIsDead)
+	{
+		return false;
+	}
+
+	if (CurrentMode != ENPCMode::Wander || InteractionPauseUntilTime > 0.f)
+	{
+		return false;
+	}
+
+	// Stationary NPCs never react to the player, only to damage/interaction
+	if (bIsStationary || !IsValid(PlayerPawn))
+	{
+		return true;
+	}
+
+	return FVector::Dist2D(PlayerPawn->GetActorLocation(), GetHomeCenter()) > GetSleepShellRadius();
+}
+
+float ANPCCharacter::GetSleepShellRadius() const
+{
+	// Wander can carry us WanderRadius from home (or further if we were still walking back)
+	const float Drift = FMath::Max(GetTuning().WanderRadius, FVector::Dist2D(GetActorLocation(), GetHomeCenter()));
+	return GetTuning().ReactionRange + Drift + GetTuning().SleepShellSlack;
+}
+
+void ANPCCharacter::EnterBrainSleep(AAIController* AIC)
+{
+	UWorld* World = GetWorld();
+	UNPCPerceptionSubsystem* Perception = World ? World->GetSubsystem<UNPCPerceptionSubsystem>() : nullptr;
+	if (!Perception)
+	{
+		return;
+	}
+
+	bBrainAsleep = true;
+	StuckStartTime = -1.0f;
+	GetWorldTimerManager().ClearTimer(BrainTimerHandle);
+
+	if (!bIsStationary)
+	{
+		Perception->RegisterSleeper(this, GetHomeCenter(), GetSleepShellRadius());
+	}
+
+	// Pending auto-restore: wake up once when it's due instead of polling for it
+	if (GetTuning().bAutoRestoreHealthWhenCalm && !GetTuning().bIsImmortal && CurrentHealth < GetMaxHealth())
+	{
+		const float Remaining = (LastDamageTimeSeconds + FMath::Max(0.0f, GetTuning().RestoreHealthDelaySeconds)) - World->GetTimeSeconds();
+		GetWorldTimerManager().SetTimer(SleepRestoreTimerHandle, this, &ANPCCharacter::WakeBrain, FMath::Max(0.05f, Remaining), false);
+	}
+
+	// Wander keeps going off move-completed events
+	if (AIC)
+	{
+		AIC->ReceiveMoveCompleted.AddUniqueDynamic(this, &ANPCCharacter::HandleSleepMoveCompleted);
+
+		if (!IsAIMoving(AIC))
+		{
+			ScheduleSleepWander();
+		}
+		else
+		{
+			StartSleepStuckCheck();
+		}
+	}
+}
+
+void ANPCCharacter::ExitBrainSleep()
+{
+	if (!bBrainAsleep)
+	{
+		return;
+	}
+
+	bBrainAsleep = false;
+
+	if (UWorld* World = GetWorld())
+	{
+		if (UNPCPerceptionSubsystem* Perception = World->GetSubsystem<UNPCPerceptionSubsystem>())
+		{
+			Perception->UnregisterSleeper(this);
+		}
+	}
+
+	GetWorldTimerManager().ClearTimer(SleepWanderTimerHandle);
+	GetWorldTimerManager().ClearTimer(SleepRestoreTimerHandle);
+	GetWorldTimerManager().ClearTimer(SleepStuckTimerHandle);
+	StuckStartTime = -1.0f;
+
+	if (AAIController* AIC = Cast<AAIController>(GetController()))
+	{
+		AIC->ReceiveMoveCompleted.RemoveDynamic(this, &ANPCCharacter::HandleSleepMoveCompleted);
+	}
+}
+
+void ANPCCharacter::WakeBrain()
+{
+	if (!bBrainAsleep || bIsDead)
+	{
+		return;
+	}
+
+	ExitBrainSleep();
+
+	if (AAIController* AIC = Cast<AAIController>(GetController()))
+	{
+		bWasMovingLastTick = IsAIMoving(AIC);
+	}
+
+	// Short first delay so we react next frame instead of a full BrainTickSeconds later
+	GetWorldTimerManager().SetTimer(
+		BrainTimerHandle,
+		this,
+		&ANPCCharacter::BrainTick,
+		GetTuning().BrainTickSeconds,
+		true,
+		0.01f
+	);
+}
+
+void ANPCCharacter::ScheduleSleepWander()
+{
+	if (!GetWorld()) return;
+
+	const float Delay = FMath::Max(0.05f, NextWanderAllowedTime - GetWorld()->GetTimeSeconds());
+	GetWorldTimerManager().SetTimer(SleepWanderTimerHandle, this, &ANPCCharacter::SleepWanderTick, Delay, false);
+}
+
+void ANPCCharacter::SleepWanderTick()
+{
+	AAIController* AIC = Cast<AAIController>(GetController());
+	if (!bBrainAsleep || !AIC) return;
+
+	Wander(AIC);
+
+	// No destination yet, Wander already pushed NextWanderAllowedTime out
+	if (!IsAIMoving(AIC))
+	{
+		ScheduleSleepWander();
+		return;
+	}
+
+	StartSleepStuckCheck();
+}
+
+void ANPCCharacter::StartSleepStuckCheck()
+{
+	StuckStartTime = -1.0f;
+
+	// Same stuck rule BrainTick uses, on its own slow timer since nothing else is watching while asleep
+	const float Interval = FMath::Clamp(GetTuning().StuckAbortSeconds * 0.5f, 0.1f, 1.0f);
+	GetWorldTimerManager().SetTimer(SleepStuckTimerHandle, this, &ANPCCharacter::SleepStuckCheck, Interval, true);
+}
+
+void ANPCCharacter::SleepStuckCheck()
+{
+	AAIController* AIC = Cast<AAIController>(GetController());
+	UWorld* World = GetWorld();
+	if (!bBrainAsleep || !AIC || !World || !IsAIMoving(AIC))
+	{
+		GetWorldTimerManager().ClearTimer(SleepStuckTimerHandle);
+		StuckStartTime = -1.0f;
+		return;
+	}
+
+	const float Now = World->GetTimeSeconds();
+
+	if (GetVelocity().Size2D() >= 3.0f)
+	{
+		StuckStartTime = -1.0f;
+		return;
+	}
+
+	if (StuckStartTime < 0.0f)
+	{
+		StuckStartTime = Now;
+		return;
+	}
+
+	if ((Now - StuckStartTime) < GetTuning().StuckAbortSeconds)
+	{
+		return;
+	}
+
+	// Stalled against something: drop the move and pick a new spot after the usual wait
+	GetWorldTimerManager().ClearTimer(SleepStuckTimerHandle);
+	StuckStartTime = -1.0f;
+	AIC->StopMovement();
+
+	if (bBrainAsleep && !GetWorldTimerManager().IsTimerActive(SleepWanderTimerHandle))
+	{
+		NextWanderAllowedTime = Now + FMath::FRandRange(GetTuning().WanderWaitMin, GetTuning().WanderWaitMax);
+		ScheduleSleepWander();
+	}
+}
+
+void ANPCCharacter::HandleSleepMoveCompleted(FAIRequestID RequestID, EPathFollowingResult::Type Result)
+{
+	if (!bBrainAsleep || !GetWorld()) return;
+
+	GetWorldTimerManager().ClearTimer(SleepStuckTimerHandle);
+
+	NextWanderAllowedTime = GetWorld()->GetTimeSeconds() + FMath::FRandRange(GetTuning().WanderWaitMin, GetTuning().WanderWaitMax);
+	ScheduleSleepWander();
 }
 
 void ANPCCharacter::ChasePlayer(AAIController* AIC, APawn* PlayerPawn)
 {
 	if (!AIC || !PlayerPawn) return;
 
-	SetSpeedImmediate(MaxReactionSpeed);
-	AIC->MoveToActor(PlayerPawn, ChaseAcceptanceRadius);
+	SetSpeedImmediate(GetTuning().MaxReactionSpeed);
+
+	// Far out: walk down the shared field instead of pathfinding to the player per NPC.
+	// The hop to the waypoint is still pathed (cells are coarse, a straight line can clip a wall);
+	// it's short and shared by everyone chasing from the same cell, so the path cache absorbs it.
+	if (UNPCNavFieldSubsystem* NavField = GetWorld()->GetSubsystem<UNPCNavFieldSubsystem>())
+	{
+		FVector Waypoint;
+		if (NavField->GetChaseWaypoint(GetActorLocation(), Waypoint))
+		{
+			MoveToLocationCached(AIC, Waypoint, -1.0f);
+			return;
+		}
+	}
+
+	AIC->MoveToActor(PlayerPawn, GetTuning().ChaseAcceptanceRadius);
 }
 
 void ANPCCharacter::FleeFromPlayer(AAIController* AIC, APawn* PlayerPawn)
 {
 	if (!AIC || !PlayerPawn) return;
 
-	SetSpeedImmediate(MaxReactionSpeed);
+	SetSpeedImmediate(GetTuning().MaxReactionSpeed);
 
 	FVector Dest;
-	if (FindFleeDestination(PlayerPawn, Dest))
+	bool bHasDest = false;
+
+	if (UNPCNavFieldSubsystem* NavField = GetWorld()->GetSubsystem<UNPCNavFieldSubsystem>())
 	{
-		AIC->MoveToLocation(Dest, 80.0f);
+		bHasDest = NavField->GetFleeWaypoint(GetActorLocation(), GetTuning().FleeDistance, Dest);
+	}
+
+	if (bHasDest || FindFleeDestination(PlayerPawn, Dest))
+	{
+		MoveToLocationCached(AIC, Dest, 80.0f);
 	}
 }
 
-void ANPCCharacter::ReturnHome(AAIController* AIC)
+bool ANPCCharacter::ReturnHome(AAIController* AIC, FNPCReturnHomeState& State)
 {
-	if (!AIC || !GetWorld()) return;
+	if (!AIC || !GetWorld()) return false;
 
-	SetSpeedImmediate(WanderSpeed);
+	SetSpeedImmediate(GetTuning().WanderSpeed);
 
 	if (IsInsideSafeZone2D())
 	{
 		AIC->StopMovement();
 
-		CurrentMode = ENPCMode::Wander;
+		SetMode(ENPCMode::Wander);
 		ClearLoseInterestTimer();
-		ResetReturnHomeCache();
+		State.Reset();
 
 		const float Now = GetWorld()->GetTimeSeconds();
-		NextWanderAllowedTime = Now + FMath::FRandRange(WanderWaitMin, WanderWaitMax);
+		NextWanderAllowedTime = Now + FMath::FRandRange(GetTuning().WanderWaitMin, GetTuning().WanderWaitMax);
 
 		bWasMovingLastTick = false;
-		return;
+		return true;
 	}
 
 	const float Now = GetWorld()->GetTimeSeconds();
 	const float RePickCooldown = 0.75f;
 
-	if (!bHasReturnTarget || (Now - LastReturnTargetPickTime) > RePickCooldown)
+	if (!State.bHasTarget || (Now - State.LastPickTime) > RePickCooldown)
 	{
 		bool bGot = false;
 
 		if (IsValid(SafeZone))
 		{
-			const float RadiusToUse = FMath::Min(SafeZone->GetZoneRadius(), FMath::Max(200.0f, WanderRadius));
-			bGot = SafeZone->GetRandomReachablePointInZone(CachedReturnTarget, RadiusToUse);
+			const float RadiusToUse = FMath::Min(SafeZone->GetZoneRadius(), FMath::Max(200.0f, GetTuning().WanderRadius));
+			bGot = SafeZone->TakeReachablePoint(State.Target, RadiusToUse);
 		}
 
 		if (!bGot)
@@ -1433,9 +2274,10 @@ void ANPCCharacter::ReturnHome(AAIController* AIC)
 			if (UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld()))
 			{
 				FNavLocation NavLoc;
-				if (NavSys->GetRandomReachablePointInRadius(HomeLocation, WanderRadius, NavLoc))
+				CPPTESTS_COUNT(STAT_CPPTests_NavQueries, NavQueries, 1);
+				if (NavSys->GetRandomReachablePointInRadius(HomeLocation, GetTuning().WanderRadius, NavLoc))
 				{
-					CachedReturnTarget = NavLoc.Location;
+					State.Target = NavLoc.Location;
 					bGot = true;
 				}
 			}
@@ -1443,26 +2285,29 @@ void ANPCCharacter::ReturnHome(AAIController* AIC)
 
 		if (bGot)
 		{
-			bHasReturnTarget = true;
-			LastReturnTargetPickTime = Now;
+			State.bHasTarget = true;
+			State.LastPickTime = Now;
 		}
 	}
 
-	if (bHasReturnTarget && !IsAIMoving(AIC))
+	if (State.bHasTarget && !IsAIMoving(AIC))
 	{
-		AIC->MoveToLocation(CachedReturnTarget, ReturnHomeAcceptanceRadius);
+		MoveToLocationCached(AIC, State.Target, GetTuning().ReturnHomeAcceptanceRadius);
 	}
 
-	if (bHasReturnTarget && !IsAIMoving(AIC))
+	if (State.bHasTarget && !IsAIMoving(AIC))
 	{
-		const float DistToTarget = FVector::Dist2D(GetActorLocation(), CachedReturnTarget);
-		if (DistToTarget <= FMath::Max(ReturnHomeAcceptanceRadius * 2.0f, 200.0f))
+		const float DistToTarget = FVector::Dist2D(GetActorLocation(), State.Target);
+		if (DistToTarget <= FMath::Max(GetTuning().ReturnHomeAcceptanceRadius * 2.0f, 200.0f))
 		{
-			CurrentMode = ENPCMode::Wander;
-			ResetReturnHomeCache();
-			NextWanderAllowedTime = Now + FMath::FRandRange(WanderWaitMin, WanderWaitMax);
+			SetMode(ENPCMode::Wander);
+			State.Reset();
+			NextWanderAllowedTime = Now + FMath::FRandRange(GetTuning().WanderWaitMin, GetTuning().WanderWaitMax);
+			return true;
 		}
 	}
+
+	return false;
 }
 
 void ANPCCharacter::Wander(AAIController* AIC)
@@ -1477,10 +2322,14 @@ void ANPCCharacter::Wander(AAIController* AIC)
 	FVector Dest = FVector::ZeroVector;
 	bool bHasDest = false;
 
+	// Wander points inside a hazard are thrown away (one grid lookup each)
+	const UHazardSubsystem* Hazards = GetWorld()->GetSubsystem<UHazardSubsystem>();
+
 	if (IsValid(SafeZone))
 	{
-		const float RadiusToUse = FMath::Min(WanderRadius, SafeZone->GetZoneRadius());
-		bHasDest = SafeZone->GetRandomReachablePointInZone(Dest, RadiusToUse);
+		const float RadiusToUse = FMath::Min(GetTuning().WanderRadius, SafeZone->GetZoneRadius());
+		bHasDest = SafeZone->TakeReachablePoint(Dest, RadiusToUse);
+		bHasDest = bHasDest && !(Hazards && Hazards->IsLocationHazardous(Dest));
 	}
 
 	if (!bHasDest)
@@ -1488,10 +2337,11 @@ void ANPCCharacter::Wander(AAIController* AIC)
 		if (UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld()))
 		{
 			FNavLocation NavLoc;
-			if (NavSys->GetRandomReachablePointInRadius(HomeLocation, WanderRadius, NavLoc))
+			CPPTESTS_COUNT(STAT_CPPTests_NavQueries, NavQueries, 1);
+			if (NavSys->GetRandomReachablePointInRadius(HomeLocation, GetTuning().WanderRadius, NavLoc))
 			{
 				Dest = NavLoc.Location;
-				bHasDest = true;
+				bHasDest = !(Hazards && Hazards->IsLocationHazardous(Dest));
 			}
 		}
 	}
@@ -1502,8 +2352,8 @@ void ANPCCharacter::Wander(AAIController* AIC)
 		return;
 	}
 
-	StartSpeedRampTo(WanderSpeed, WanderRampSeconds, true);
-	AIC->MoveToLocation(Dest, WanderAcceptanceRadius);
+	StartSpeedRampTo(GetTuning().WanderSpeed, GetTuning().WanderRampSeconds, true);
+	MoveToLocationCached(AIC, Dest, GetTuning().WanderAcceptanceRadius);
 }
 
 // -------------------------
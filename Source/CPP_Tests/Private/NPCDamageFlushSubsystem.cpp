@@ -0,0 +1,63 @@
+#include "NPCDamageFlushSubsystem.h"
+
+#include "Engine/World.h"
+#include "NPCCharacter.h"
+
+void UNPCDamageFlushSubsystem::Deinitialize()
+{
+	Pending.Reset();
+	Flushing.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UNPCDamageFlushSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UNPCDamageFlushSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNPCDamageFlushSubsystem, STATGROUP_Tickables);
+}
+
+void UNPCDamageFlushSubsystem::QueueFlush(ANPCCharacter* NPC)
+{
+	if (IsValid(NPC))
+	{
+		Pending.Add(NPC);
+	}
+}
+
+void UNPCDamageFlushSubsystem::Tick(float DeltaTime)
+{
+	if (Pending.Num() == 0)
+	{
+		TimeUntilFlush = 0.0f;
+		return;
+	}
+
+	TimeUntilFlush -= DeltaTime;
+	if (TimeUntilFlush > 0.0f)
+	{
+		return;
+	}
+	TimeUntilFlush = FlushInterval;
+
+	FlushAll();
+}
+
+void UNPCDamageFlushSubsystem::FlushAll()
+{
+	// Swap out first: delegates fired during the flush may damage NPCs again and queue them for next time
+	Flushing.Reset();
+	Swap(Flushing, Pending);
+
+	for (const TWeakObjectPtr<ANPCCharacter>& WeakNPC : Flushing)
+	{
+		if (ANPCCharacter* NPC = WeakNPC.Get())
+		{
+			NPC->FlushPendingDamage();
+		}
+	}
+}
@@ -0,0 +1,6 @@
+#include "NPCGameplayTags.h"
+
+namespace NPCTags
+{
+	UE_DEFINE_GAMEPLAY_TAG_COMMENT(Event_PlayerNoticed, "NPC.Event.PlayerNoticed", "Player entered the NPC's notice cone while it was calm");
+}
@@ -0,0 +1,250 @@
+#include "NPCHealthBarSubsystem.h"
+
+#include "CPP_TestsStats.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+#include "NPCCharacter.h"
+#include "NPCHealthBarWidget.h"
+#include "SceneView.h"
+
+void UNPCHealthBarSubsystem::Deinitialize()
+{
+	for (FNPCHealthBarSlot& Slot : Active)
+	{
+		if (Slot.Widget)
+		{
+			Slot.Widget->RemoveFromParent();
+		}
+	}
+	Active.Reset();
+
+	for (TPair<TObjectPtr<UClass>, FNPCHealthBarWidgetList>& Pair : FreeWidgets)
+	{
+		for (UNPCHealthBarWidget* Widget : Pair.Value.Widgets)
+		{
+			if (Widget)
+			{
+				Widget->RemoveFromParent();
+			}
+		}
+	}
+	FreeWidgets.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UNPCHealthBarSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UNPCHealthBarSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNPCHealthBarSubsystem, STATGROUP_Tickables);
+}
+
+int32 UNPCHealthBarSubsystem::FindSlot(const ANPCCharacter* NPC) const
+{
+	return Active.IndexOfByPredicate([NPC](const FNPCHealthBarSlot& Slot) { return Slot.NPC.Get() == NPC; });
+}
+
+bool UNPCHealthBarSubsystem::IsBarShown(const ANPCCharacter* NPC) const
+{
+	return FindSlot(NPC) != INDEX_NONE;
+}
+
+void UNPCHealthBarSubsystem::ShowBar(ANPCCharacter* NPC, float Percent)
+{
+	UWorld* World = GetWorld();
+	if (!World || !IsValid(NPC) || !NPC->GetTuning().HealthBarWidgetClass)
+	{
+		return;
+	}
+
+	int32 Index = FindSlot(NPC);
+	if (Index == INDEX_NONE)
+	{
+		Index = Active.AddDefaulted();
+		Active[Index].NPC = NPC;
+	}
+
+	FNPCHealthBarSlot& Slot = Active[Index];
+	Slot.Percent = FMath::Clamp(Percent, 0.0f, 1.0f);
+	Slot.HideTime = World->GetTimeSeconds() + NPC->GetTuning().HealthBarHideDelaySeconds;
+	Slot.bFading = false;
+
+	// Widget (if it's on screen) is updated right away; otherwise next Tick picks one up
+	if (Slot.Widget)
+	{
+		Slot.Widget->SetHealthPercent(Slot.Percent);
+		Slot.Widget->ShowInstant();
+	}
+}
+
+void UNPCHealthBarSubsystem::HideBar(ANPCCharacter* NPC)
+{
+	const int32 Index = FindSlot(NPC);
+	if (Index != INDEX_NONE)
+	{
+		ReleaseWidget(Active[Index]);
+		Active.RemoveAtSwap(Index, EAllowShrinking::No);
+	}
+}
+
+UNPCHealthBarWidget* UNPCHealthBarSubsystem::AcquireWidget(const ANPCCharacter* NPC)
+{
+	UClass* WidgetClass = NPC->GetTuning().HealthBarWidgetClass;
+	if (!WidgetClass)
+	{
+		return nullptr;
+	}
+
+	if (FNPCHealthBarWidgetList* List = FreeWidgets.Find(WidgetClass))
+	{
+		while (List->Widgets.Num() > 0)
+		{
+			UNPCHealthBarWidget* Widget = List->Widgets.Pop(EAllowShrinking::No);
+			if (Widget)
+			{
+				return Widget;
+			}
+		}
+	}
+
+	APlayerController* PC = UGameplayStatics::GetPlayerController(GetWorld(), 0);
+	if (!PC)
+	{
+		return nullptr;
+	}
+
+	LLM_SCOPE_BYTAG(CPPTests_NPCWidgets);
+
+	UNPCHealthBarWidget* Widget = CreateWidget<UNPCHealthBarWidget>(PC, WidgetClass);
+	if (!Widget)
+	{
+		return nullptr;
+	}
+	CPPTESTS_COUNT(STAT_CPPTests_WidgetsCreated, WidgetsCreated, 1);
+
+	Widget->SetAlignmentInViewport(FVector2D(0.5f, 1.0f));
+	Widget->AddToViewport(ViewportZOrder);
+	return Widget;
+}
+
+void UNPCHealthBarSubsystem::ReleaseWidget(FNPCHealthBarSlot& Slot)
+{
+	UNPCHealthBarWidget* Widget = Slot.Widget;
+	Slot.Widget = nullptr;
+
+	if (!Widget)
+	{
+		return;
+	}
+
+	FNPCHealthBarWidgetList& List = FreeWidgets.FindOrAdd(Widget->GetClass());
+	if (List.Widgets.Num() >= MaxPooledWidgets)
+	{
+		Widget->RemoveFromParent();
+		return;
+	}
+
+	// Stays in the viewport so reuse doesn't pay for AddToViewport again
+	Widget->SetRenderOpacity(0.0f);
+	Widget->SetVisibility(ESlateVisibility::Hidden);
+	List.Widgets.Add(Widget);
+}
+
+void UNPCHealthBarSubsystem::Tick(float DeltaTime)
+{
+	if (Active.Num() == 0)
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	APlayerController* PC = World ? UGameplayStatics::GetPlayerController(World, 0) : nullptr;
+	ULocalPlayer* LP = PC ? PC->GetLocalPlayer() : nullptr;
+
+	// One view-projection for the whole batch instead of a full projection setup per bar
+	FSceneViewProjectionData ProjectionData;
+	const bool bHasView = LP && LP->ViewportClient && LP->GetProjectionData(LP->ViewportClient->Viewport, ProjectionData);
+	const FMatrix ViewProjection = bHasView ? ProjectionData.ComputeViewProjectionMatrix() : FMatrix::Identity;
+	const FIntRect ViewRect = bHasView ? ProjectionData.GetConstrainedViewRect() : FIntRect();
+
+	const float Now = World->GetTimeSeconds();
+	int32 NumVisible = 0;
+
+	for (int32 i = Active.Num() - 1; i >= 0; --i)
+	{
+		FNPCHealthBarSlot& Slot = Active[i];
+		ANPCCharacter* NPC = Slot.NPC.Get();
+
+		if (!NPC || NPC->IsDead() || NPC->IsInPool())
+		{
+			ReleaseWidget(Slot);
+			Active.RemoveAtSwap(i, EAllowShrinking::No);
+			continue;
+		}
+
+		if (Slot.bFading)
+		{
+			// Widget hides itself when its fade animation ends
+			if (!Slot.Widget || Slot.Widget->GetVisibility() == ESlateVisibility::Hidden)
+			{
+				ReleaseWidget(Slot);
+				Active.RemoveAtSwap(i, EAllowShrinking::No);
+				continue;
+			}
+		}
+		else if (Now >= Slot.HideTime)
+		{
+			if (!Slot.Widget)
+			{
+				Active.RemoveAtSwap(i, EAllowShrinking::No);
+				continue;
+			}
+
+			Slot.Widget->PlayFadeOut();
+			Slot.bFading = true;
+		}
+
+		FVector2D ScreenPos;
+		const FVector WorldPos = NPC->GetActorTransform().TransformPosition(NPC->GetTuning().HealthBarWorldOffset);
+		const bool bOnScreen =
+			bHasView &&
+			NumVisible < MaxVisibleBars &&
+			FSceneView::ProjectWorldToScreen(WorldPos, ViewRect, ViewProjection, ScreenPos) &&
+			ScreenPos.X >= ViewRect.Min.X && ScreenPos.X <= ViewRect.Max.X &&
+			ScreenPos.Y >= ViewRect.Min.Y && ScreenPos.Y <= ViewRect.Max.Y;
+
+		if (!bOnScreen)
+		{
+			ReleaseWidget(Slot);
+			continue;
+		}
+
+		if (!Slot.Widget)
+		{
+			// Not worth bringing a bar back just to fade it
+			if (Slot.bFading)
+			{
+				continue;
+			}
+
+			Slot.Widget = AcquireWidget(NPC);
+			if (!Slot.Widget)
+			{
+				continue;
+			}
+
+			Slot.Widget->SetHealthPercent(Slot.Percent);
+			Slot.Widget->ShowInstant();
+		}
+
+		Slot.Widget->SetPositionInViewport(ScreenPos - FVector2D(ViewRect.Min), /*bRemoveDPIScale=*/true);
+		++NumVisible;
+	}
+}
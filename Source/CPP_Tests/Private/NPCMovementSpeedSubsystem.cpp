@@ -0,0 +1,117 @@
+#include "NPCMovementSpeedSubsystem.h"
+
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "NPCCharacter.h"
+
+void UNPCMovementSpeedSubsystem::Deinitialize()
+{
+	NPCs.Reset();
+	Movers.Reset();
+	StartTimes.Reset();
+	InvDurations.Reset();
+	StartSpeeds.Reset();
+	BaseTargets.Reset();
+	SlotOf.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UNPCMovementSpeedSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UNPCMovementSpeedSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNPCMovementSpeedSubsystem, STATGROUP_Tickables);
+}
+
+void UNPCMovementSpeedSubsystem::StartRamp(ANPCCharacter* NPC, float BaseTargetSpeed, float DurationSeconds, bool bFromZero)
+{
+	UWorld* World = GetWorld();
+	UCharacterMovementComponent* MoveComp = NPC ? NPC->GetCharacterMovement() : nullptr;
+	if (!World || !MoveComp)
+	{
+		return;
+	}
+
+	const float StartSpeed = bFromZero ? 0.0f : MoveComp->MaxWalkSpeed;
+	MoveComp->MaxWalkSpeed = StartSpeed;
+
+	int32 Index = INDEX_NONE;
+	if (const int32* Existing = SlotOf.Find(NPC))
+	{
+		Index = *Existing;
+	}
+	else
+	{
+		Index = NPCs.Add(NPC);
+		Movers.Add(MoveComp);
+		StartTimes.AddUninitialized();
+		InvDurations.AddUninitialized();
+		StartSpeeds.AddUninitialized();
+		BaseTargets.AddUninitialized();
+		SlotOf.Add(NPC, Index);
+	}
+
+	StartTimes[Index] = World->GetTimeSeconds();
+	InvDurations[Index] = 1.0f / FMath::Max(DurationSeconds, KINDA_SMALL_NUMBER);
+	StartSpeeds[Index] = StartSpeed;
+	BaseTargets[Index] = BaseTargetSpeed;
+}
+
+void UNPCMovementSpeedSubsystem::CancelRamp(const ANPCCharacter* NPC)
+{
+	if (const int32* Index = SlotOf.Find(NPC))
+	{
+		RemoveAtSwap(*Index);
+	}
+}
+
+void UNPCMovementSpeedSubsystem::RemoveAtSwap(int32 Index)
+{
+	const int32 Last = NPCs.Num() - 1;
+
+	SlotOf.Remove(NPCs[Index]);
+	if (Index != Last)
+	{
+		SlotOf.Add(NPCs[Last], Index);
+	}
+
+	NPCs.RemoveAtSwap(Index, EAllowShrinking::No);
+	Movers.RemoveAtSwap(Index, EAllowShrinking::No);
+	StartTimes.RemoveAtSwap(Index, EAllowShrinking::No);
+	InvDurations.RemoveAtSwap(Index, EAllowShrinking::No);
+	StartSpeeds.RemoveAtSwap(Index, EAllowShrinking::No);
+	BaseTargets.RemoveAtSwap(Index, EAllowShrinking::No);
+}
+
+void UNPCMovementSpeedSubsystem::Tick(float DeltaTime)
+{
+	if (NPCs.Num() == 0)
+	{
+		return;
+	}
+
+	const float Now = GetWorld()->GetTimeSeconds();
+
+	for (int32 i = NPCs.Num() - 1; i >= 0; --i)
+	{
+		const ANPCCharacter* NPC = NPCs[i].Get();
+		UCharacterMovementComponent* MoveComp = Movers[i].Get();
+		if (!NPC || !MoveComp)
+		{
+			RemoveAtSwap(i);
+			continue;
+		}
+
+		const float Alpha = FMath::Clamp((Now - StartTimes[i]) * InvDurations[i], 0.0f, 1.0f);
+		MoveComp->MaxWalkSpeed = FMath::Lerp(StartSpeeds[i], BaseTargets[i] * NPC->GetLowHealthMoveMultiplier(), Alpha);
+
+		if (Alpha >= 1.0f)
+		{
+			RemoveAtSwap(i);
+		}
+	}
+}
@@ -0,0 +1,569 @@
+#include "NPCNavFieldSubsystem.h"
+
+#include "CPP_TestsStats.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "Kismet/GameplayStatics.h"
+#include "NavigationSystem.h"
+
+namespace
+{
+	const FIntPoint NeighbourOffsets[8] =
+	{
+		FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1),
+		FIntPoint(1, 1), FIntPoint(1, -1), FIntPoint(-1, 1), FIntPoint(-1, -1)
+	};
+
+	struct FFieldOpenNodeLess
+	{
+		template <typename NodeType>
+		bool operator()(const NodeType& A, const NodeType& B) const
+		{
+			return A.Cost < B.Cost;
+		}
+	};
+}
+
+void UNPCNavFieldSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	HalfExtentCells = FMath::Max(1, HalfExtentCells);
+	CellSize = FMath::Max(25.0f, CellSize);
+
+	NavDirtyHandle = UNavigationSystemV1::NavigationDirtyEvent.AddUObject(this, &UNPCNavFieldSubsystem::HandleNavigationDirty);
+}
+
+void UNPCNavFieldSubsystem::Deinitialize()
+{
+	if (NavDirtyHandle.IsValid())
+	{
+		UNavigationSystemV1::NavigationDirtyEvent.Remove(NavDirtyHandle);
+		NavDirtyHandle.Reset();
+	}
+
+	WalkableCache.Reset();
+	PendingProjection.Reset();
+	Cost.Reset();
+	RepairOpen.Reset();
+	BuildCost.Reset();
+	BuildOpen.Reset();
+	bBuilding = false;
+	bFieldValid = false;
+
+	Super::Deinitialize();
+}
+
+bool UNPCNavFieldSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UNPCNavFieldSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNPCNavFieldSubsystem, STATGROUP_Tickables);
+}
+
+void UNPCNavFieldSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	UWorld* World = GetWorld();
+	if (!World) return;
+
+	const float Now = World->GetTimeSeconds();
+
+	// Nobody reacting -> don't pay for it. Next query after this rebuilds from scratch.
+	if (Now - LastQueryTime > IdleTimeoutSeconds)
+	{
+		bFieldValid = false;
+		bBuilding = false;
+		BuildOpen.Reset();
+		PlayerCell = FIntPoint(MAX_int32, MAX_int32);
+		return;
+	}
+
+	APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(World, 0);
+	if (!PlayerPawn)
+	{
+		bFieldValid = false;
+		return;
+	}
+
+	const FIntPoint NewPlayerCell = WorldToCell(PlayerPawn->GetActorLocation());
+	if (NewPlayerCell != PlayerCell)
+	{
+		MoveWindowTo(NewPlayerCell);
+	}
+
+	ProjectPendingCells();
+
+	// One rebuild at a time; if the player moved on meanwhile, the next one picks up the new cell
+	if (!bBuilding && bFieldDirty && (Now - LastRebuildTime) >= MinRebuildInterval)
+	{
+		StartRebuild();
+		LastRebuildTime = Now;
+	}
+
+	if (bBuilding && ExpandField(BuildCost, BuildMin, BuildOpen, FMath::Max(1, ExpansionBudgetPerTick)))
+	{
+		FinishRebuild();
+	}
+}
+
+FIntPoint UNPCNavFieldSubsystem::WorldToCell(const FVector& Location) const
+{
+	return FIntPoint(
+		FMath::FloorToInt(Location.X / CellSize),
+		FMath::FloorToInt(Location.Y / CellSize)
+	);
+}
+
+FVector UNPCNavFieldSubsystem::CellToWorld(const FIntPoint& Cell) const
+{
+	const FNavFieldCell* Data = WalkableCache.Find(Cell);
+
+	return FVector(
+		(Cell.X + 0.5f) * CellSize,
+		(Cell.Y + 0.5f) * CellSize,
+		Data ? Data->Z : 0.0f
+	);
+}
+
+int32 UNPCNavFieldSubsystem::CellToIndex(const FIntPoint& Cell, const FIntPoint& Min) const
+{
+	const int32 Width = GetWindowWidth();
+	const int32 LocalX = Cell.X - Min.X;
+	const int32 LocalY = Cell.Y - Min.Y;
+
+	if (LocalX < 0 || LocalY < 0 || LocalX >= Width || LocalY >= Width)
+	{
+		return INDEX_NONE;
+	}
+
+	return LocalY * Width + LocalX;
+}
+
+FIntPoint UNPCNavFieldSubsystem::IndexToCell(int32 Index, const FIntPoint& Min) const
+{
+	const int32 Width = GetWindowWidth();
+	return FIntPoint(Min.X + Index % Width, Min.Y + Index / Width);
+}
+
+const UNPCNavFieldSubsystem::FNavFieldCell* UNPCNavFieldSubsystem::FindWalkableCell(const FIntPoint& Cell) const
+{
+	const FNavFieldCell* Data = WalkableCache.Find(Cell);
+	return (Data && Data->bWalkable) ? Data : nullptr;
+}
+
+bool UNPCNavFieldSubsystem::CanStep(const FIntPoint& From, const FIntPoint& To) const
+{
+	const FNavFieldCell* A = FindWalkableCell(From);
+	const FNavFieldCell* B = FindWalkableCell(To);
+	if (!A || !B)
+	{
+		return false;
+	}
+
+	if (FMath::Abs(A->Z - B->Z) > MaxStepHeight)
+	{
+		return false;
+	}
+
+	// No corner cutting on diagonals
+	if (From.X != To.X && From.Y != To.Y)
+	{
+		if (!FindWalkableCell(FIntPoint(To.X, From.Y)) || !FindWalkableCell(FIntPoint(From.X, To.Y)))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void UNPCNavFieldSubsystem::MoveWindowTo(const FIntPoint& NewPlayerCell)
+{
+	LLM_SCOPE_BYTAG(CPPTests_NPCNav);
+
+	PlayerCell = NewPlayerCell;
+	WindowMin = FIntPoint(NewPlayerCell.X - HalfExtentCells, NewPlayerCell.Y - HalfExtentCells);
+
+	// Only cells we've never seen need a navmesh projection
+	PendingProjection.Reset();
+
+	const int32 Width = GetWindowWidth();
+	for (int32 Y = 0; Y < Width; ++Y)
+	{
+		for (int32 X = 0; X < Width; ++X)
+		{
+			const FIntPoint Cell(WindowMin.X + X, WindowMin.Y + Y);
+			if (!WalkableCache.Contains(Cell))
+			{
+				PendingProjection.Add(Cell);
+			}
+		}
+	}
+
+	// Project outward from the player so nearby cells become usable first
+	PendingProjection.Sort([NewPlayerCell](const FIntPoint& A, const FIntPoint& B)
+	{
+		return (A - NewPlayerCell).SizeSquared() > (B - NewPlayerCell).SizeSquared();
+	});
+
+	PruneWalkableCache();
+
+	bFieldDirty = true;
+}
+
+void UNPCNavFieldSubsystem::ProjectPendingCells()
+{
+	LLM_SCOPE_BYTAG(CPPTests_NPCNav);
+
+	if (PendingProjection.Num() == 0)
+	{
+		return;
+	}
+
+	UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld());
+	if (!NavSys || NavSys->IsNavigationBuildInProgress())
+	{
+		return;
+	}
+
+	APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+	const float ProbeZ = PlayerPawn ? PlayerPawn->GetActorLocation().Z : 0.0f;
+	const FVector Extent(CellSize * 0.5f, CellSize * 0.5f, 500.0f);
+
+	int32 Budget = FMath::Max(1, ProjectionBudgetPerTick);
+	while (Budget-- > 0 && PendingProjection.Num() > 0)
+	{
+		// Sorted far-to-near, so popping takes the nearest cell
+		const FIntPoint Cell = PendingProjection.Pop(EAllowShrinking::No);
+
+		const FVector Probe((Cell.X + 0.5f) * CellSize, (Cell.Y + 0.5f) * CellSize, ProbeZ);
+
+		FNavFieldCell Data;
+		FNavLocation NavLoc;
+		CPPTESTS_COUNT(STAT_CPPTests_NavQueries, NavQueries, 1);
+		if (NavSys->ProjectPointToNavigation(Probe, NavLoc, Extent))
+		{
+			Data.bWalkable = true;
+			Data.Z = NavLoc.Location.Z;
+		}
+
+		WalkableCache.Add(Cell, Data);
+
+		if (Data.bWalkable)
+		{
+			PatchWalkableCell(Cell);
+		}
+	}
+}
+
+void UNPCNavFieldSubsystem::StartRebuild()
+{
+	LLM_SCOPE_BYTAG(CPPTests_NPCNav);
+
+	// Player may be mid-jump or on a prop; seed from the nearest walkable cell.
+	// No seed -> keep serving the old field and try again next interval.
+	FIntPoint Seed = PlayerCell;
+	if (!FindWalkableCell(Seed))
+	{
+		bool bFoundSeed = false;
+		for (const FIntPoint& Offset : NeighbourOffsets)
+		{
+			if (FindWalkableCell(PlayerCell + Offset))
+			{
+				Seed = PlayerCell + Offset;
+				bFoundSeed = true;
+				break;
+			}
+		}
+
+		if (!bFoundSeed)
+		{
+			return;
+		}
+	}
+
+	bFieldDirty = false;
+
+	const int32 Width = GetWindowWidth();
+	const int32 NumCells = Width * Width;
+
+	BuildMin = WindowMin;
+	BuildCost.SetNumUninitialized(NumCells);
+	for (float& C : BuildCost)
+	{
+		C = MAX_flt;
+	}
+
+	BuildOpen.Reset();
+	BuildOpen.Reserve(NumCells / 4);
+
+	const int32 SeedIndex = CellToIndex(Seed, BuildMin);
+	BuildCost[SeedIndex] = 0.0f;
+	BuildOpen.HeapPush({ 0.0f, SeedIndex }, FFieldOpenNodeLess());
+
+	bBuilding = true;
+}
+
+void UNPCNavFieldSubsystem::FinishRebuild()
+{
+	Swap(Cost, BuildCost);
+	FieldMin = BuildMin;
+	RepairOpen.Reset();
+
+	bBuilding = false;
+	bFieldValid = true;
+}
+
+void UNPCNavFieldSubsystem::PatchWalkableCell(const FIntPoint& Cell)
+{
+	// A newly walkable cell can only lower costs, so pull it (and any diagonal it unblocks) off its
+	// neighbours and let the decrease spread; the finished field is fixed up right away, the one in
+	// flight picks it up as it expands
+	for (int32 i = -1; i < int32(UE_ARRAY_COUNT(NeighbourOffsets)); ++i)
+	{
+		const FIntPoint Target = (i < 0) ? Cell : Cell + NeighbourOffsets[i];
+
+		if (bFieldValid)
+		{
+			RelaxInto(Cost, FieldMin, RepairOpen, Target);
+		}
+		if (bBuilding)
+		{
+			RelaxInto(BuildCost, BuildMin, BuildOpen, Target);
+		}
+	}
+
+	if (bFieldValid)
+	{
+		ExpandField(Cost, FieldMin, RepairOpen, MAX_int32);
+	}
+}
+
+void UNPCNavFieldSubsystem::RelaxInto(TArray<float>& Costs, const FIntPoint& Min, TArray<FFieldOpenNode>& Open, const FIntPoint& Cell)
+{
+	const int32 Index = CellToIndex(Cell, Min);
+	if (Index == INDEX_NONE || !FindWalkableCell(Cell))
+	{
+		return;
+	}
+
+	float Best = Costs[Index];
+	for (const FIntPoint& Offset : NeighbourOffsets)
+	{
+		const FIntPoint From = Cell + Offset;
+		const int32 FromIndex = CellToIndex(From, Min);
+		if (FromIndex == INDEX_NONE || Costs[FromIndex] == MAX_flt || !CanStep(From, Cell))
+		{
+			continue;
+		}
+
+		const float StepCost = (Offset.X != 0 && Offset.Y != 0) ? UE_SQRT_2 : 1.0f;
+		Best = FMath::Min(Best, Costs[FromIndex] + StepCost);
+	}
+
+	if (Best < Costs[Index])
+	{
+		Costs[Index] = Best;
+		Open.HeapPush({ Best, Index }, FFieldOpenNodeLess());
+	}
+}
+
+bool UNPCNavFieldSubsystem::ExpandField(TArray<float>& Costs, const FIntPoint& Min, TArray<FFieldOpenNode>& Open, int32 Budget)
+{
+	while (Open.Num() > 0 && Budget-- > 0)
+	{
+		FFieldOpenNode Node;
+		Open.HeapPop(Node, FFieldOpenNodeLess(), EAllowShrinking::No);
+
+		if (Node.Cost > Costs[Node.Index])
+		{
+			continue; // stale entry
+		}
+
+		const FIntPoint Cell = IndexToCell(Node.Index, Min);
+
+		for (const FIntPoint& Offset : NeighbourOffsets)
+		{
+			const FIntPoint Next = Cell + Offset;
+			const int32 NextIndex = CellToIndex(Next, Min);
+			if (NextIndex == INDEX_NONE || !CanStep(Cell, Next))
+			{
+				continue;
+			}
+
+			const float StepCost = (Offset.X != 0 && Offset.Y != 0) ? UE_SQRT_2 : 1.0f;
+			const float NewCost = Node.Cost + StepCost;
+
+			if (NewCost < Costs[NextIndex])
+			{
+				Costs[NextIndex] = NewCost;
+				Open.HeapPush({ NewCost, NextIndex }, FFieldOpenNodeLess());
+			}
+		}
+	}
+
+	return Open.Num() == 0;
+}
+
+void UNPCNavFieldSubsystem::PruneWalkableCache()
+{
+	// Keep a margin around the window so back-and-forth movement stays cheap
+	const int32 Width = GetWindowWidth();
+	if (WalkableCache.Num() <= Width * Width * 4)
+	{
+		return;
+	}
+
+	const int32 KeepRadius = HalfExtentCells * 2;
+	for (auto It = WalkableCache.CreateIterator(); It; ++It)
+	{
+		const FIntPoint Delta = It.Key() - PlayerCell;
+		if (FMath::Abs(Delta.X) > KeepRadius || FMath::Abs(Delta.Y) > KeepRadius)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UNPCNavFieldSubsystem::MarkQueried()
+{
+	if (UWorld* World = GetWorld())
+	{
+		LastQueryTime = World->GetTimeSeconds();
+	}
+}
+
+bool UNPCNavFieldSubsystem::GetChaseWaypoint(const FVector& From, FVector& OutWaypoint)
+{
+	MarkQueried();
+
+	if (!bFieldValid)
+	{
+		return false;
+	}
+
+	int32 Current = CellToIndex(WorldToCell(From), FieldMin);
+	if (Current == INDEX_NONE || Cost[Current] == MAX_flt)
+	{
+		return false;
+	}
+
+	for (int32 Step = 0; Step < ChaseLookaheadCells; ++Step)
+	{
+		const FIntPoint Cell = IndexToCell(Current, FieldMin);
+
+		int32 Best = INDEX_NONE;
+		float BestCost = Cost[Current];
+
+		for (const FIntPoint& Offset : NeighbourOffsets)
+		{
+			const int32 NextIndex = CellToIndex(Cell + Offset, FieldMin);
+			if (NextIndex != INDEX_NONE && Cost[NextIndex] < BestCost && CanStep(Cell, Cell + Offset))
+			{
+				Best = NextIndex;
+				BestCost = Cost[NextIndex];
+			}
+		}
+
+		if (Best == INDEX_NONE)
+		{
+			break;
+		}
+
+		Current = Best;
+
+		// Close enough that a direct move to the player is just as cheap and more precise
+		if (Cost[Current] <= 0.0f)
+		{
+			return false;
+		}
+	}
+
+	OutWaypoint = CellToWorld(IndexToCell(Current, FieldMin));
+	return true;
+}
+
+bool UNPCNavFieldSubsystem::GetFleeWaypoint(const FVector& From, float DesiredDistance, FVector& OutWaypoint)
+{
+	MarkQueried();
+
+	if (!bFieldValid)
+	{
+		return false;
+	}
+
+	const int32 Start = CellToIndex(WorldToCell(From), FieldMin);
+	if (Start == INDEX_NONE || Cost[Start] == MAX_flt)
+	{
+		return false;
+	}
+
+	const int32 MaxSteps = FMath::Clamp(FMath::CeilToInt(DesiredDistance / CellSize), 1, HalfExtentCells);
+
+	int32 Current = Start;
+	for (int32 Step = 0; Step < MaxSteps; ++Step)
+	{
+		const FIntPoint Cell = IndexToCell(Current, FieldMin);
+
+		int32 Best = INDEX_NONE;
+		float BestCost = Cost[Current];
+
+		for (const FIntPoint& Offset : NeighbourOffsets)
+		{
+			const int32 NextIndex = CellToIndex(Cell + Offset, FieldMin);
+			if (NextIndex != INDEX_NONE && Cost[NextIndex] != MAX_flt && Cost[NextIndex] > BestCost && CanStep(Cell, Cell + Offset))
+			{
+				Best = NextIndex;
+				BestCost = Cost[NextIndex];
+			}
+		}
+
+		if (Best == INDEX_NONE)
+		{
+			break; // cornered or at the window edge
+		}
+
+		Current = Best;
+	}
+
+	if (Current == Start)
+	{
+		return false;
+	}
+
+	OutWaypoint = CellToWorld(IndexToCell(Current, FieldMin));
+	return true;
+}
+
+void UNPCNavFieldSubsystem::HandleNavigationDirty(const FBox& DirtyBounds)
+{
+	const FIntPoint MinCell = WorldToCell(DirtyBounds.Min);
+	const FIntPoint MaxCell = WorldToCell(DirtyBounds.Max);
+
+	// Huge rebuilds (whole level) -> just start over
+	if (int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1) > int64(WalkableCache.Num()))
+	{
+		WalkableCache.Reset();
+	}
+	else
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+			{
+				WalkableCache.Remove(FIntPoint(X, Y));
+			}
+		}
+	}
+
+	// Re-queue whatever the window lost
+	if (PlayerCell.X != MAX_int32)
+	{
+		MoveWindowTo(PlayerCell);
+	}
+}
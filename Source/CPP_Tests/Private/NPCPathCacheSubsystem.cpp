@@ -0,0 +1,208 @@
+#include "NPCPathCacheSubsystem.h"
+
+#include "AIController.h"
+#include "CPP_TestsStats.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "NavigationData.h"
+#include "NavigationPath.h"
+#include "NavigationSystem.h"
+#include "Navigation/PathFollowingComponent.h"
+
+static FAutoConsoleCommandWithWorld GNPCPathCacheStatsCmd(
+	TEXT("NPC.PathCache.Stats"),
+	TEXT("Logs NPC path cache hit rate and pathfinding call counts for the current world."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UNPCPathCacheSubsystem* PathCache = World ? World->GetSubsystem<UNPCPathCacheSubsystem>() : nullptr)
+		{
+			PathCache->LogStats();
+		}
+	})
+);
+
+static FAutoConsoleCommandWithWorld GNPCPathCacheResetCmd(
+	TEXT("NPC.PathCache.Reset"),
+	TEXT("Clears the NPC path cache and its stats for the current world."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UNPCPathCacheSubsystem* PathCache = World ? World->GetSubsystem<UNPCPathCacheSubsystem>() : nullptr)
+		{
+			PathCache->ClearCache();
+			PathCache->ResetStats();
+		}
+	})
+);
+
+void UNPCPathCacheSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	LLM_SCOPE_BYTAG(CPPTests_NPCNav);
+	Super::Initialize(Collection);
+
+	Cache.Reserve(FMath::Max(0, MaxEntries));
+
+	NavDirtyHandle = UNavigationSystemV1::NavigationDirtyEvent.AddUObject(this, &UNPCPathCacheSubsystem::HandleNavigationDirty);
+}
+
+void UNPCPathCacheSubsystem::Deinitialize()
+{
+	if (NavDirtyHandle.IsValid())
+	{
+		UNavigationSystemV1::NavigationDirtyEvent.Remove(NavDirtyHandle);
+		NavDirtyHandle.Reset();
+	}
+
+	ClearCache();
+
+	Super::Deinitialize();
+}
+
+bool UNPCPathCacheSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UNPCPathCacheSubsystem::RequestCachedMove(AAIController* AIC, const FVector& Goal, float AcceptanceRadius)
+{
+	LLM_SCOPE_BYTAG(CPPTests_NPCNav);
+
+	UWorld* World = GetWorld();
+	APawn* Pawn = AIC ? AIC->GetPawn() : nullptr;
+	if (!World || !Pawn)
+	{
+		return false;
+	}
+
+	UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(World);
+	if (!NavSys)
+	{
+		return false;
+	}
+
+	const ANavigationData* NavData = NavSys->GetDefaultNavDataInstance();
+	if (!NavData)
+	{
+		return false;
+	}
+
+	FNavLocation StartLoc;
+	FNavLocation GoalLoc;
+	CPPTESTS_COUNT(STAT_CPPTests_NavQueries, NavQueries, 2);
+	if (!NavSys->ProjectPointToNavigation(Pawn->GetNavAgentLocation(), StartLoc)
+		|| !NavSys->ProjectPointToNavigation(Goal, GoalLoc))
+	{
+		return false;
+	}
+
+	++Stats.Queries;
+
+	const float Now = World->GetTimeSeconds();
+	const TPair<NavNodeRef, NavNodeRef> Key(StartLoc.NodeRef, GoalLoc.NodeRef);
+
+	TArray<FVector> Points;
+
+	FCachedPath* Entry = Cache.Find(Key);
+	if (Entry && (Now - Entry->CreatedTime) <= EntryTTLSeconds)
+	{
+		++Stats.Hits;
+		Points = Entry->Points;
+	}
+	else
+	{
+		++Stats.Misses;
+		++Stats.PathfindCalls;
+
+		FPathFindingQuery Query(AIC, *NavData, StartLoc.Location, GoalLoc.Location, NavData->GetDefaultQueryFilter());
+		CPPTESTS_COUNT(STAT_CPPTests_NavQueries, NavQueries, 1);
+		const FPathFindingResult Result = NavSys->FindPathSync(Query);
+		if (!Result.IsSuccessful() || !Result.Path.IsValid())
+		{
+			return false;
+		}
+
+		for (const FNavPathPoint& PathPoint : Result.Path->GetPathPoints())
+		{
+			Points.Add(PathPoint.Location);
+		}
+
+		// Partial paths are fine to follow once but not worth handing to the next NPC
+		if (!Result.IsPartial() && MaxEntries > 0)
+		{
+			if (!Entry && Cache.Num() >= MaxEntries)
+			{
+				EvictOldest();
+			}
+
+			FCachedPath& NewEntry = Cache.FindOrAdd(Key);
+			NewEntry.Points = Points;
+			NewEntry.Bounds = FBox(Points).ExpandBy(100.0f);
+			NewEntry.CreatedTime = Now;
+		}
+	}
+
+	if (Points.Num() < 2)
+	{
+		return false;
+	}
+
+	// Same corridor, our own endpoints
+	Points[0] = StartLoc.Location;
+	Points.Last() = GoalLoc.Location;
+
+	FNavPathSharedPtr Path = MakeShared<FNavigationPath, ESPMode::ThreadSafe>(Points);
+	Path->SetNavigationDataUsed(const_cast<ANavigationData*>(NavData));
+	Path->SetQuerier(AIC);
+
+	FAIMoveRequest MoveReq(GoalLoc.Location);
+	MoveReq.SetAcceptanceRadius(AcceptanceRadius);
+	MoveReq.SetUsePathfinding(true);
+	MoveReq.SetProjectGoalLocation(false);
+	MoveReq.SetNavigationFilter(AIC->GetDefaultNavigationFilterClass());
+
+	return AIC->RequestMove(MoveReq, Path).IsValid();
+}
+
+void UNPCPathCacheSubsystem::LogStats() const
+{
+	UE_LOG(LogTemp, Log, TEXT("NPC path cache: %d queries, %d hits, %d misses (%.1f%% hit), %d pathfind calls, %d evictions, %d entries"),
+		Stats.Queries, Stats.Hits, Stats.Misses, Stats.GetHitRate() * 100.0f, Stats.PathfindCalls, Stats.Evictions, Cache.Num());
+}
+
+void UNPCPathCacheSubsystem::ClearCache()
+{
+	Cache.Reset();
+}
+
+void UNPCPathCacheSubsystem::EvictOldest()
+{
+	const TPair<NavNodeRef, NavNodeRef>* OldestKey = nullptr;
+	float OldestTime = TNumericLimits<float>::Max();
+
+	for (const TPair<TPair<NavNodeRef, NavNodeRef>, FCachedPath>& It : Cache)
+	{
+		if (It.Value.CreatedTime < OldestTime)
+		{
+			OldestTime = It.Value.CreatedTime;
+			OldestKey = &It.Key;
+		}
+	}
+
+	if (OldestKey)
+	{
+		const TPair<NavNodeRef, NavNodeRef> KeyCopy = *OldestKey;
+		Cache.Remove(KeyCopy);
+		++Stats.Evictions;
+	}
+}
+
+void UNPCPathCacheSubsystem::HandleNavigationDirty(const FBox& DirtyBounds)
+{
+	// Poly refs can be reused after a tile rebuild, so anything touching the area goes
+	for (auto It = Cache.CreateIterator(); It; ++It)
+	{
+		if (It.Value().Bounds.Intersect(DirtyBounds))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
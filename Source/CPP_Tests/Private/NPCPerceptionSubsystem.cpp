@@ -0,0 +1,145 @@
+#include "NPCPerceptionSubsystem.h"
+
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "Kismet/GameplayStatics.h"
+#include "NPCCharacter.h"
+
+void UNPCPerceptionSubsystem::Deinitialize()
+{
+	Shells.Reset();
+	Cells.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UNPCPerceptionSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UNPCPerceptionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNPCPerceptionSubsystem, STATGROUP_Tickables);
+}
+
+FIntPoint UNPCPerceptionSubsystem::ToCell2D(const FVector2D& Location) const
+{
+	return FIntPoint(
+		FMath::FloorToInt(Location.X / CellSize),
+		FMath::FloorToInt(Location.Y / CellSize)
+	);
+}
+
+void UNPCPerceptionSubsystem::RegisterSleeper(ANPCCharacter* NPC, const FVector& Center, float Radius)
+{
+	if (!IsValid(NPC))
+	{
+		return;
+	}
+
+	UnregisterSleeper(NPC);
+
+	FSleeperShell Shell;
+	Shell.Center = FVector2D(Center);
+	Shell.Radius = FMath::Max(0.0f, Radius);
+	Shell.MinCell = ToCell2D(Shell.Center - FVector2D(Shell.Radius));
+	Shell.MaxCell = ToCell2D(Shell.Center + FVector2D(Shell.Radius));
+
+	const TWeakObjectPtr<ANPCCharacter> Key(NPC);
+
+	for (int32 Y = Shell.MinCell.Y; Y <= Shell.MaxCell.Y; ++Y)
+	{
+		for (int32 X = Shell.MinCell.X; X <= Shell.MaxCell.X; ++X)
+		{
+			Cells.FindOrAdd(FIntPoint(X, Y)).Add(Key);
+		}
+	}
+
+	Shells.Add(Key, Shell);
+}
+
+void UNPCPerceptionSubsystem::UnregisterSleeper(ANPCCharacter* NPC)
+{
+	RemoveSleeper(TWeakObjectPtr<ANPCCharacter>(NPC));
+}
+
+void UNPCPerceptionSubsystem::RemoveSleeper(const TWeakObjectPtr<ANPCCharacter>& NPC)
+{
+	FSleeperShell Shell;
+	if (!Shells.RemoveAndCopyValue(NPC, Shell))
+	{
+		return;
+	}
+
+	for (int32 Y = Shell.MinCell.Y; Y <= Shell.MaxCell.Y; ++Y)
+	{
+		for (int32 X = Shell.MinCell.X; X <= Shell.MaxCell.X; ++X)
+		{
+			const FIntPoint Cell(X, Y);
+			if (TArray<TWeakObjectPtr<ANPCCharacter>>* Bucket = Cells.Find(Cell))
+			{
+				Bucket->RemoveSwap(NPC);
+				if (Bucket->Num() == 0)
+				{
+					Cells.Remove(Cell);
+				}
+			}
+		}
+	}
+}
+
+void UNPCPerceptionSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Shells.Num() == 0)
+	{
+		return;
+	}
+
+	TimeUntilCheck -= DeltaTime;
+	if (TimeUntilCheck > 0.0f)
+	{
+		return;
+	}
+	TimeUntilCheck = CheckInterval;
+
+	APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+	if (!PlayerPawn)
+	{
+		return;
+	}
+
+	const FVector2D PlayerLoc(PlayerPawn->GetActorLocation());
+
+	const TArray<TWeakObjectPtr<ANPCCharacter>>* Bucket = Cells.Find(ToCell2D(PlayerLoc));
+	if (!Bucket)
+	{
+		return;
+	}
+
+	// Waking unregisters, which edits the bucket we're reading
+	TArray<TWeakObjectPtr<ANPCCharacter>, TInlineAllocator<16>> ToWake;
+
+	for (const TWeakObjectPtr<ANPCCharacter>& NPC : *Bucket)
+	{
+		const FSleeperShell* Shell = Shells.Find(NPC);
+		if (Shell && FVector2D::DistSquared(PlayerLoc, Shell->Center) <= FMath::Square(Shell->Radius))
+		{
+			ToWake.Add(NPC);
+		}
+	}
+
+	for (const TWeakObjectPtr<ANPCCharacter>& NPC : ToWake)
+	{
+		if (ANPCCharacter* Sleeper = NPC.Get())
+		{
+			Sleeper->WakeBrain();
+		}
+		else
+		{
+			RemoveSleeper(NPC);
+		}
+	}
+}
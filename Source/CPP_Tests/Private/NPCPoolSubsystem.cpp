@@ -0,0 +1,125 @@
+#include "NPCPoolSubsystem.h"
+
+#include "CPP_TestsStats.h"
+#include "Engine/World.h"
+#include "NPCCharacter.h"
+#include "NPCSafeZone.h"
+
+void UNPCPoolSubsystem::Deinitialize()
+{
+	Buckets.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UNPCPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+ANPCCharacter* UNPCPoolSubsystem::AcquireNPC(TSubclassOf<ANPCCharacter> NPCClass, const FTransform& SpawnTransform, ANPCSafeZone* Zone, UNPCArchetype* Archetype)
+{
+	return Acquire(NPCClass, SpawnTransform, Zone, Archetype, true);
+}
+
+ANPCCharacter* UNPCPoolSubsystem::AcquireNPCUnregistered(TSubclassOf<ANPCCharacter> NPCClass, const FTransform& SpawnTransform, ANPCSafeZone* Zone, UNPCArchetype* Archetype)
+{
+	return Acquire(NPCClass, SpawnTransform, Zone, Archetype, false);
+}
+
+ANPCCharacter* UNPCPoolSubsystem::Acquire(TSubclassOf<ANPCCharacter> NPCClass, const FTransform& SpawnTransform, ANPCSafeZone* Zone, UNPCArchetype* Archetype, bool bRegisterWithZone)
+{
+	if (!NPCClass)
+	{
+		return nullptr;
+	}
+
+	if (FNPCPoolBucket* Bucket = Buckets.Find(NPCClass.Get()))
+	{
+		while (Bucket->Dormant.Num() > 0)
+		{
+			ANPCCharacter* NPC = Bucket->Dormant.Pop(EAllowShrinking::No);
+			if (IsValid(NPC))
+			{
+				// Null puts back the class default in case the last user swapped it
+				NPC->SetArchetype(Archetype);
+				NPC->ReactivateFromPool(SpawnTransform, Zone, bRegisterWithZone);
+				return NPC;
+			}
+		}
+	}
+
+	return SpawnFresh(NPCClass, SpawnTransform, Zone, Archetype, bRegisterWithZone);
+}
+
+ANPCCharacter* UNPCPoolSubsystem::SpawnFresh(TSubclassOf<ANPCCharacter> NPCClass, const FTransform& SpawnTransform, ANPCSafeZone* Zone, UNPCArchetype* Archetype, bool bRegisterWithZone)
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	LLM_SCOPE_BYTAG(CPPTests_NPCs);
+
+	ANPCCharacter* NPC = World->SpawnActorDeferred<ANPCCharacter>(NPCClass, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+	if (!NPC)
+	{
+		return nullptr;
+	}
+
+	if (Archetype)
+	{
+		NPC->SetArchetype(Archetype);
+	}
+
+	// Before FinishSpawning so OnConstruction registers with the zone
+	if (IsValid(Zone))
+	{
+		NPC->SetSafeZone(Zone, bRegisterWithZone);
+	}
+
+	NPC->FinishSpawning(SpawnTransform);
+	return NPC;
+}
+
+void UNPCPoolSubsystem::ReleaseNPC(ANPCCharacter* NPC)
+{
+	if (!IsValid(NPC) || NPC->IsInPool())
+	{
+		return;
+	}
+
+	FNPCPoolBucket& Bucket = Buckets.FindOrAdd(NPC->GetClass());
+	if (Bucket.Dormant.Num() >= MaxDormantPerClass)
+	{
+		NPC->Destroy();
+		return;
+	}
+
+	NPC->DeactivateForPool();
+	Bucket.Dormant.Add(NPC);
+}
+
+void UNPCPoolSubsystem::PrewarmPool(TSubclassOf<ANPCCharacter> NPCClass, int32 Count)
+{
+	if (!NPCClass || Count <= 0)
+	{
+		return;
+	}
+
+	const int32 Missing = FMath::Min(Count, MaxDormantPerClass) - GetNumDormant(NPCClass);
+	for (int32 i = 0; i < Missing; ++i)
+	{
+		if (ANPCCharacter* NPC = SpawnFresh(NPCClass, FTransform::Identity, nullptr, nullptr, true))
+		{
+			ReleaseNPC(NPC);
+		}
+	}
+}
+
+int32 UNPCPoolSubsystem::GetNumDormant(TSubclassOf<ANPCCharacter> NPCClass) const
+{
+	const FNPCPoolBucket* Bucket = Buckets.Find(NPCClass.Get());
+	return Bucket ? Bucket->Dormant.Num() : 0;
+}
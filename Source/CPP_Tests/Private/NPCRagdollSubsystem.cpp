@@ -0,0 +1,165 @@
+#include "NPCRagdollSubsystem.h"
+
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "Kismet/GameplayStatics.h"
+#include "NPCCharacter.h"
+
+void UNPCRagdollSubsystem::Deinitialize()
+{
+	Active.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UNPCRagdollSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UNPCRagdollSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNPCRagdollSubsystem, STATGROUP_Tickables);
+}
+
+bool UNPCRagdollSubsystem::ShouldUseFullRagdoll(const ANPCCharacter* NPC) const
+{
+	if (!IsValid(NPC) || MaxSimulatingRagdolls <= 0)
+	{
+		return false;
+	}
+
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(NPC, 0);
+	if (!PlayerPawn)
+	{
+		return true;
+	}
+
+	return FVector::DistSquared(NPC->GetActorLocation(), PlayerPawn->GetActorLocation()) <= FMath::Square(FullRagdollDistance);
+}
+
+void UNPCRagdollSubsystem::AddRagdoll(ANPCCharacter* NPC)
+{
+	UWorld* World = GetWorld();
+	if (!World || !IsValid(NPC))
+	{
+		return;
+	}
+
+	RemoveRagdoll(NPC);
+
+	// Over budget: the oldest body that has (nearly) landed loses its simulation first
+	while (Active.Num() > 0 && Active.Num() >= MaxSimulatingRagdolls)
+	{
+		int32 EvictIndex = Active.IndexOfByPredicate([this](const FActiveRagdoll& Entry) { return CanFreezeInPlace(Entry.NPC.Get()); });
+		if (EvictIndex == INDEX_NONE)
+		{
+			EvictIndex = 0;
+		}
+
+		const TWeakObjectPtr<ANPCCharacter> Evicted = Active[EvictIndex].NPC;
+		Active.RemoveAt(EvictIndex, EAllowShrinking::No);
+
+		if (ANPCCharacter* EvictedNPC = Evicted.Get())
+		{
+			EndRagdollEarly(EvictedNPC);
+		}
+	}
+
+	FActiveRagdoll& Entry = Active.AddDefaulted_GetRef();
+	Entry.NPC = NPC;
+	Entry.StartTime = World->GetTimeSeconds();
+}
+
+bool UNPCRagdollSubsystem::CanFreezeInPlace(const ANPCCharacter* NPC) const
+{
+	const USkeletalMeshComponent* SkelMesh = NPC ? NPC->GetMesh() : nullptr;
+	if (!SkelMesh)
+	{
+		return true;
+	}
+
+	return !SkelMesh->RigidBodyIsAwake() || SkelMesh->GetPhysicsLinearVelocity().SizeSquared() <= FMath::Square(FreezeMaxSpeed);
+}
+
+void UNPCRagdollSubsystem::EndRagdollEarly(ANPCCharacter* NPC) const
+{
+	if (CanFreezeInPlace(NPC))
+	{
+		NPC->FreezeRagdoll();
+	}
+	else
+	{
+		NPC->AbandonRagdoll();
+	}
+}
+
+void UNPCRagdollSubsystem::RemoveRagdoll(ANPCCharacter* NPC)
+{
+	Active.RemoveAll([NPC](const FActiveRagdoll& Entry) { return Entry.NPC.Get() == NPC; });
+}
+
+void UNPCRagdollSubsystem::Tick(float DeltaTime)
+{
+	if (Active.Num() == 0)
+	{
+		return;
+	}
+
+	TimeUntilCheck -= DeltaTime;
+	if (TimeUntilCheck > 0.0f)
+	{
+		return;
+	}
+	TimeUntilCheck = CheckInterval;
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	const float Now = World->GetTimeSeconds();
+	const float SettleSpeedSq = FMath::Square(SettleSpeed);
+
+	for (int32 i = Active.Num() - 1; i >= 0; --i)
+	{
+		FActiveRagdoll& Entry = Active[i];
+		ANPCCharacter* NPC = Entry.NPC.Get();
+		USkeletalMeshComponent* SkelMesh = NPC ? NPC->GetMesh() : nullptr;
+
+		if (!SkelMesh || !SkelMesh->IsSimulatingPhysics())
+		{
+			Active.RemoveAt(i, EAllowShrinking::No);
+			continue;
+		}
+
+		if ((Now - Entry.StartTime) >= MaxSimulateSeconds)
+		{
+			Active.RemoveAt(i, EAllowShrinking::No);
+			EndRagdollEarly(NPC);
+			continue;
+		}
+
+		bool bFreeze = false;
+		if (SkelMesh->GetPhysicsLinearVelocity().SizeSquared() <= SettleSpeedSq)
+		{
+			if (Entry.SettledSince < 0.0f)
+			{
+				Entry.SettledSince = Now;
+			}
+			bFreeze = (Now - Entry.SettledSince) >= SettleHoldSeconds;
+		}
+		else
+		{
+			Entry.SettledSince = -1.0f;
+		}
+
+		if (bFreeze)
+		{
+			Active.RemoveAt(i, EAllowShrinking::No);
+			NPC->FreezeRagdoll();
+		}
+	}
+}
@@ -1,8 +1,10 @@
 #include "NPCSafeZone.h"
 
 #include "Components/SphereComponent.h"
+#include "CPP_TestsStats.h"
 #include "NPCCharacter.h"
 #include "NavigationSystem.h"
+#include "TimerManager.h"
 
 ANPCSafeZone::ANPCSafeZone()
 {
@@ -27,6 +29,43 @@ void ANPCSafeZone::OnConstruction(const FTransform& Transform)
 	}
 }
 
+void ANPCSafeZone::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (ReachablePointPoolSize <= 0)
+	{
+		return;
+	}
+
+	LLM_SCOPE_BYTAG(CPPTests_NPCNav);
+	PointPool.Reserve(ReachablePointPoolSize);
+
+	NavDirtyHandle = UNavigationSystemV1::NavigationDirtyEvent.AddUObject(this, &ANPCSafeZone::HandleNavigationDirty);
+
+	// First batch right away so early wanderers already hit the pool
+	if (BoundNPCs.Num() > 0)
+	{
+		RefillPointPool();
+	}
+
+	UpdateRefillTimer();
+}
+
+void ANPCSafeZone::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (NavDirtyHandle.IsValid())
+	{
+		UNavigationSystemV1::NavigationDirtyEvent.Remove(NavDirtyHandle);
+		NavDirtyHandle.Reset();
+	}
+
+	GetWorldTimerManager().ClearTimer(PoolRefillTimerHandle);
+	InvalidatePointPool();
+
+	Super::EndPlay(EndPlayReason);
+}
+
 FVector ANPCSafeZone::GetRandomPointInZone() const
 {
 	const FVector Center = GetActorLocation();
@@ -62,6 +101,7 @@ bool ANPCSafeZone::GetRandomReachablePointInZone(FVector& OutLocation, float Rad
 
 	// Preferred: navmesh reachable point around zone center
 	FNavLocation NavLoc;
+	CPPTESTS_COUNT(STAT_CPPTests_NavQueries, NavQueries, 1);
 	if (NavSys->GetRandomReachablePointInRadius(GetActorLocation(), RadiusToUse, NavLoc))
 	{
 		OutLocation = NavLoc.Location;
@@ -72,6 +112,7 @@ bool ANPCSafeZone::GetRandomReachablePointInZone(FVector& OutLocation, float Rad
 	const FVector Candidate = GetRandomPointInZone();
 	const FVector Extent(200.f, 200.f, 500.f);
 
+	CPPTESTS_COUNT(STAT_CPPTests_NavQueries, NavQueries, 1);
 	if (NavSys->ProjectPointToNavigation(Candidate, NavLoc, Extent))
 	{
 		OutLocation = NavLoc.Location;
@@ -81,6 +122,136 @@ bool ANPCSafeZone::GetRandomReachablePointInZone(FVector& OutLocation, float Rad
 	return false;
 }
 
+bool ANPCSafeZone::TakeReachablePoint(FVector& OutLocation, float RadiusOverride)
+{
+	const int32 NumPooled = PointPool.Num();
+	if (NumPooled > 0)
+	{
+		const FVector Center = GetActorLocation();
+		const float RadiusToUse = (RadiusOverride > 0.0f) ? FMath::Min(RadiusOverride, ZoneRadius) : ZoneRadius;
+		const float RadiusSq = FMath::Square(RadiusToUse);
+
+		// Pool points cover the whole zone; a smaller radius may need a couple of probes
+		const int32 MaxProbes = FMath::Min(NumPooled, 4);
+		for (int32 i = 0; i < MaxProbes; ++i)
+		{
+			PoolReadIndex = (PoolReadIndex + 1) % NumPooled;
+
+			const FVector& Candidate = PointPool[PoolReadIndex];
+			if (FVector::DistSquared2D(Candidate, Center) <= RadiusSq)
+			{
+				OutLocation = Candidate;
+				++PointsTakenSinceRefill;
+				UpdateRefillTimer();
+				return true;
+			}
+		}
+	}
+
+	return GetRandomReachablePointInZone(OutLocation, RadiusOverride);
+}
+
+void ANPCSafeZone::RefillPointPool()
+{
+	if (ReachablePointPoolSize <= 0)
+	{
+		return;
+	}
+
+	UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld());
+	if (!NavSys)
+	{
+		return;
+	}
+
+	// Don't sample a navmesh that is mid-rebuild, the points may be gone in a moment
+	if (NavSys->IsNavigationBuildInProgress())
+	{
+		return;
+	}
+
+	const FVector Center = GetActorLocation();
+
+	// A full pool only needs fresh points where NPCs have been reading from it
+	const int32 NumSamples = (PointPool.Num() < ReachablePointPoolSize)
+		? PoolSamplesPerRefill
+		: FMath::Min(PoolSamplesPerRefill, PointsTakenSinceRefill);
+	PointsTakenSinceRefill = 0;
+
+	for (int32 i = 0; i < NumSamples; ++i)
+	{
+		FNavLocation NavLoc;
+		CPPTESTS_COUNT(STAT_CPPTests_NavQueries, NavQueries, 1);
+		if (!NavSys->GetRandomReachablePointInRadius(Center, ZoneRadius, NavLoc))
+		{
+			continue;
+		}
+
+		if (PointPool.Num() < ReachablePointPoolSize)
+		{
+			PointPool.Add(NavLoc.Location);
+			continue;
+		}
+
+		PointPool[PoolWriteIndex] = NavLoc.Location;
+		PoolWriteIndex = (PoolWriteIndex + 1) % ReachablePointPoolSize;
+	}
+
+	UpdateRefillTimer();
+}
+
+void ANPCSafeZone::UpdateRefillTimer()
+{
+	UWorld* World = GetWorld();
+	if (!World || !HasActorBegunPlay() || ReachablePointPoolSize <= 0)
+	{
+		return;
+	}
+
+	const bool bNeedsRefill = BoundNPCs.Num() > 0
+		&& (PointPool.Num() < ReachablePointPoolSize || PointsTakenSinceRefill > 0);
+
+	FTimerManager& TimerManager = World->GetTimerManager();
+	const bool bRunning = TimerManager.IsTimerActive(PoolRefillTimerHandle);
+
+	if (bNeedsRefill && !bRunning)
+	{
+		TimerManager.SetTimer(
+			PoolRefillTimerHandle,
+			this,
+			&ANPCSafeZone::RefillPointPool,
+			PoolRefillInterval,
+			true
+		);
+	}
+	else if (!bNeedsRefill && bRunning)
+	{
+		TimerManager.ClearTimer(PoolRefillTimerHandle);
+	}
+}
+
+void ANPCSafeZone::InvalidatePointPool()
+{
+	PointPool.Reset();
+	PoolWriteIndex = 0;
+	PoolReadIndex = 0;
+	PointsTakenSinceRefill = 0;
+}
+
+void ANPCSafeZone::HandleNavigationDirty(const FBox& DirtyBounds)
+{
+	if (!ZoneSphere || PointPool.Num() == 0)
+	{
+		return;
+	}
+
+	if (DirtyBounds.Intersect(ZoneSphere->Bounds.GetBox()))
+	{
+		InvalidatePointPool();
+		UpdateRefillTimer();
+	}
+}
+
 void ANPCSafeZone::RegisterNPC(ANPCCharacter* NPC)
 {
 	if (!IsValid(NPC))
@@ -89,6 +260,31 @@ void ANPCSafeZone::RegisterNPC(ANPCCharacter* NPC)
 	}
 
 	BoundNPCs.AddUnique(NPC);
+	UpdateRefillTimer();
+}
+
+void ANPCSafeZone::RegisterNPCs(TConstArrayView<ANPCCharacter*> NPCs)
+{
+	TSet<ANPCCharacter*> Known;
+	Known.Reserve(BoundNPCs.Num() + NPCs.Num());
+	for (ANPCCharacter* Bound : BoundNPCs)
+	{
+		Known.Add(Bound);
+	}
+
+	BoundNPCs.Reserve(BoundNPCs.Num() + NPCs.Num());
+	for (ANPCCharacter* NPC : NPCs)
+	{
+		bool bAlreadyBound = false;
+		Known.Add(NPC, &bAlreadyBound);
+
+		if (IsValid(NPC) && !bAlreadyBound)
+		{
+			BoundNPCs.Add(NPC);
+		}
+	}
+
+	UpdateRefillTimer();
 }
 
 void ANPCSafeZone::UnregisterNPC(ANPCCharacter* NPC)
@@ -99,4 +295,5 @@ void ANPCSafeZone::UnregisterNPC(ANPCCharacter* NPC)
 	}
 
 	BoundNPCs.Remove(NPC);
+	UpdateRefillTimer();
 }
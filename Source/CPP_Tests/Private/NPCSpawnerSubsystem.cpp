@@ -0,0 +1,195 @@
+#include "NPCSpawnerSubsystem.h"
+
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "NPCCharacter.h"
+#include "NPCPoolSubsystem.h"
+#include "NPCSafeZone.h"
+
+static FAutoConsoleCommandWithWorld GNPCSpawnerStatsCmd(
+	TEXT("NPC.Spawner.Stats"),
+	TEXT("Logs NPC spawner throughput (spawns/sec, avg and peak frame cost) for the current world."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UNPCSpawnerSubsystem* Spawner = World ? World->GetSubsystem<UNPCSpawnerSubsystem>() : nullptr)
+		{
+			Spawner->LogStats();
+		}
+	})
+);
+
+void UNPCSpawnerSubsystem::Deinitialize()
+{
+	Queue.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UNPCSpawnerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UNPCSpawnerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNPCSpawnerSubsystem, STATGROUP_Tickables);
+}
+
+int32 UNPCSpawnerSubsystem::QueueSpawnBatch(const FNPCSpawnBatch& Batch)
+{
+	if (!Batch.NPCClass || Batch.Transforms.Num() == 0)
+	{
+		return 0;
+	}
+
+	FNPCPendingSpawnBatch& Pending = Queue.AddDefaulted_GetRef();
+	Pending.Id = NextBatchId++;
+	Pending.Request = Batch;
+	Pending.Spawned.Reserve(Batch.Transforms.Num());
+
+	++Stats.BatchesQueued;
+	return Pending.Id;
+}
+
+void UNPCSpawnerSubsystem::CancelSpawnBatch(int32 BatchId)
+{
+	const int32 Index = Queue.IndexOfByPredicate([BatchId](const FNPCPendingSpawnBatch& Batch) { return Batch.Id == BatchId; });
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	// Whatever already spawned still gets its zone registration and the finished event
+	FNPCPendingSpawnBatch Batch = MoveTemp(Queue[Index]);
+	Queue.RemoveAt(Index, EAllowShrinking::No);
+	FinishBatch(Batch);
+}
+
+int32 UNPCSpawnerSubsystem::GetNumPendingSpawns() const
+{
+	int32 Total = 0;
+	for (const FNPCPendingSpawnBatch& Batch : Queue)
+	{
+		Total += Batch.Request.Transforms.Num() - Batch.NextIndex;
+	}
+	return Total;
+}
+
+void UNPCSpawnerSubsystem::Tick(float DeltaTime)
+{
+	if (Queue.Num() == 0)
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double Deadline = StartTime + FMath::Max(0.0f, SpawnBudgetMs) / 1000.0;
+	const int32 MaxSpawns = FMath::Max(1, MaxSpawnsPerFrame);
+
+	// Always make progress (at least one spawn) even if a single spawn blows the budget
+	int32 SpawnsThisFrame = 0;
+	while (Queue.Num() > 0 && SpawnsThisFrame < MaxSpawns)
+	{
+		FNPCPendingSpawnBatch& Batch = Queue[0];
+
+		if (Batch.NextIndex < Batch.Request.Transforms.Num())
+		{
+			SpawnOne(Batch);
+			++SpawnsThisFrame;
+		}
+
+		if (Batch.NextIndex >= Batch.Request.Transforms.Num())
+		{
+			FNPCPendingSpawnBatch Finished = MoveTemp(Queue[0]);
+			Queue.RemoveAt(0, EAllowShrinking::No);
+			FinishBatch(Finished);
+		}
+
+		if (FPlatformTime::Seconds() >= Deadline)
+		{
+			break;
+		}
+	}
+
+	const double FrameSeconds = FPlatformTime::Seconds() - StartTime;
+	Stats.SpawnSeconds += FrameSeconds;
+	Stats.PeakFrameSeconds = FMath::Max(Stats.PeakFrameSeconds, FrameSeconds);
+	++Stats.FramesSpawning;
+}
+
+bool UNPCSpawnerSubsystem::SpawnOne(FNPCPendingSpawnBatch& Batch)
+{
+	const FTransform& SpawnTransform = Batch.Request.Transforms[Batch.NextIndex++];
+
+	UWorld* World = GetWorld();
+	UNPCPoolSubsystem* Pool = World ? World->GetSubsystem<UNPCPoolSubsystem>() : nullptr;
+	if (!Pool)
+	{
+		++Stats.Failed;
+		return false;
+	}
+
+	ANPCSafeZone* Zone = Batch.Request.SafeZone;
+	const int32 DormantBefore = Pool->GetNumDormant(Batch.Request.NPCClass);
+
+	// Zone registration waits for FinishBatch
+	ANPCCharacter* NPC = Pool->AcquireNPCUnregistered(Batch.Request.NPCClass, SpawnTransform, Zone, Batch.Request.Archetype);
+	if (!NPC)
+	{
+		++Stats.Failed;
+		return false;
+	}
+
+	if (Pool->GetNumDormant(Batch.Request.NPCClass) < DormantBefore)
+	{
+		++Stats.Reused;
+	}
+	else
+	{
+		++Stats.Spawned;
+	}
+
+	Batch.Spawned.Add(NPC);
+	return true;
+}
+
+void UNPCSpawnerSubsystem::FinishBatch(FNPCPendingSpawnBatch& Batch)
+{
+	TArray<ANPCCharacter*> Alive;
+	Alive.Reserve(Batch.Spawned.Num());
+
+	ANPCSafeZone* Zone = Batch.Request.SafeZone;
+
+	for (ANPCCharacter* NPC : Batch.Spawned)
+	{
+		// Anything that died and went back to the pool (or moved zone) since spawning is skipped
+		if (IsValid(NPC) && !NPC->IsInPool())
+		{
+			Alive.Add(NPC);
+		}
+	}
+
+	if (IsValid(Zone))
+	{
+		TArray<ANPCCharacter*> ForZone;
+		ForZone.Reserve(Alive.Num());
+		for (ANPCCharacter* NPC : Alive)
+		{
+			if (NPC->GetSafeZone() == Zone)
+			{
+				ForZone.Add(NPC);
+			}
+		}
+		Zone->RegisterNPCs(ForZone);
+	}
+
+	++Stats.BatchesFinished;
+	OnSpawnBatchFinished.Broadcast(Batch.Id, Alive);
+}
+
+void UNPCSpawnerSubsystem::LogStats() const
+{
+	UE_LOG(LogTemp, Log, TEXT("NPC spawner: %d batches queued, %d finished, %d spawned, %d reused from pool, %d failed, %d pending | %.1f spawns/sec, %.3f ms avg, %.3f ms peak frame over %d frames"),
+		Stats.BatchesQueued, Stats.BatchesFinished, Stats.Spawned, Stats.Reused, Stats.Failed, GetNumPendingSpawns(),
+		Stats.GetSpawnsPerSecond(), Stats.GetAverageSpawnMs(), Stats.PeakFrameSeconds * 1000.0, Stats.FramesSpawning);
+}
@@ -0,0 +1,179 @@
+#include "NPCStateTreeTasks.h"
+
+#include "AIController.h"
+#include "Kismet/GameplayStatics.h"
+#include "NPCCharacter.h"
+#include "StateTreeExecutionContext.h"
+
+namespace
+{
+	// Same rule as the built-in brain's lose-interest timer, tracked per task instance
+	bool HasLostInterest(FNPCReactionTaskInstanceData& Data, bool bPlayerInRange, float LoseInterestSeconds, float Now)
+	{
+		if (bPlayerInRange)
+		{
+			Data.OutOfRangeStartTime = -1.0f;
+			return false;
+		}
+
+		if (Data.OutOfRangeStartTime < 0.0f)
+		{
+			Data.OutOfRangeStartTime = Now;
+			return false;
+		}
+
+		return (Now - Data.OutOfRangeStartTime) >= LoseInterestSeconds;
+	}
+}
+
+FNPCWanderTask::FNPCWanderTask()
+{
+	bShouldCallTick = false;
+}
+
+EStateTreeRunStatus FNPCWanderTask::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	const FInstanceDataType& Data = Context.GetInstanceData(*this);
+	ANPCCharacter* NPC = Data.NPC;
+	if (!NPC)
+	{
+		return EStateTreeRunStatus::Failed;
+	}
+
+	NPC->SetMode(ANPCCharacter::ENPCMode::Wander);
+
+	return EStateTreeRunStatus::Running;
+}
+
+EStateTreeRunStatus FNPCChaseTask::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	FInstanceDataType& Data = Context.GetInstanceData(*this);
+	if (!Data.NPC)
+	{
+		return EStateTreeRunStatus::Failed;
+	}
+
+	Data.NPC->SetMode(ANPCCharacter::ENPCMode::Chase);
+	Data.NextRepathTime = 0.0f;
+	Data.OutOfRangeStartTime = -1.0f;
+
+	return EStateTreeRunStatus::Running;
+}
+
+EStateTreeRunStatus FNPCChaseTask::Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const
+{
+	FInstanceDataType& Data = Context.GetInstanceData(*this);
+	ANPCCharacter* NPC = Data.NPC;
+	if (!NPC || !Data.AIController || NPC->IsDead())
+	{
+		return EStateTreeRunStatus::Failed;
+	}
+
+	const float Now = NPC->GetWorld()->GetTimeSeconds();
+	APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(NPC, 0);
+
+	if (HasLostInterest(Data, NPC->IsPlayerInReactionRange(PlayerPawn), NPC->GetTuning().LoseInterestSeconds, Now))
+	{
+		return EStateTreeRunStatus::Succeeded;
+	}
+
+	if (Now >= Data.NextRepathTime && PlayerPawn)
+	{
+		Data.NextRepathTime = Now + NPC->GetTuning().ReactionRepathInterval;
+		NPC->ChasePlayer(Data.AIController, PlayerPawn);
+	}
+
+	return EStateTreeRunStatus::Running;
+}
+
+EStateTreeRunStatus FNPCFleeTask::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	FInstanceDataType& Data = Context.GetInstanceData(*this);
+	if (!Data.NPC)
+	{
+		return EStateTreeRunStatus::Failed;
+	}
+
+	Data.NPC->SetMode(ANPCCharacter::ENPCMode::Flee);
+	Data.NextRepathTime = 0.0f;
+	Data.OutOfRangeStartTime = -1.0f;
+
+	return EStateTreeRunStatus::Running;
+}
+
+EStateTreeRunStatus FNPCFleeTask::Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const
+{
+	FInstanceDataType& Data = Context.GetInstanceData(*this);
+	ANPCCharacter* NPC = Data.NPC;
+	if (!NPC || !Data.AIController || NPC->IsDead())
+	{
+		return EStateTreeRunStatus::Failed;
+	}
+
+	const float Now = NPC->GetWorld()->GetTimeSeconds();
+	APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(NPC, 0);
+
+	if (HasLostInterest(Data, NPC->IsPlayerInReactionRange(PlayerPawn), NPC->GetTuning().LoseInterestSeconds, Now))
+	{
+		return EStateTreeRunStatus::Succeeded;
+	}
+
+	if (Now >= Data.NextRepathTime && PlayerPawn)
+	{
+		Data.NextRepathTime = Now + NPC->GetTuning().ReactionRepathInterval;
+		NPC->FleeFromPlayer(Data.AIController, PlayerPawn);
+	}
+
+	return EStateTreeRunStatus::Running;
+}
+
+EStateTreeRunStatus FNPCReturnHomeTask::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	FInstanceDataType& Data = Context.GetInstanceData(*this);
+	if (!Data.NPC)
+	{
+		return EStateTreeRunStatus::Failed;
+	}
+
+	Data.NPC->SetMode(ANPCCharacter::ENPCMode::ReturnHome);
+	Data.ReturnHome.Reset();
+
+	return EStateTreeRunStatus::Running;
+}
+
+EStateTreeRunStatus FNPCReturnHomeTask::Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const
+{
+	FInstanceDataType& Data = Context.GetInstanceData(*this);
+	ANPCCharacter* NPC = Data.NPC;
+	if (!NPC || !Data.AIController || NPC->IsDead())
+	{
+		return EStateTreeRunStatus::Failed;
+	}
+
+	return NPC->ReturnHome(Data.AIController, Data.ReturnHome)
+		? EStateTreeRunStatus::Succeeded
+		: EStateTreeRunStatus::Running;
+}
+
+bool FNPCRoleCondition::TestCondition(FStateTreeExecutionContext& Context) const
+{
+	const FInstanceDataType& Data = Context.GetInstanceData(*this);
+	const ANPCCharacter* NPC = Data.NPC;
+	if (!NPC)
+	{
+		return false;
+	}
+
+	bool bResult = false;
+	switch (Role)
+	{
+	case ENPCRoleCheck::Aggressive:     bResult = NPC->IsAggressive(); break;
+	case ENPCRoleCheck::ScaredOfPlayer: bResult = NPC->IsScaredOfPlayer(); break;
+	case ENPCRoleCheck::Stationary:     bResult = NPC->IsStationary(); break;
+	case ENPCRoleCheck::Merchant:       bResult = NPC->IsMerchant(); break;
+	case ENPCRoleCheck::Neutral:        bResult = NPC->IsNeutral(); break;
+	default: break;
+	}
+
+	return bResult ^ bInvert;
+}
@@ -7,6 +7,8 @@
 #include "CPP_TestsCharacter.h"
 #include "InventoryComponent.h"
 #include "ItemDataAsset.h"
+#include "LootTableDataAsset.h"
+#include "PickupSubsystem.h"
 
 APickupItemActor::APickupItemActor()
 {
@@ -28,9 +30,32 @@ APickupItemActor::APickupItemActor()
 	InteractSphere->SetCollisionResponseToChannel(ECC_Visibility, ECR_Block);
 }
 
+void APickupItemActor::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (bStoreAsRecord && bDestroyOnPickup)
+	{
+		if (UPickupSubsystem* Pickups = GetWorld()->GetSubsystem<UPickupSubsystem>())
+		{
+			Pickups->AbsorbActor(this);
+		}
+	}
+}
+
+void APickupItemActor::GetAllStacks(TArray<FItemStack>& OutStacks) const
+{
+	ULootTableDataAsset::MergeStack(OutStacks, ItemData, Quantity, PickupRarity);
+	for (const FItemStack& Stack : Contents)
+	{
+		ULootTableDataAsset::MergeStack(OutStacks, Stack.Item, Stack.Quantity, Stack.Rarity);
+	}
+}
+
 void APickupItemActor::Interact_Implementation(AActor* Interactor)
 {
-	if (!ItemData || Quantity <= 0) return;
+	const bool bHasSingle = ItemData && Quantity > 0;
+	if (!bHasSingle && Contents.Num() == 0) return;
 
 	ACPP_TestsCharacter* Player = Cast<ACPP_TestsCharacter>(Interactor);
 	if (!Player) return;
@@ -38,17 +63,63 @@ void APickupItemActor::Interact_Implementation(AActor* Interactor)
 	UInventoryComponent* Inv = Player->FindComponentByClass<UInventoryComponent>();
 	if (!Inv) return;
 
-	const bool bAdded = Inv->AddItem(ItemData, Quantity, PickupRarity);
+	bool bTookEverything = true;
 
-	if (GEngine)
+	if (bHasSingle)
 	{
-		const FString Msg = FString::Printf(TEXT("Picked up: %s x%d"),
-			*GetNameSafe(ItemData),
-			Quantity);
-		GEngine->AddOnScreenDebugMessage(-1, 1.5f, FColor::Green, Msg);
+		if (Inv->AddItem(ItemData, Quantity, PickupRarity))
+		{
+			if (GEngine)
+			{
+				const FString Msg = FString::Printf(TEXT("Picked up: %s x%d"),
+					*GetNameSafe(ItemData),
+					Quantity);
+				GEngine->AddOnScreenDebugMessage(-1, 1.5f, FColor::Green, Msg);
+			}
+
+			// Consumed so a partly-refused container doesn't hand it out twice
+			if (bDestroyOnPickup)
+			{
+				ItemData = nullptr;
+			}
+		}
+		else
+		{
+			bTookEverything = false;
+		}
+	}
+
+	// Anything the inventory refuses stays in the container
+	for (int32 i = Contents.Num() - 1; i >= 0; --i)
+	{
+		const FItemStack& Stack = Contents[i];
+		if (!Stack.Item || Stack.Quantity <= 0)
+		{
+			Contents.RemoveAt(i, EAllowShrinking::No);
+			continue;
+		}
+
+		if (!Inv->AddItem(Stack.Item, Stack.Quantity, Stack.Rarity))
+		{
+			bTookEverything = false;
+			continue;
+		}
+
+		if (GEngine)
+		{
+			const FString Msg = FString::Printf(TEXT("Picked up: %s x%d"),
+				*GetNameSafe(Stack.Item),
+				Stack.Quantity);
+			GEngine->AddOnScreenDebugMessage(-1, 1.5f, FColor::Green, Msg);
+		}
+
+		if (bDestroyOnPickup)
+		{
+			Contents.RemoveAt(i, EAllowShrinking::No);
+		}
 	}
 
-	if (bAdded && bDestroyOnPickup)
+	if (bTookEverything && bDestroyOnPickup)
 	{
 		Destroy();
 	}
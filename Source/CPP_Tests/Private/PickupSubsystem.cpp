@@ -0,0 +1,283 @@
+#include "PickupSubsystem.h"
+
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "CPP_TestsStats.h"
+#include "Interactable.h"
+#include "ItemDataAsset.h"
+#include "PickupItemActor.h"
+
+void UPickupSubsystem::Deinitialize()
+{
+	Records.Reset();
+	Batches.Reset();
+	Cells.Reset();
+	ISMHost = nullptr;
+
+	Super::Deinitialize();
+}
+
+bool UPickupSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+FIntPoint UPickupSubsystem::ToCell(const FVector& Location) const
+{
+	return FIntPoint(
+		FMath::FloorToInt(Location.X / CellSize),
+		FMath::FloorToInt(Location.Y / CellSize)
+	);
+}
+
+FPickupMeshBatch* UPickupSubsystem::FindOrAddBatch(UStaticMesh* Mesh)
+{
+	LLM_SCOPE_BYTAG(CPPTests_Pickups);
+
+	if (FPickupMeshBatch* Existing = Batches.Find(Mesh))
+	{
+		return Existing;
+	}
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	if (!ISMHost)
+	{
+		FActorSpawnParameters Params;
+		Params.ObjectFlags |= RF_Transient;
+		ISMHost = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, Params);
+
+		if (!ISMHost)
+		{
+			return nullptr;
+		}
+
+		USceneComponent* Root = NewObject<USceneComponent>(ISMHost, TEXT("Root"));
+		ISMHost->SetRootComponent(Root);
+		Root->RegisterComponent();
+	}
+
+	UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(ISMHost);
+	ISM->SetStaticMesh(Mesh);
+	ISM->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	ISM->SetCanEverAffectNavigation(false);
+	ISM->SetupAttachment(ISMHost->GetRootComponent());
+	ISM->RegisterComponent();
+
+	FPickupMeshBatch& Batch = Batches.Add(Mesh);
+	Batch.ISM = ISM;
+	return &Batch;
+}
+
+int32 UPickupSubsystem::AddPickup(const TArray<FItemStack>& Stacks, const FTransform& Transform)
+{
+	LLM_SCOPE_BYTAG(CPPTests_Pickups);
+
+	// First stack with a pickup mesh decides what the pile looks like
+	UStaticMesh* Mesh = nullptr;
+	for (const FItemStack& Stack : Stacks)
+	{
+		if (Stack.Item && Stack.Quantity > 0 && Stack.Item->PickupMesh)
+		{
+			Mesh = Stack.Item->PickupMesh;
+			break;
+		}
+	}
+
+	FPickupMeshBatch* Batch = Mesh ? FindOrAddBatch(Mesh) : nullptr;
+	if (!Batch)
+	{
+		return 0;
+	}
+
+	const int32 Id = NextId++;
+
+	FPickupRecord& Record = Records.Add(Id);
+	Record.Stacks = Stacks;
+	Record.Transform = Transform;
+	Record.Mesh = Mesh;
+	Record.Cell = ToCell(Transform.GetLocation());
+	Record.InstanceIndex = Batch->ISM->AddInstance(Transform, /*bWorldSpace=*/true);
+	CPPTESTS_COUNT(STAT_CPPTests_InstancesGenerated, InstancesGenerated, 1);
+
+	Batch->InstanceToRecord.Add(Id);
+	Cells.FindOrAdd(Record.Cell).Add(Id);
+
+	return Id;
+}
+
+bool UPickupSubsystem::RemovePickup(int32 Id, FPickupRecord* OutRecord)
+{
+	FPickupRecord Record;
+	if (!Records.RemoveAndCopyValue(Id, Record))
+	{
+		return false;
+	}
+
+	if (TArray<int32>* CellIds = Cells.Find(Record.Cell))
+	{
+		CellIds->RemoveSingleSwap(Id, EAllowShrinking::No);
+		if (CellIds->Num() == 0)
+		{
+			Cells.Remove(Record.Cell);
+		}
+	}
+
+	if (FPickupMeshBatch* Batch = Batches.Find(Record.Mesh))
+	{
+		const int32 Index = Record.InstanceIndex;
+		const int32 Last = Batch->InstanceToRecord.Num() - 1;
+
+		// Same swap-with-last trick as the ambient NPC proxies so indices stay dense
+		if (Index != Last)
+		{
+			FTransform LastTransform;
+			Batch->ISM->GetInstanceTransform(Last, LastTransform, /*bWorldSpace=*/true);
+			Batch->ISM->UpdateInstanceTransform(Index, LastTransform, /*bWorldSpace=*/true, /*bMarkRenderStateDirty=*/false, /*bTeleport=*/true);
+
+			const int32 MovedId = Batch->InstanceToRecord[Last];
+			Batch->InstanceToRecord[Index] = MovedId;
+			if (FPickupRecord* Moved = Records.Find(MovedId))
+			{
+				Moved->InstanceIndex = Index;
+			}
+		}
+
+		Batch->ISM->RemoveInstance(Last);
+		Batch->InstanceToRecord.RemoveAt(Last, EAllowShrinking::No);
+	}
+
+	if (OutRecord)
+	{
+		*OutRecord = MoveTemp(Record);
+	}
+	return true;
+}
+
+int32 UPickupSubsystem::FindPickupAlongSegment(const FVector& Start, const FVector& End) const
+{
+	if (Records.Num() == 0)
+	{
+		return 0;
+	}
+
+	const FVector MinLoc = Start.ComponentMin(End) - FVector(InteractRadius);
+	const FVector MaxLoc = Start.ComponentMax(End) + FVector(InteractRadius);
+	const FIntPoint MinCell = ToCell(MinLoc);
+	const FIntPoint MaxCell = ToCell(MaxLoc);
+
+	const float RadiusSq = FMath::Square(InteractRadius);
+	int32 BestId = 0;
+	float BestDistSq = TNumericLimits<float>::Max();
+
+	for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+	{
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			const TArray<int32>* CellIds = Cells.Find(FIntPoint(X, Y));
+			if (!CellIds)
+			{
+				continue;
+			}
+
+			for (const int32 Id : *CellIds)
+			{
+				const FVector Loc = Records.FindChecked(Id).Transform.GetLocation();
+				if (FMath::PointDistToSegmentSquared(Loc, Start, End) > RadiusSq)
+				{
+					continue;
+				}
+
+				// Nearest to the eye wins, like a real trace would
+				const float DistSq = FVector::DistSquared(Start, Loc);
+				if (DistSq < BestDistSq)
+				{
+					BestDistSq = DistSq;
+					BestId = Id;
+				}
+			}
+		}
+	}
+
+	return BestId;
+}
+
+APickupItemActor* UPickupSubsystem::MaterializePickup(int32 Id)
+{
+	LLM_SCOPE_BYTAG(CPPTests_Pickups);
+
+	UWorld* World = GetWorld();
+	if (!World || !Records.Contains(Id))
+	{
+		return nullptr;
+	}
+
+	UClass* ActorClass = MaterializeClass.LoadSynchronous();
+	if (!ActorClass)
+	{
+		ActorClass = APickupItemActor::StaticClass();
+	}
+
+	FPickupRecord Record;
+	RemovePickup(Id, &Record);
+
+	APickupItemActor* Pickup = World->SpawnActorDeferred<APickupItemActor>(ActorClass, Record.Transform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	if (!Pickup)
+	{
+		return nullptr;
+	}
+
+	Pickup->ItemData = nullptr;
+	Pickup->Quantity = 0;
+	Pickup->Contents = MoveTemp(Record.Stacks);
+	Pickup->bStoreAsRecord = false;
+	Pickup->FinishSpawning(Record.Transform);
+	return Pickup;
+}
+
+bool UPickupSubsystem::InteractWithPickup(int32 Id, AActor* Interactor)
+{
+	APickupItemActor* Pickup = MaterializePickup(Id);
+	if (!Pickup)
+	{
+		return false;
+	}
+
+	IInteractable::Execute_Interact(Pickup, Interactor);
+
+	if (IsValid(Pickup))
+	{
+		AbsorbActor(Pickup);
+	}
+	return true;
+}
+
+bool UPickupSubsystem::AbsorbActor(APickupItemActor* Pickup)
+{
+	if (!IsValid(Pickup))
+	{
+		return false;
+	}
+
+	TArray<FItemStack> Stacks;
+	Pickup->GetAllStacks(Stacks);
+
+	if (Stacks.Num() == 0)
+	{
+		Pickup->Destroy();
+		return true;
+	}
+
+	if (AddPickup(Stacks, Pickup->GetActorTransform()) == 0)
+	{
+		return false;
+	}
+
+	Pickup->Destroy();
+	return true;
+}
@@ -3,12 +3,30 @@
 #include "Components/ProgressBar.h"
 #include "Components/Image.h"
 #include "Components/HorizontalBox.h"
+#include "Components/InvalidationBox.h"
+#include "Components/RetainerBox.h"
 #include "Components/SizeBox.h"
 #include "Components/TextBlock.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
 
 #include "PlayerStatsComponent.h"
 #include "StatusEffectComponent.h"
 
+void UPlayerHUDWidget::NativeOnInitialized()
+{
+	Super::NativeOnInitialized();
+
+	if (BarsInvalidationBox)   BarsInvalidationBox->SetCanCache(true);
+	if (StatusInvalidationBox) StatusInvalidationBox->SetCanCache(true);
+
+	if (HUDRetainer)
+	{
+		HUDRetainer->SetRetainRendering(RetainerPhaseCount > 1);
+		HUDRetainer->SetRenderingPhase(0, FMath::Max(1, RetainerPhaseCount));
+	}
+}
+
 void UPlayerHUDWidget::InitializeFromComponents(UPlayerStatsComponent* InStats, UStatusEffectComponent* InEffects)
 {
 	Stats = InStats;
@@ -25,7 +43,6 @@ void UPlayerHUDWidget::InitializeFromComponents(UPlayerStatsComponent* InStats,
 
 	RefreshBars();
 	RefreshStatusIcons();
-	RefreshCurrencyOnly();
 }
 
 void UPlayerHUDWidget::NativeDestruct()
@@ -39,21 +56,33 @@ void UPlayerHUDWidget::NativeDestruct()
 		Effects->OnEffectsChanged.RemoveDynamic(this, &UPlayerHUDWidget::HandleEffectsChanged);
 	}
 
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(BarAnimationTimer);
+	}
+
 	Super::NativeDestruct();
 }
 
-void UPlayerHUDWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+void UPlayerHUDWidget::HandleStatsChanged(int32 ChangedStats)
 {
-	Super::NativeTick(MyGeometry, InDeltaTime);
+	const EPlayerStatFlags Changed = EPlayerStatFlags(ChangedStats);
 
-	// Currency might change without OnStatsChanged firing (common early bug).
-	RefreshCurrencyOnly();
-}
+	// Widths only follow attributes; everything else leaves the size boxes alone
+	if (EnumHasAnyFlags(Changed, EPlayerStatFlags::Attributes))
+	{
+		RefreshBarWidths();
+	}
 
-void UPlayerHUDWidget::HandleStatsChanged()
-{
-	RefreshBars();
-	RefreshCurrencyOnly();
+	if (EnumHasAnyFlags(Changed, EPlayerStatFlags::Health | EPlayerStatFlags::Stamina | EPlayerStatFlags::Magic | EPlayerStatFlags::Attributes))
+	{
+		StartBarAnimation();
+	}
+
+	if (EnumHasAnyFlags(Changed, EPlayerStatFlags::Currency))
+	{
+		RefreshCurrencyOnly();
+	}
 }
 
 void UPlayerHUDWidget::HandleEffectsChanged()
@@ -61,6 +90,43 @@ void UPlayerHUDWidget::HandleEffectsChanged()
 	RefreshStatusIcons();
 }
 
+// -------------------------
+// Bar animation
+// -------------------------
+void UPlayerHUDWidget::StartBarAnimation()
+{
+	RefreshBarFills();
+
+	UWorld* World = GetWorld();
+	if (!World || !Stats || BarAnimationHz <= 0.f || !Stats->IsDisplayInterpolating())
+	{
+		return;
+	}
+
+	FTimerManager& Timers = World->GetTimerManager();
+	if (!Timers.IsTimerActive(BarAnimationTimer))
+	{
+		Timers.SetTimer(BarAnimationTimer, this, &UPlayerHUDWidget::TickBarAnimation, 1.f / BarAnimationHz, true);
+	}
+}
+
+void UPlayerHUDWidget::TickBarAnimation()
+{
+	RefreshBarFills();
+
+	// Stops once the display values catch up; the next stat change starts it again
+	if (!Stats || !Stats->IsDisplayInterpolating())
+	{
+		if (UWorld* World = GetWorld())
+		{
+			World->GetTimerManager().ClearTimer(BarAnimationTimer);
+		}
+	}
+}
+
+// -------------------------
+// Refresh
+// -------------------------
 float UPlayerHUDWidget::ApplyOptionalClamp(float Width) const
 {
 	if (MaxWidthClamp > 0.f)
@@ -70,6 +136,25 @@ float UPlayerHUDWidget::ApplyOptionalClamp(float Width) const
 	return Width;
 }
 
+void UPlayerHUDWidget::SetBarPercent(UProgressBar* Bar, float& LastPercent, float Percent)
+{
+	// Sub-pixel changes aren't worth an invalidation
+	if (Bar && !FMath::IsNearlyEqual(LastPercent, Percent, 0.001f))
+	{
+		LastPercent = Percent;
+		Bar->SetPercent(Percent);
+	}
+}
+
+void UPlayerHUDWidget::SetBoxWidth(USizeBox* Box, float& LastWidth, float Width)
+{
+	if (Box && LastWidth != Width)
+	{
+		LastWidth = Width;
+		Box->SetWidthOverride(Width);
+	}
+}
+
 void UPlayerHUDWidget::RefreshCurrencyOnly()
 {
 	if (!Currency) return;
@@ -83,58 +168,65 @@ void UPlayerHUDWidget::RefreshCurrencyOnly()
 }
 
 void UPlayerHUDWidget::RefreshBars()
+{
+	RefreshBarWidths();
+	RefreshBarFills();
+	RefreshCurrencyOnly();
+
+	if (StaminaMaxBar) StaminaMaxBar->SetPercent(1.f);
+}
+
+void UPlayerHUDWidget::RefreshBarFills()
 {
 	if (!Stats)
 	{
-		if (HealthBar) HealthBar->SetPercent(0.f);
-		if (MagicBar) MagicBar->SetPercent(0.f);
-		if (StaminaFillBar) StaminaFillBar->SetPercent(0.f);
-		if (StaminaAvailBar) StaminaAvailBar->SetPercent(0.f);
-		if (StaminaMaxBar) StaminaMaxBar->SetPercent(1.f);
-
-		if (Currency) Currency->SetText(FText::FromString(TEXT("0")));
-		LastCurrencyShown = 0;
+		SetBarPercent(HealthBar, LastHealthPercent, 0.f);
+		SetBarPercent(MagicBar, LastMagicPercent, 0.f);
+		SetBarPercent(StaminaFillBar, LastStaminaPercent, 0.f);
+		SetBarPercent(StaminaAvailBar, LastStaminaAvailPercent, 0.f);
 		return;
 	}
 
-	// Currency (also handled in RefreshCurrencyOnly / Tick)
-	RefreshCurrencyOnly();
-
 	// Fill percents
-	const float HPct = Stats->GetHealthPercent();
-	if (HealthBar) HealthBar->SetPercent(HPct);
-	if (MagicBar)  MagicBar->SetPercent(Stats->GetMagicPercent());
+	const float DisplayHealth = Stats->GetDisplayHealth();
+	const float HPct = (Stats->MaxHealth <= 0.f) ? 0.f : FMath::Clamp(DisplayHealth / Stats->MaxHealth, 0.f, 1.f);
+	SetBarPercent(HealthBar, LastHealthPercent, HPct);
+	SetBarPercent(MagicBar, LastMagicPercent, (Stats->MaxMagic <= 0.f) ? 0.f : FMath::Clamp(Stats->GetDisplayMagic() / Stats->MaxMagic, 0.f, 1.f));
 
 	// Stamina trays
-	if (StaminaMaxBar) StaminaMaxBar->SetPercent(1.f);
-
 	const float AvMax = Stats->GetAvailableStaminaMax();
 	const float GoldPercent = (Stats->MaxStamina <= 0.f) ? 0.f : FMath::Clamp(AvMax / Stats->MaxStamina, 0.f, 1.f);
 
-	if (StaminaAvailBar) StaminaAvailBar->SetPercent(GoldPercent);
+	SetBarPercent(StaminaAvailBar, LastStaminaAvailPercent, GoldPercent);
 
 	float GreenPercent = 0.f;
 	if (Stats->MaxStamina > 0.f)
 	{
-		GreenPercent = FMath::Clamp(Stats->Stamina / Stats->MaxStamina, 0.f, 1.f);
+		GreenPercent = FMath::Clamp(Stats->GetDisplayStamina() / Stats->MaxStamina, 0.f, 1.f);
 		GreenPercent = FMath::Min(GreenPercent, GoldPercent);
 	}
 
-	if (StaminaFillBar)
-	{
-		StaminaFillBar->SetPercent(GreenPercent);
-	}
+	SetBarPercent(StaminaFillBar, LastStaminaPercent, GreenPercent);
 
 	if (StaminaAvailBar)
 	{
 		const bool bHideYellow = (HPct >= 0.999f);
-		StaminaAvailBar->SetVisibility(bHideYellow ? ESlateVisibility::Hidden : ESlateVisibility::Visible);
+		const ESlateVisibility NewVisibility = bHideYellow ? ESlateVisibility::Hidden : ESlateVisibility::Visible;
+		if (StaminaAvailBar->GetVisibility() != NewVisibility)
+		{
+			StaminaAvailBar->SetVisibility(NewVisibility);
+		}
 	}
+}
+
+void UPlayerHUDWidget::RefreshBarWidths()
+{
+	if (!Stats) return;
 
 	// Souls-style bar container width growth
-	const float StrengthPts  = (float)FMath::Max(0, Stats->Strength);
-	const float EndurancePts = (float)FMath::Max(0, Stats->Endurance);
-	const float WillpowerPts = (float)FMath::Max(0, Stats->Willpower);
+	const float StrengthPts  = FMath::Max(0.f, Stats->GetAttribute(EPlayerAttribute::Strength));
+	const float EndurancePts = FMath::Max(0.f, Stats->GetAttribute(EPlayerAttribute::Endurance));
+	const float WillpowerPts = FMath::Max(0.f, Stats->GetAttribute(EPlayerAttribute::Willpower));
 
 	float HealthW  = BaseHealthWidth  + (StrengthPts  * HealthPixelsPerPoint);
 	float StaminaW = BaseStaminaWidth + (EndurancePts * StaminaPixelsPerPoint);
@@ -144,9 +236,9 @@ void UPlayerHUDWidget::RefreshBars()
 	StaminaW = ApplyOptionalClamp(StaminaW);
 	MagicW   = ApplyOptionalClamp(MagicW);
 
-	if (HealthSizeBox)  HealthSizeBox->SetWidthOverride(HealthW);
-	if (StaminaSizeBox) StaminaSizeBox->SetWidthOverride(StaminaW);
-	if (MagicSizeBox)   MagicSizeBox->SetWidthOverride(MagicW);
+	SetBoxWidth(HealthSizeBox, LastHealthWidth, HealthW);
+	SetBoxWidth(StaminaSizeBox, LastStaminaWidth, StaminaW);
+	SetBoxWidth(MagicSizeBox, LastMagicWidth, MagicW);
 }
 
 void UPlayerHUDWidget::RefreshStatusIcons()
@@ -10,6 +10,7 @@
 #include "Components/HorizontalBox.h"
 #include "Layout/Margin.h"
 
+#include "CPP_TestsStats.h"
 #include "PlayerStatsComponent.h"
 #include "StatusEffectComponent.h"
 #include "InventoryComponent.h"
@@ -263,10 +264,18 @@ void UPlayerMenuWidget::ForceRefresh()
 	ApplyDetails();
 }
 
-void UPlayerMenuWidget::HandleStatsChanged()
+void UPlayerMenuWidget::HandleStatsChanged(int32 ChangedStats)
 {
-	RefreshStatsText();
-	UpdateCurrencyUI();
+	const EPlayerStatFlags Changed = EPlayerStatFlags(ChangedStats);
+
+	if (EnumHasAnyFlags(Changed, ~EPlayerStatFlags::Currency))
+	{
+		RefreshStatsText();
+	}
+	if (EnumHasAnyFlags(Changed, EPlayerStatFlags::Currency))
+	{
+		UpdateCurrencyUI();
+	}
 }
 
 void UPlayerMenuWidget::HandleEffectsChanged()
@@ -308,10 +317,11 @@ void UPlayerMenuWidget::RefreshStatsText()
 	SetValueText(ValBaseDamageOutput,    FString::Printf(TEXT("%.1f"), Stats->BaseDamageOutput));
 	SetValueText(ValBaseDamageReduction, FString::Printf(TEXT("%.1f"), Stats->BaseDamageReduction));
 
-	SetValueText(ValStrength,  FString::Printf(TEXT("%d"), Stats->Strength));
-	SetValueText(ValEndurance, FString::Printf(TEXT("%d"), Stats->Endurance));
-	SetValueText(ValWillpower, FString::Printf(TEXT("%d"), Stats->Willpower));
-	SetValueText(ValLuck,      FString::Printf(TEXT("%d"), Stats->Luck));
+	// Effective values, equipment and buffs included
+	SetValueText(ValStrength,  FString::Printf(TEXT("%.0f"), Stats->GetAttribute(EPlayerAttribute::Strength)));
+	SetValueText(ValEndurance, FString::Printf(TEXT("%.0f"), Stats->GetAttribute(EPlayerAttribute::Endurance)));
+	SetValueText(ValWillpower, FString::Printf(TEXT("%.0f"), Stats->GetAttribute(EPlayerAttribute::Willpower)));
+	SetValueText(ValLuck,      FString::Printf(TEXT("%.0f"), Stats->GetAttribute(EPlayerAttribute::Luck)));
 }
 
 void UPlayerMenuWidget::RefreshEffectsText()
@@ -693,6 +703,10 @@ void UPlayerMenuWidget::HandleMerchantSlotSubClicked(UInventorySlotWidget* Click
 
 void UPlayerMenuWidget::RefreshPlayerInventoryGrid()
 {
+	CPPTESTS_SCOPE(STAT_CPPTests_RefreshInventoryGrid, Menu_RefreshPlayerInventoryGrid);
+	CPPTESTS_COUNT(STAT_CPPTests_WidgetRebuilds, WidgetRebuilds, 1);
+	LLM_SCOPE_BYTAG(CPPTests_Menu);
+
 	bInventoryDirty = false;
 
 	// If we rebuild, any hover pointer is stale.
@@ -757,6 +771,7 @@ void UPlayerMenuWidget::RefreshPlayerInventoryGrid()
 
 		UInventorySlotWidget* NewSlotWidget = CreateWidget<UInventorySlotWidget>(GetOwningPlayer(), InventorySlotWidgetClass);
 		if (!NewSlotWidget) continue;
+		CPPTESTS_COUNT(STAT_CPPTests_WidgetsCreated, WidgetsCreated, 1);
 
 		const int32 Row = VisibleIdx / Cols;
 		const int32 Col = VisibleIdx % Cols;
@@ -811,6 +826,9 @@ void UPlayerMenuWidget::RefreshPlayerInventoryGrid()
 
 void UPlayerMenuWidget::RefreshMerchantInventoryGrid()
 {
+	CPPTESTS_COUNT(STAT_CPPTests_WidgetRebuilds, WidgetRebuilds, 1);
+	LLM_SCOPE_BYTAG(CPPTests_Menu);
+
 	// If we rebuild, any hover pointer is stale.
 	HoveredSlotWidget = nullptr;
 
@@ -842,6 +860,7 @@ void UPlayerMenuWidget::RefreshMerchantInventoryGrid()
 
 		UInventorySlotWidget* NewMerchantSlotWidget = CreateWidget<UInventorySlotWidget>(GetOwningPlayer(), InventorySlotWidgetClass);
 		if (!NewMerchantSlotWidget) continue;
+		CPPTESTS_COUNT(STAT_CPPTests_WidgetsCreated, WidgetsCreated, 1);
 
 		const int32 Row = VisibleIdx / Cols;
 		const int32 Col = VisibleIdx % Cols;
@@ -1226,6 +1245,8 @@ void UPlayerMenuWidget::ClearTrade()
 
 void UPlayerMenuWidget::ConfirmTrade()
 {
+	CPPTESTS_SCOPE(STAT_CPPTests_ConfirmTrade, Menu_ConfirmTrade);
+
 	UE_LOG(LogTemp, Warning, TEXT("ConfirmTrade CLICK: MerchantValid=%d SellCart=%d BuyCart=%d"),
 		ActiveMerchant.IsValid() ? 1 : 0,
 		SellCart.Num(),
@@ -3,13 +3,113 @@
 UPlayerStatsComponent::UPlayerStatsComponent()
 {
 	PrimaryComponentTick.bCanEverTick = false; // character drives updates
+
+	// The old hard-coded formulas
+	auto AddRule = [this](EPlayerAttribute Attribute, EPlayerAttribute Source, float Base, float PerPoint)
+	{
+		FDerivedAttributeRule& Rule = DerivedRules.AddDefaulted_GetRef();
+		Rule.Attribute = Attribute;
+		Rule.Source = Source;
+		Rule.Base = Base;
+		Rule.PerPoint = PerPoint;
+	};
+
+	AddRule(EPlayerAttribute::MaxHealth,       EPlayerAttribute::Strength,  80.f, 10.f);
+	AddRule(EPlayerAttribute::MaxStamina,      EPlayerAttribute::Endurance, 80.f, 10.f);
+	AddRule(EPlayerAttribute::MaxMagic,        EPlayerAttribute::Willpower, 60.f, 12.f);
+	AddRule(EPlayerAttribute::DamageOutput,    EPlayerAttribute::Strength,  10.f, 2.f);
+	AddRule(EPlayerAttribute::DamageReduction, EPlayerAttribute::Endurance, 0.f,  0.5f);
 }
 
 void UPlayerStatsComponent::BeginPlay()
 {
 	Super::BeginPlay();
-	RecalculateDerivedStats(true);
-	OnStatsChanged.Broadcast();
+
+	{
+		// One transaction so the initial recalc and the full refresh go out as a single broadcast
+		FScopedStatTransaction Transaction(this);
+		RecalculateDerivedStats(true);
+		MarkChanged(EPlayerStatFlags::All);
+	}
+	CaptureDisplaySnapshot();
+}
+
+void UPlayerStatsComponent::CaptureDisplaySnapshot()
+{
+	DisplayPrevHealth = Health;
+	DisplayPrevStamina = Stamina;
+	DisplayPrevMagic = Magic;
+}
+
+bool UPlayerStatsComponent::IsDisplayInterpolating() const
+{
+	return DisplayAlpha < 1.f
+		&& (DisplayPrevHealth != Health || DisplayPrevStamina != Stamina || DisplayPrevMagic != Magic);
+}
+
+void UPlayerStatsComponent::BeginTransaction()
+{
+	++TransactionDepth;
+}
+
+void UPlayerStatsComponent::EndTransaction()
+{
+	check(TransactionDepth > 0);
+	if (--TransactionDepth == 0)
+	{
+		CommitTransaction();
+	}
+}
+
+void UPlayerStatsComponent::MarkChanged(EPlayerStatFlags Flags)
+{
+	if (TransactionDepth > 0)
+	{
+		PendingChanges |= Flags;
+		return;
+	}
+
+	if (Flags != EPlayerStatFlags::None)
+	{
+		OnStatsChanged.Broadcast(int32(Flags));
+	}
+}
+
+void UPlayerStatsComponent::CommitTransaction()
+{
+	EPlayerStatFlags Changed = PendingChanges;
+	PendingChanges = EPlayerStatFlags::None;
+
+	const float OldHealth = Health;
+	const float OldStamina = Stamina;
+	const float OldMagic = Magic;
+
+	// New max values first so the deltas below clamp against them
+	FlushAttributes(Changed);
+
+	// Health first: it sets how much stamina is available
+	Health = ClampToRange(Health + PendingHealthDelta, MaxHealth);
+	Magic = ClampToRange(Magic + PendingMagicDelta, MaxMagic);
+	Stamina = FMath::Clamp(Stamina + PendingStaminaDelta, 0.f, GetAvailableStaminaMax());
+
+	PendingHealthDelta = 0.f;
+	PendingStaminaDelta = 0.f;
+	PendingMagicDelta = 0.f;
+
+	if (FMath::IsNearlyEqual(Health, OldHealth)) Health = OldHealth; else Changed |= EPlayerStatFlags::Health;
+	if (FMath::IsNearlyEqual(Stamina, OldStamina)) Stamina = OldStamina; else Changed |= EPlayerStatFlags::Stamina;
+	if (FMath::IsNearlyEqual(Magic, OldMagic)) Magic = OldMagic; else Changed |= EPlayerStatFlags::Magic;
+
+	if (EnumHasAnyFlags(Changed, EPlayerStatFlags::Health) && Health <= 0.f && !bHasDiedBroadcast)
+	{
+		bHasDiedBroadcast = true;
+		OnDied.Broadcast();
+	}
+
+	if (Changed != EPlayerStatFlags::None)
+	{
+		OnStatsChanged.Broadcast(int32(Changed));
+	}
 }
 
 void UPlayerStatsComponent::ModifyCurrency(int32 Delta)
@@ -26,7 +126,7 @@ void UPlayerStatsComponent::ModifyCurrency(int32 Delta)
 	}
 
 	Currency = NewVal;
-	OnStatsChanged.Broadcast();
+	MarkChanged(EPlayerStatFlags::Currency);
 }
 
 bool UPlayerStatsComponent::SpendCurrency(int32 Cost)
@@ -42,7 +142,7 @@ bool UPlayerStatsComponent::SpendCurrency(int32 Cost)
 
 	Currency -= Cost;
 	Currency = FMath::Max(0, Currency);
-	OnStatsChanged.Broadcast();
+	MarkChanged(EPlayerStatFlags::Currency);
 	return true;
 }
 
@@ -85,92 +185,245 @@ float UPlayerStatsComponent::GetStaminaPercentOfAvailable() const
 	return SafePercent(Stamina, AvMax);
 }
 
-void UPlayerStatsComponent::ClampStaminaToAvailable(bool& bDidChange)
+// -------------------------
+// Attributes
+// -------------------------
+void UPlayerStatsComponent::BuildAttributeGraph()
 {
-	const float AvMax = GetAvailableStaminaMax();
-	const float NewStam = FMath::Clamp(Stamina, 0.f, AvMax);
+	FMemory::Memzero(AttributeDependents);
 
-	if (!FMath::IsNearlyEqual(NewStam, Stamina))
+	for (const FDerivedAttributeRule& Rule : DerivedRules)
 	{
-		Stamina = NewStam;
-		bDidChange = true;
+		// Recompute runs in enum order, so a rule reading something below itself would see stale values
+		if (Rule.Source >= Rule.Attribute || Rule.Attribute >= EPlayerAttribute::Count)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("PlayerStats: ignoring derived rule %s <- %s on %s (source must come before the attribute)"),
+				*UEnum::GetValueAsString(Rule.Attribute), *UEnum::GetValueAsString(Rule.Source), *GetNameSafe(GetOwner()));
+			continue;
+		}
+
+		AttributeDependents[uint8(Rule.Source)] |= 1u << uint8(Rule.Attribute);
 	}
+
+	bAttributeGraphBuilt = true;
 }
 
-void UPlayerStatsComponent::RecalculateDerivedStats(bool bKeepCurrentPercents)
+void UPlayerStatsComponent::MarkAttributeDirty(EPlayerAttribute Attribute)
+{
+	if (!bAttributeGraphBuilt)
+	{
+		BuildAttributeGraph();
+	}
+
+	DirtyAttributes |= 1u << uint8(Attribute);
+
+	// Dependents always sit later in the enum, so one forward pass closes over the whole chain
+	for (int32 i = uint8(Attribute); i < NumAttributes; ++i)
+	{
+		if (DirtyAttributes & (1u << i))
+		{
+			DirtyAttributes |= AttributeDependents[i];
+		}
+	}
+}
+
+int32* UPlayerStatsComponent::GetBaseAttributeField(EPlayerAttribute Attribute)
+{
+	switch (Attribute)
+	{
+	case EPlayerAttribute::Strength:  return &Strength;
+	case EPlayerAttribute::Endurance: return &Endurance;
+	case EPlayerAttribute::Willpower: return &Willpower;
+	case EPlayerAttribute::Luck:      return &Luck;
+	default:                          return nullptr;
+	}
+}
+
+float UPlayerStatsComponent::ComputeAttribute(EPlayerAttribute Attribute)
+{
+	const int32 Index = uint8(Attribute);
+
+	float Value = 0.f;
+	if (const int32* BaseField = GetBaseAttributeField(Attribute))
+	{
+		Value = float(*BaseField);
+	}
+	else
+	{
+		for (const FDerivedAttributeRule& Rule : DerivedRules)
+		{
+			if (Rule.Attribute == Attribute && Rule.Source < Attribute)
+			{
+				Value += Rule.Base + Rule.PerPoint * AttributeValues[uint8(Rule.Source)];
+			}
+		}
+	}
+
+	float Multiplier = 1.f;
+	for (const FAttributeModifier& Modifier : ModifierStacks[Index])
+	{
+		if (Modifier.Op == EAttributeModifierOp::Add)
+		{
+			Value += Modifier.Magnitude;
+		}
+		else
+		{
+			Multiplier *= Modifier.Magnitude;
+		}
+	}
+
+	return Value * Multiplier;
+}
+
+void UPlayerStatsComponent::FlushAttributes(EPlayerStatFlags& Changed)
 {
+	if (DirtyAttributes == 0)
+	{
+		return;
+	}
+
 	const float OldHP = GetHealthPercent();
 	const float OldSP = GetStaminaPercent();
 	const float OldMP = GetMagicPercent();
 
-	MaxHealth  = 80.f + Strength  * 10.f;
-	MaxStamina = 80.f + Endurance * 10.f;
-	MaxMagic   = 60.f + Willpower * 12.f;
+	bool bAnyChanged = false;
+	for (int32 i = 0; i < NumAttributes; ++i)
+	{
+		if (DirtyAttributes & (1u << i))
+		{
+			const float NewValue = ComputeAttribute(EPlayerAttribute(i));
+			bAnyChanged |= NewValue != AttributeValues[i];
+			AttributeValues[i] = NewValue;
+		}
+	}
+	DirtyAttributes = 0;
+
+	const bool bKeepPercents = bKeepPercentsOnFlush;
+	bKeepPercentsOnFlush = true;
+
+	if (!bAnyChanged)
+	{
+		return;
+	}
 
-	BaseDamageOutput = 10.f + Strength * 2.f;
-	BaseDamageReduction = Endurance * 0.5f;
+	MaxHealth = AttributeValues[uint8(EPlayerAttribute::MaxHealth)];
+	MaxStamina = AttributeValues[uint8(EPlayerAttribute::MaxStamina)];
+	MaxMagic = AttributeValues[uint8(EPlayerAttribute::MaxMagic)];
+	BaseDamageOutput = AttributeValues[uint8(EPlayerAttribute::DamageOutput)];
+	BaseDamageReduction = AttributeValues[uint8(EPlayerAttribute::DamageReduction)];
 
-	if (bKeepCurrentPercents)
+	if (bKeepPercents)
 	{
 		Health  = ClampToRange(MaxHealth  * OldHP, MaxHealth);
 		Stamina = ClampToRange(MaxStamina * OldSP, MaxStamina);
 		Magic   = ClampToRange(MaxMagic   * OldMP, MaxMagic);
 	}
-	else
+
+	// Plain clamping (and the available-stamina cap) happens with the rest of the commit
+	Changed |= EPlayerStatFlags::Attributes;
+}
+
+void UPlayerStatsComponent::RecalculateDerivedStats(bool bKeepCurrentPercents)
+{
+	FScopedStatTransaction Transaction(this);
+
+	bKeepPercentsOnFlush = bKeepCurrentPercents;
+	for (uint8 Attribute = 0; Attribute < uint8(EPlayerAttribute::Count); ++Attribute)
 	{
-		Health  = ClampToRange(Health,  MaxHealth);
-		Stamina = ClampToRange(Stamina, MaxStamina);
-		Magic   = ClampToRange(Magic,   MaxMagic);
+		if (GetBaseAttributeField(EPlayerAttribute(Attribute)))
+		{
+			MarkAttributeDirty(EPlayerAttribute(Attribute));
+		}
 	}
+}
 
-	bool bChanged = false;
-	ClampStaminaToAvailable(bChanged);
+void UPlayerStatsComponent::SetBaseAttribute(EPlayerAttribute Attribute, int32 Value)
+{
+	int32* BaseField = GetBaseAttributeField(Attribute);
+	if (!BaseField || *BaseField == Value)
+	{
+		return;
+	}
 
-	OnStatsChanged.Broadcast();
+	FScopedStatTransaction Transaction(this);
+	*BaseField = Value;
+	MarkAttributeDirty(Attribute);
 }
 
-void UPlayerStatsComponent::ModifyHealth(float Delta)
+int32 UPlayerStatsComponent::AddModifier(EPlayerAttribute Attribute, EAttributeModifierOp Op, float Magnitude, UObject* Source)
 {
-	float NewVal = ClampToRange(Health + Delta, MaxHealth);
-	if (FMath::IsNearlyEqual(NewVal, Health))
+	if (Attribute >= EPlayerAttribute::Count)
 	{
-		return;
+		return 0;
 	}
 
-	Health = NewVal;
+	FScopedStatTransaction Transaction(this);
 
-	bool bChanged = true;
-	ClampStaminaToAvailable(bChanged);
+	FAttributeModifier& Modifier = ModifierStacks[uint8(Attribute)].AddDefaulted_GetRef();
+	Modifier.Handle = NextModifierHandle++;
+	Modifier.Op = Op;
+	Modifier.Magnitude = Magnitude;
+	Modifier.Source = FObjectKey(Source);
 
-	if (Health <= 0.f && !bHasDiedBroadcast)
+	MarkAttributeDirty(Attribute);
+	return Modifier.Handle;
+}
+
+bool UPlayerStatsComponent::RemoveModifier(int32 Handle)
+{
+	for (int32 i = 0; i < NumAttributes; ++i)
 	{
-		bHasDiedBroadcast = true;
-		OnDied.Broadcast();
+		const int32 Index = ModifierStacks[i].IndexOfByPredicate([Handle](const FAttributeModifier& Modifier) { return Modifier.Handle == Handle; });
+		if (Index != INDEX_NONE)
+		{
+			FScopedStatTransaction Transaction(this);
+			ModifierStacks[i].RemoveAt(Index, EAllowShrinking::No);
+			MarkAttributeDirty(EPlayerAttribute(i));
+			return true;
+		}
 	}
-
-	OnStatsChanged.Broadcast();
+	return false;
 }
 
-void UPlayerStatsComponent::ModifyStamina(float Delta)
+int32 UPlayerStatsComponent::RemoveModifiersFromSource(UObject* Source)
 {
-	const float AvMax = GetAvailableStaminaMax();
-	const float NewVal = FMath::Clamp(Stamina + Delta, 0.f, AvMax);
+	if (!Source)
+	{
+		return 0;
+	}
+
+	FScopedStatTransaction Transaction(this);
 
-	if (!FMath::IsNearlyEqual(NewVal, Stamina))
+	const FObjectKey SourceKey(Source);
+	int32 Removed = 0;
+	for (int32 i = 0; i < NumAttributes; ++i)
 	{
-		Stamina = NewVal;
-		OnStatsChanged.Broadcast();
+		const int32 Count = ModifierStacks[i].RemoveAll([SourceKey](const FAttributeModifier& Modifier) { return Modifier.Source == SourceKey; });
+		if (Count > 0)
+		{
+			Removed += Count;
+			MarkAttributeDirty(EPlayerAttribute(i));
+		}
 	}
+	return Removed;
+}
+
+void UPlayerStatsComponent::ModifyHealth(float Delta)
+{
+	FScopedStatTransaction Transaction(this);
+	PendingHealthDelta += Delta;
+}
+
+void UPlayerStatsComponent::ModifyStamina(float Delta)
+{
+	FScopedStatTransaction Transaction(this);
+	PendingStaminaDelta += Delta;
 }
 
 void UPlayerStatsComponent::ModifyMagic(float Delta)
 {
-	const float NewVal = ClampToRange(Magic + Delta, MaxMagic);
-	if (!FMath::IsNearlyEqual(NewVal, Magic))
-	{
-		Magic = NewVal;
-		OnStatsChanged.Broadcast();
-	}
+	FScopedStatTransaction Transaction(this);
+	PendingMagicDelta += Delta;
 }
 
 float UPlayerStatsComponent::ApplyDamage(float RawDamage, AActor* DamageInstigator)
@@ -186,10 +439,12 @@ float UPlayerStatsComponent::ApplyDamage(float RawDamage, AActor* DamageInstigat
 		return 0.f;
 	}
 
-	const float OldHealth = Health;
+	// Health may not move until an outer transaction commits, so work the result out from the pending total
+	const float HealthBefore = ClampToRange(Health + PendingHealthDelta, MaxHealth);
+	const float HealthAfter = ClampToRange(HealthBefore - Mitigated, MaxHealth);
 	ModifyHealth(-Mitigated);
 
-	const float Actual = FMath::Max(0.f, OldHealth - Health);
+	const float Actual = FMath::Max(0.f, HealthBefore - HealthAfter);
 	if (Actual > 0.f)
 	{
 		OnDamaged.Broadcast(Actual, DamageInstigator);
@@ -202,53 +457,24 @@ void UPlayerStatsComponent::TickStamina(float DeltaSeconds, bool bWantsSprint, b
 {
 	if (DeltaSeconds <= 0.f) return;
 
-	bool bAnyChanged = false;
+	// Regen, drain and the available-stamina clamp all land in one commit
+	FScopedStatTransaction Transaction(this);
 
 	if (!bIsMoving && Health < MaxHealth && HealthRegenPerSecond_Standing > 0.f && !IsDead())
 	{
-		const float Regen = HealthRegenPerSecond_Standing * DeltaSeconds;
-		const float NewH = ClampToRange(Health + Regen, MaxHealth);
-		if (!FMath::IsNearlyEqual(NewH, Health))
-		{
-			Health = NewH;
-			bAnyChanged = true;
-		}
+		PendingHealthDelta += HealthRegenPerSecond_Standing * DeltaSeconds;
 	}
 
 	if (bWantsSprint && bIsMoving && Stamina > 0.f)
 	{
-		const float Drain = StaminaDrainPerSecond_Sprinting * DeltaSeconds;
-		const float NewS = FMath::Clamp(Stamina - Drain, 0.f, GetAvailableStaminaMax());
-		if (!FMath::IsNearlyEqual(NewS, Stamina))
-		{
-			Stamina = NewS;
-			bAnyChanged = true;
-		}
-
-		if (bAnyChanged) OnStatsChanged.Broadcast();
+		PendingStaminaDelta -= StaminaDrainPerSecond_Sprinting * DeltaSeconds;
 		return;
 	}
 
 	const float BaseRegen = bIsMoving ? StaminaRegenPerSecond_Moving : StaminaRegenPerSecond_Standing;
 	const float Regen = FMath::Max(0.f, BaseRegen * RegenMultiplier);
 
-	if (Regen > 0.f)
-	{
-		const float AvMax = GetAvailableStaminaMax();
-		const float NewS = FMath::Clamp(Stamina + (Regen * DeltaSeconds), 0.f, AvMax);
-		if (!FMath::IsNearlyEqual(NewS, Stamina))
-		{
-			Stamina = NewS;
-			bAnyChanged = true;
-		}
-	}
-
-	ClampStaminaToAvailable(bAnyChanged);
-
-	if (bAnyChanged)
-	{
-		OnStatsChanged.Broadcast();
-	}
+	PendingStaminaDelta += Regen * DeltaSeconds;
 }
 
 void UPlayerStatsComponent::TickMagic(float DeltaSeconds, float RegenMultiplier)
@@ -259,10 +485,5 @@ void UPlayerStatsComponent::TickMagic(float DeltaSeconds, float RegenMultiplier)
 	const float Regen = FMath::Max(0.f, MagicRegenPerSecond * RegenMultiplier);
 	if (Regen <= 0.f) return;
 
-	const float NewVal = ClampToRange(Magic + (Regen * DeltaSeconds), MaxMagic);
-	if (!FMath::IsNearlyEqual(NewVal, Magic))
-	{
-		Magic = NewVal;
-		OnStatsChanged.Broadcast();
-	}
+	ModifyMagic(Regen * DeltaSeconds);
 }
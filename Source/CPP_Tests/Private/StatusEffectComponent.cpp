@@ -1,6 +1,7 @@
 #include "StatusEffectComponent.h"
 
-#include "PlayerStatsComponent.h"
+#include "StatusEffectSubsystem.h"
+#include "Engine/World.h"
 #include "Math/UnrealMathUtility.h"
 
 UStatusEffectComponent::UStatusEffectComponent()
@@ -11,185 +12,218 @@ UStatusEffectComponent::UStatusEffectComponent()
 void UStatusEffectComponent::BeginPlay()
 {
     Super::BeginPlay();
-}
 
-void UStatusEffectComponent::BroadcastIfChanged(bool& bAnyChanged)
-{
-    bAnyChanged = true;
+    ApplyTuning();
+    NotifyEffectsChanged(false);
 }
 
-void UStatusEffectComponent::ApplyPoisonExposure()
+void UStatusEffectComponent::ApplyTuning()
 {
-    PoisonTimeRemaining = PoisonPostExposureDuration;
-    OnEffectsChanged.Broadcast();
-}
+    for (TObjectPtr<UStatusEffectDataAsset>& Tuned : TunedDefinitions)
+    {
+        Tuned = nullptr;
+    }
 
-void UStatusEffectComponent::AddFearPoints(float Points)
-{
-    if (Points <= 0.f) return;
-    bFearExposedThisFrame = true;
-    FearPoints = FMath::Max(0.f, FearPoints + Points);
-    OnEffectsChanged.Broadcast();
-}
+    const UStatusEffectSubsystem* Effects = GetEffectSubsystem();
+    if (!Effects) return;
 
-void UStatusEffectComponent::ApplyBurn(bool bEnableBurn)
-{
-    if (bBurned != bEnableBurn)
+    // The native defaults are the built-in numbers, so only types someone actually retuned get a copy
+    const UStatusEffectComponent* Defaults = GetDefault<UStatusEffectComponent>();
+
+    auto MakeTuned = [this, Effects](EStatusEffectType Type) -> UStatusEffectDataAsset*
     {
-        bBurned = bEnableBurn;
-        OnEffectsChanged.Broadcast();
+        const UStatusEffectDataAsset* Shared = Effects->GetDefinition(Type);
+        if (!Shared) return nullptr;
+
+        UStatusEffectDataAsset* Tuned = DuplicateObject<UStatusEffectDataAsset>(Shared, this);
+        TunedDefinitions[uint8(Type)] = Tuned;
+        return Tuned;
+    };
+
+    if (PoisonDamagePerSecond != Defaults->PoisonDamagePerSecond || PoisonPostExposureDuration != Defaults->PoisonPostExposureDuration)
+    {
+        if (UStatusEffectDataAsset* Poison = MakeTuned(EStatusEffectType::Poison))
+        {
+            Poison->HealthDamagePerSecond = PoisonDamagePerSecond;
+            Poison->ExposureAmount = PoisonPostExposureDuration;
+        }
     }
-}
 
-void UStatusEffectComponent::AddFrostPoints(float Points)
-{
-    if (Points <= 0.f) return;
-    bFrostExposedThisFrame = true;
-    FrostPoints = FMath::Max(0.f, FrostPoints + Points);
-    OnEffectsChanged.Broadcast();
-}
+    if (FearDecayPerSecond != Defaults->FearDecayPerSecond || FearRegenPenaltyPerPoint != Defaults->FearRegenPenaltyPerPoint
+        || FearMovePenaltyPerPoint != Defaults->FearMovePenaltyPerPoint)
+    {
+        if (UStatusEffectDataAsset* Fear = MakeTuned(EStatusEffectType::Fear))
+        {
+            Fear->DecayPerSecond = FearDecayPerSecond;
+            Fear->RegenPenaltyPerPoint = FearRegenPenaltyPerPoint;
+            Fear->MoveSpeedPenaltyPerPoint = FearMovePenaltyPerPoint;
+        }
+    }
 
-void UStatusEffectComponent::AddBleedPoints(float Points)
-{
-    if (Points <= 0.f) return;
-    bBleedExposedThisFrame = true;
-    BleedPoints = FMath::Max(0.f, BleedPoints + Points);
-    OnEffectsChanged.Broadcast();
-}
+    if (BurnMoveDamagePerSecond != Defaults->BurnMoveDamagePerSecond)
+    {
+        if (UStatusEffectDataAsset* Burn = MakeTuned(EStatusEffectType::Burn))
+        {
+            Burn->HealthDamagePerSecond = BurnMoveDamagePerSecond;
+        }
+    }
 
-void UStatusEffectComponent::AddStatusPoints(EStatusEffectType Type, float Points)
-{
-    switch (Type)
+    if (FrostStaminaDrainPerSecond != Defaults->FrostStaminaDrainPerSecond || FrostHealthDamagePerSecond_IfNoStamina != Defaults->FrostHealthDamagePerSecond_IfNoStamina
+        || FrostDecayPerSecond != Defaults->FrostDecayPerSecond)
+    {
+        if (UStatusEffectDataAsset* Frost = MakeTuned(EStatusEffectType::Frost))
+        {
+            Frost->StaminaDrainPerSecond = FrostStaminaDrainPerSecond;
+            Frost->HealthDamagePerSecondWhenNoStamina = FrostHealthDamagePerSecond_IfNoStamina;
+            Frost->DecayPerSecond = FrostDecayPerSecond;
+        }
+    }
+
+    if (BleedHealthDamagePerSecondPerPoint != Defaults->BleedHealthDamagePerSecondPerPoint || BleedStaminaDrainPerSecondPerPoint != Defaults->BleedStaminaDrainPerSecondPerPoint
+        || BleedDecayPerSecond != Defaults->BleedDecayPerSecond)
     {
-        case EStatusEffectType::Poison: ApplyPoisonExposure(); break;
-        case EStatusEffectType::Fear:   AddFearPoints(Points); break;
-        case EStatusEffectType::Burn:   ApplyBurn(Points > 0.f); break;
-        case EStatusEffectType::Frost:  AddFrostPoints(Points); break;
-        case EStatusEffectType::Bleed:  AddBleedPoints(Points); break;
-        default: break;
+        if (UStatusEffectDataAsset* Bleed = MakeTuned(EStatusEffectType::Bleed))
+        {
+            Bleed->HealthDamagePerSecondPerPoint = BleedHealthDamagePerSecondPerPoint;
+            Bleed->StaminaDrainPerSecondPerPoint = BleedStaminaDrainPerSecondPerPoint;
+            Bleed->DecayPerSecond = BleedDecayPerSecond;
+        }
     }
 }
 
-void UStatusEffectComponent::ClearAll()
+const UStatusEffectDataAsset* UStatusEffectComponent::GetDefinition(EStatusEffectType Type) const
 {
-    PoisonTimeRemaining = 0.f;
-    FearPoints = 0.f;
-    bBurned = false;
-    FrostPoints = 0.f;
-    BleedPoints = 0.f;
+    const uint8 Index = uint8(Type);
+    if (Index < UE_ARRAY_COUNT(TunedDefinitions) && TunedDefinitions[Index])
+    {
+        return TunedDefinitions[Index];
+    }
 
-    OnEffectsChanged.Broadcast();
+    const UStatusEffectSubsystem* Effects = GetEffectSubsystem();
+    return Effects ? Effects->GetDefinition(Type) : nullptr;
 }
 
-float UStatusEffectComponent::GetMoveSpeedMultiplier() const
+void UStatusEffectComponent::NotifyEffectsChanged(bool bBroadcast)
 {
-    float Mult = 1.f;
+    PoisonTimeRemaining = GetMagnitude(EStatusEffectType::Poison);
+    FearPoints = GetMagnitude(EStatusEffectType::Fear);
+    bBurned = GetMagnitude(EStatusEffectType::Burn) > 0.f;
+    FrostPoints = GetMagnitude(EStatusEffectType::Frost);
+    BleedPoints = GetMagnitude(EStatusEffectType::Bleed);
 
-    if (FearPoints > 0.f)
+    if (bBroadcast)
     {
-        Mult -= (FearPoints * FearMovePenaltyPerPoint);
+        OnEffectsChanged.Broadcast();
     }
+}
 
-    if (FrostPoints > 0.f)
-    {
-        Mult -= (FrostPoints * 0.002f);
-    }
+UStatusEffectSubsystem* UStatusEffectComponent::GetEffectSubsystem() const
+{
+    const UWorld* World = GetWorld();
+    return World ? World->GetSubsystem<UStatusEffectSubsystem>() : nullptr;
+}
 
-    return FMath::Clamp(Mult, MinMoveMultiplier, 1.f);
+float UStatusEffectComponent::GetMagnitude(EStatusEffectType Type) const
+{
+    const UStatusEffectSubsystem* Effects = GetEffectSubsystem();
+    return Effects ? Effects->GetMagnitude(GetOwner(), GetDefinition(Type)) : 0.f;
 }
 
-float UStatusEffectComponent::GetStaminaRegenMultiplier() const
+void UStatusEffectComponent::ApplyEffect(UStatusEffectDataAsset* Effect, float Amount)
 {
-    float Mult = 1.f;
-    if (FearPoints > 0.f)
+    if (UStatusEffectSubsystem* Effects = GetEffectSubsystem())
     {
-        Mult -= (FearPoints * FearRegenPenaltyPerPoint);
+        Effects->ApplyEffect(GetOwner(), Effect, Amount);
     }
-    return FMath::Clamp(Mult, 0.f, 1.f);
 }
 
-float UStatusEffectComponent::GetMagicRegenMultiplier() const
+void UStatusEffectComponent::RemoveEffect(UStatusEffectDataAsset* Effect)
 {
-    float Mult = 1.f;
-    if (FearPoints > 0.f)
+    if (UStatusEffectSubsystem* Effects = GetEffectSubsystem())
     {
-        Mult -= (FearPoints * FearRegenPenaltyPerPoint);
+        Effects->RemoveEffect(GetOwner(), Effect);
     }
-    return FMath::Clamp(Mult, 0.f, 1.f);
 }
 
-void UStatusEffectComponent::TickEffects(float DeltaSeconds, UPlayerStatsComponent* Stats, bool bIsMoving)
+float UStatusEffectComponent::GetEffectMagnitude(UStatusEffectDataAsset* Effect) const
 {
-    if (!Stats || DeltaSeconds <= 0.f)
-    {
-        bFearExposedThisFrame = false;
-        bFrostExposedThisFrame = false;
-        bBleedExposedThisFrame = false;
-        return;
-    }
+    const UStatusEffectSubsystem* Effects = GetEffectSubsystem();
+    return Effects ? Effects->GetMagnitude(GetOwner(), Effect) : 0.f;
+}
 
-    bool bAnyChanged = false;
+void UStatusEffectComponent::ApplyPoisonExposure()
+{
+    AddStatusPoints(EStatusEffectType::Poison, 1.f);
+}
 
-    if (PoisonTimeRemaining > 0.f)
-    {
-        PoisonTimeRemaining = FMath::Max(0.f, PoisonTimeRemaining - DeltaSeconds);
-        Stats->ModifyHealth(-PoisonDamagePerSecond * DeltaSeconds);
-        BroadcastIfChanged(bAnyChanged);
-    }
+void UStatusEffectComponent::AddFearPoints(float Points)
+{
+    AddStatusPoints(EStatusEffectType::Fear, Points);
+}
 
-    if (FearPoints > 0.f && !bFearExposedThisFrame)
+void UStatusEffectComponent::ApplyBurn(bool bEnableBurn)
+{
+    if (bEnableBurn)
     {
-        FearPoints = FMath::Max(0.f, FearPoints - (FearDecayPerSecond * DeltaSeconds));
-        BroadcastIfChanged(bAnyChanged);
+        AddStatusPoints(EStatusEffectType::Burn, 1.f);
     }
-
-    if (bBurned && bIsMoving)
+    else if (UStatusEffectSubsystem* Effects = GetEffectSubsystem())
     {
-        Stats->ModifyHealth(-BurnMoveDamagePerSecond * DeltaSeconds);
-        BroadcastIfChanged(bAnyChanged);
+        Effects->RemoveEffect(GetOwner(), GetDefinition(EStatusEffectType::Burn));
     }
+}
 
-    if (FrostPoints > 0.f)
-    {
-        if (Stats->Stamina > 0.f)
-        {
-            Stats->ModifyStamina(-FrostStaminaDrainPerSecond * DeltaSeconds);
-        }
-        else
-        {
-            Stats->ModifyHealth(-FrostHealthDamagePerSecond_IfNoStamina * DeltaSeconds);
-        }
-        BroadcastIfChanged(bAnyChanged);
-    }
+void UStatusEffectComponent::AddFrostPoints(float Points)
+{
+    AddStatusPoints(EStatusEffectType::Frost, Points);
+}
 
-    if (FrostPoints > 0.f && !bFrostExposedThisFrame)
+void UStatusEffectComponent::AddBleedPoints(float Points)
+{
+    AddStatusPoints(EStatusEffectType::Bleed, Points);
+}
+
+void UStatusEffectComponent::AddStatusPoints(EStatusEffectType Type, float Points)
+{
+    if (UStatusEffectSubsystem* Effects = GetEffectSubsystem())
     {
-        FrostPoints = FMath::Max(0.f, FrostPoints - (FrostDecayPerSecond * DeltaSeconds));
-        BroadcastIfChanged(bAnyChanged);
+        Effects->ApplyEffect(GetOwner(), GetDefinition(Type), Points);
     }
+}
 
-    if (BleedPoints > 0.f)
+void UStatusEffectComponent::HoldExposure(EStatusEffectType Type, float Seconds)
+{
+    if (UStatusEffectSubsystem* Effects = GetEffectSubsystem())
     {
-        const float HealthDPS = BleedPoints * BleedHealthDamagePerSecondPerPoint;
-        const float StamDPS = BleedPoints * BleedStaminaDrainPerSecondPerPoint;
-
-        Stats->ModifyHealth(-HealthDPS * DeltaSeconds);
-        Stats->ModifyStamina(-StamDPS * DeltaSeconds);
-        BroadcastIfChanged(bAnyChanged);
+        Effects->HoldExposure(GetOwner(), GetDefinition(Type), Seconds);
     }
+}
 
-    if (BleedPoints > 0.f && !bBleedExposedThisFrame)
+void UStatusEffectComponent::ClearAll()
+{
+    if (UStatusEffectSubsystem* Effects = GetEffectSubsystem())
     {
-        BleedPoints = FMath::Max(0.f, BleedPoints - (BleedDecayPerSecond * DeltaSeconds));
-        BroadcastIfChanged(bAnyChanged);
+        Effects->ClearEffects(GetOwner());
     }
 
-    bFearExposedThisFrame = false;
-    bFrostExposedThisFrame = false;
-    bBleedExposedThisFrame = false;
+    NotifyEffectsChanged();
+}
+
+float UStatusEffectComponent::GetMoveSpeedMultiplier() const
+{
+    const UStatusEffectSubsystem* Effects = GetEffectSubsystem();
+    const float Penalty = Effects ? Effects->GetMoveSpeedPenalty(GetOwner()) : 0.f;
+    return FMath::Clamp(1.f - Penalty, MinMoveMultiplier, 1.f);
+}
 
-    if (bAnyChanged)
-    {
-        OnEffectsChanged.Broadcast();
-    }
+float UStatusEffectComponent::GetStaminaRegenMultiplier() const
+{
+    const UStatusEffectSubsystem* Effects = GetEffectSubsystem();
+    const float Penalty = Effects ? Effects->GetRegenPenalty(GetOwner()) : 0.f;
+    return FMath::Clamp(1.f - Penalty, 0.f, 1.f);
+}
+
+float UStatusEffectComponent::GetMagicRegenMultiplier() const
+{
+    return GetStaminaRegenMultiplier();
 }
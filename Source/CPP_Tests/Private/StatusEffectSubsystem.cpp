@@ -0,0 +1,758 @@
+#include "StatusEffectSubsystem.h"
+
+#include "CPP_TestsStats.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "NPCCharacter.h"
+#include "PlayerStatsComponent.h"
+#include "StatusEffectComponent.h"
+
+void UStatusEffectSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	LLM_SCOPE_BYTAG(CPPTests_StatusEffects);
+	Super::Initialize(Collection);
+
+	for (const TSoftObjectPtr<UStatusEffectDataAsset>& Soft : DefaultEffects)
+	{
+		if (UStatusEffectDataAsset* Effect = Soft.LoadSynchronous())
+		{
+			AddDefinition(Effect);
+		}
+	}
+
+	// Whatever the config didn't cover keeps the old hard-coded numbers
+	for (uint8 Type = uint8(EStatusEffectType::Poison); Type <= uint8(EStatusEffectType::Bleed); ++Type)
+	{
+		if (LegacyDefinitions[Type] == INDEX_NONE)
+		{
+			AddDefinition(MakeBuiltInDefinition(EStatusEffectType(Type)));
+		}
+	}
+}
+
+void UStatusEffectSubsystem::Deinitialize()
+{
+	Definitions.Reset();
+	Params.Reset();
+	DefinitionLookup.Reset();
+
+	EntActor.Reset();
+	EntStats.Reset();
+	EntNPC.Reset();
+	EntComponent.Reset();
+	EntInstances.Reset();
+	EntStepStamp.Reset();
+	EntHasStamina.Reset();
+	EntMoving.Reset();
+	EntHealthDelta.Reset();
+	EntStaminaDelta.Reset();
+	EntityLookup.Reset();
+	Observed.Reset();
+
+	InstEntity.Reset();
+	InstDef.Reset();
+	InstValue.Reset();
+	InstDecayStart.Reset();
+	InstSerial.Reset();
+	InstTickSlot.Reset();
+	TickingInstances.Reset();
+	StepTouched.Reset();
+	Expiries.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UStatusEffectSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UStatusEffectSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UStatusEffectSubsystem, STATGROUP_Tickables);
+}
+
+// -------------------------
+// Definitions
+// -------------------------
+UStatusEffectDataAsset* UStatusEffectSubsystem::MakeBuiltInDefinition(EStatusEffectType Type)
+{
+	UStatusEffectDataAsset* Effect = NewObject<UStatusEffectDataAsset>(this);
+	Effect->LegacyType = Type;
+	Effect->DisplayName = UEnum::GetDisplayValueAsText(Type);
+
+	switch (Type)
+	{
+	case EStatusEffectType::Poison:
+		Effect->Stacking = EStatusEffectStacking::Refresh;
+		Effect->ExposureAmount = 10.0f; // seconds of poison after leaving the source
+		Effect->bPauseDecayWhileExposed = false;
+		Effect->HealthDamagePerSecond = 3.0f;
+		break;
+
+	case EStatusEffectType::Fear:
+		Effect->MoveSpeedPenaltyPerPoint = 0.01f;
+		Effect->RegenPenaltyPerPoint = 0.01f;
+		break;
+
+	case EStatusEffectType::Burn:
+		Effect->Stacking = EStatusEffectStacking::Refresh;
+		Effect->DecayPerSecond = 0.0f; // sticks until healed
+		Effect->HealthDamagePerSecond = 2.0f;
+		Effect->bDamageOnlyWhileMoving = true;
+		break;
+
+	case EStatusEffectType::Frost:
+		Effect->StaminaDrainPerSecond = 15.0f;
+		Effect->HealthDamagePerSecondWhenNoStamina = 4.0f;
+		Effect->MoveSpeedPenaltyPerPoint = 0.002f;
+		break;
+
+	case EStatusEffectType::Bleed:
+		Effect->HealthDamagePerSecondPerPoint = 0.05f;
+		Effect->StaminaDrainPerSecondPerPoint = 0.02f;
+		break;
+
+	default:
+		break;
+	}
+
+	return Effect;
+}
+
+void UStatusEffectSubsystem::AddDefinition(UStatusEffectDataAsset* Effect)
+{
+	if (!Effect || DefinitionLookup.Contains(Effect))
+	{
+		return;
+	}
+
+	const int32 Index = Definitions.Add(Effect);
+	DefinitionLookup.Add(Effect, Index);
+
+	FStatusEffectParams& P = Params.AddDefaulted_GetRef();
+	P.ExposureAmount = Effect->ExposureAmount;
+	P.MaxMagnitude = Effect->MaxMagnitude;
+	P.DecayPerSecond = Effect->DecayPerSecond;
+	P.HealthPerSecond = Effect->HealthDamagePerSecond;
+	P.HealthPerSecondPerPoint = Effect->HealthDamagePerSecondPerPoint;
+	P.StaminaPerSecond = Effect->StaminaDrainPerSecond;
+	P.StaminaPerSecondPerPoint = Effect->StaminaDrainPerSecondPerPoint;
+	P.HealthPerSecondWhenNoStamina = Effect->HealthDamagePerSecondWhenNoStamina;
+	P.MovePenaltyPerPoint = Effect->MoveSpeedPenaltyPerPoint;
+	P.RegenPenaltyPerPoint = Effect->RegenPenaltyPerPoint;
+	P.bRefresh = Effect->Stacking == EStatusEffectStacking::Refresh;
+	P.bPauseDecayWhileExposed = Effect->bPauseDecayWhileExposed;
+	P.bOnlyWhileMoving = Effect->bDamageOnlyWhileMoving;
+	P.bTicks = P.HealthPerSecond > 0.0f || P.HealthPerSecondPerPoint > 0.0f || P.StaminaPerSecond > 0.0f
+		|| P.StaminaPerSecondPerPoint > 0.0f || P.HealthPerSecondWhenNoStamina > 0.0f;
+
+	const uint8 Legacy = uint8(Effect->LegacyType);
+	if (Legacy != uint8(EStatusEffectType::None) && Legacy < UE_ARRAY_COUNT(LegacyDefinitions) && LegacyDefinitions[Legacy] == INDEX_NONE)
+	{
+		LegacyDefinitions[Legacy] = Index;
+	}
+}
+
+int32 UStatusEffectSubsystem::FindOrAddDefinition(const UStatusEffectDataAsset* Effect)
+{
+	if (!Effect)
+	{
+		return INDEX_NONE;
+	}
+
+	if (const int32* Index = DefinitionLookup.Find(Effect))
+	{
+		return *Index;
+	}
+
+	// Assets nobody listed in config are picked up the first time they're applied
+	AddDefinition(const_cast<UStatusEffectDataAsset*>(Effect));
+	return Definitions.Num() - 1;
+}
+
+const UStatusEffectDataAsset* UStatusEffectSubsystem::GetDefinition(EStatusEffectType Type) const
+{
+	const uint8 Legacy = uint8(Type);
+	if (Legacy >= UE_ARRAY_COUNT(LegacyDefinitions) || LegacyDefinitions[Legacy] == INDEX_NONE)
+	{
+		return nullptr;
+	}
+	return Definitions[LegacyDefinitions[Legacy]];
+}
+
+const UStatusEffectDataAsset* UStatusEffectSubsystem::GetDefinitionFor(const AActor* Target, EStatusEffectType Type) const
+{
+	// The actor's component may carry its own tuned copy
+	const int32 Entity = FindEntity(Target);
+	const UStatusEffectComponent* Component = Entity != INDEX_NONE ? EntComponent[Entity].Get()
+		: (Target ? Target->FindComponentByClass<UStatusEffectComponent>() : nullptr);
+	return Component ? Component->GetDefinition(Type) : GetDefinition(Type);
+}
+
+// -------------------------
+// Entities / instances
+// -------------------------
+int32 UStatusEffectSubsystem::FindEntity(const AActor* Target) const
+{
+	const int32* Index = Target ? EntityLookup.Find(Target) : nullptr;
+	return Index ? *Index : INDEX_NONE;
+}
+
+int32 UStatusEffectSubsystem::FindOrAddEntity(AActor* Target)
+{
+	LLM_SCOPE_BYTAG(CPPTests_StatusEffects);
+
+	const int32 Existing = FindEntity(Target);
+	if (Existing != INDEX_NONE)
+	{
+		return Existing;
+	}
+
+	UStatusEffectComponent* Component = Target->FindComponentByClass<UStatusEffectComponent>();
+
+	const int32 Index = EntActor.Add(Target);
+	EntStats.Add(Target->FindComponentByClass<UPlayerStatsComponent>());
+	EntNPC.Add(Cast<ANPCCharacter>(Target));
+	EntComponent.Add(Component);
+	EntInstances.AddDefaulted();
+	EntStepStamp.Add(0);
+	EntHasStamina.Add(0);
+	EntMoving.Add(0);
+	EntHealthDelta.Add(0.0f);
+	EntStaminaDelta.Add(0.0f);
+	EntityLookup.Add(Target, Index);
+
+	if (Component)
+	{
+		Observed.AddUnique(Target);
+	}
+
+	return Index;
+}
+
+void UStatusEffectSubsystem::RemoveEntityAt(int32 Entity)
+{
+	while (EntInstances[Entity].Num() > 0)
+	{
+		RemoveInstanceAt(EntInstances[Entity].Last());
+	}
+
+	const int32 Last = EntActor.Num() - 1;
+
+	EntityLookup.Remove(EntActor[Entity]);
+	Observed.RemoveSwap(EntActor[Entity], EAllowShrinking::No);
+
+	// The last entity moves into this slot; its effects follow it
+	if (Entity != Last)
+	{
+		EntityLookup.Add(EntActor[Last], Entity);
+
+		for (const int32 Instance : EntInstances[Last])
+		{
+			InstEntity[Instance] = Entity;
+		}
+	}
+
+	EntActor.RemoveAtSwap(Entity, EAllowShrinking::No);
+	EntStats.RemoveAtSwap(Entity, EAllowShrinking::No);
+	EntNPC.RemoveAtSwap(Entity, EAllowShrinking::No);
+	EntComponent.RemoveAtSwap(Entity, EAllowShrinking::No);
+	EntInstances.RemoveAtSwap(Entity, EAllowShrinking::No);
+	EntStepStamp.RemoveAtSwap(Entity, EAllowShrinking::No);
+	EntHasStamina.RemoveAtSwap(Entity, EAllowShrinking::No);
+	EntMoving.RemoveAtSwap(Entity, EAllowShrinking::No);
+	EntHealthDelta.RemoveAtSwap(Entity, EAllowShrinking::No);
+	EntStaminaDelta.RemoveAtSwap(Entity, EAllowShrinking::No);
+}
+
+void UStatusEffectSubsystem::RemoveEntityIfEmpty(int32 Entity)
+{
+	// Write-back holds on to entity indices; it sweeps the empty ones itself when it's done
+	if (!bDeferEntityRemoval && EntInstances[Entity].Num() == 0)
+	{
+		RemoveEntityAt(Entity);
+	}
+}
+
+int32 UStatusEffectSubsystem::FindInstance(int32 Entity, int32 Def) const
+{
+	for (const int32 Instance : EntInstances[Entity])
+	{
+		if (InstDef[Instance] == Def)
+		{
+			return Instance;
+		}
+	}
+	return INDEX_NONE;
+}
+
+int32 UStatusEffectSubsystem::AddInstance(int32 Entity, int32 Def, double Now)
+{
+	LLM_SCOPE_BYTAG(CPPTests_StatusEffects);
+
+	const int32 Instance = InstEntity.Add(Entity);
+	InstDef.Add(Def);
+	InstValue.Add(0.0f);
+	InstDecayStart.Add(Now);
+	InstSerial.Add(++NextSerial);
+	InstTickSlot.Add(Params[Def].bTicks ? TickingInstances.Add(Instance) : INDEX_NONE);
+	EntInstances[Entity].Add(Instance);
+
+	return Instance;
+}
+
+void UStatusEffectSubsystem::RemoveInstanceAt(int32 Instance)
+{
+	EntInstances[InstEntity[Instance]].RemoveSwap(Instance, EAllowShrinking::No);
+
+	const int32 TickSlot = InstTickSlot[Instance];
+	if (TickSlot != INDEX_NONE)
+	{
+		TickingInstances.RemoveAtSwap(TickSlot, EAllowShrinking::No);
+		if (TickingInstances.IsValidIndex(TickSlot))
+		{
+			InstTickSlot[TickingInstances[TickSlot]] = TickSlot;
+		}
+	}
+
+	// The last instance moves into this slot; patch everything that points at it
+	const int32 Last = InstEntity.Num() - 1;
+	if (Instance != Last)
+	{
+		for (int32& Ref : EntInstances[InstEntity[Last]])
+		{
+			if (Ref == Last)
+			{
+				Ref = Instance;
+				break;
+			}
+		}
+
+		if (InstTickSlot[Last] != INDEX_NONE)
+		{
+			TickingInstances[InstTickSlot[Last]] = Instance;
+		}
+	}
+
+	// Any pending expiry for this instance is left in the heap; its serial no longer matches, so it's skipped
+	InstEntity.RemoveAtSwap(Instance, EAllowShrinking::No);
+	InstDef.RemoveAtSwap(Instance, EAllowShrinking::No);
+	InstValue.RemoveAtSwap(Instance, EAllowShrinking::No);
+	InstDecayStart.RemoveAtSwap(Instance, EAllowShrinking::No);
+	InstSerial.RemoveAtSwap(Instance, EAllowShrinking::No);
+	InstTickSlot.RemoveAtSwap(Instance, EAllowShrinking::No);
+}
+
+// -------------------------
+// Closed form
+// -------------------------
+double UStatusEffectSubsystem::GetNow() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetTimeSeconds() : 0.0;
+}
+
+float UStatusEffectSubsystem::EvaluateMagnitude(int32 Instance, double Time) const
+{
+	// Flat until the decay start (holds push it forward), then straight down to zero
+	const double Decayed = Params[InstDef[Instance]].DecayPerSecond * FMath::Max(0.0, Time - InstDecayStart[Instance]);
+	return FMath::Max(0.0f, InstValue[Instance] - float(Decayed));
+}
+
+double UStatusEffectSubsystem::GetExpiryTime(int32 Instance) const
+{
+	const float Rate = Params[InstDef[Instance]].DecayPerSecond;
+	return Rate > 0.0f ? InstDecayStart[Instance] + InstValue[Instance] / Rate : TNumericLimits<double>::Max();
+}
+
+void UStatusEffectSubsystem::Rebase(int32 Instance, float NewValue, double DecayStart)
+{
+	const FStatusEffectParams& P = Params[InstDef[Instance]];
+
+	if (P.MaxMagnitude > 0.0f)
+	{
+		NewValue = FMath::Min(NewValue, P.MaxMagnitude);
+	}
+
+	const bool bWasScheduled = P.DecayPerSecond > 0.0f && InstValue[Instance] > 0.0f;
+
+	InstValue[Instance] = FMath::Max(0.0f, NewValue);
+	InstDecayStart[Instance] = DecayStart;
+
+	// Expiry only ever moves later, so the entry already in the heap is re-queued when it comes due
+	if (!bWasScheduled && P.DecayPerSecond > 0.0f && InstValue[Instance] > 0.0f)
+	{
+		FStatusEffectExpiry Expiry;
+		Expiry.Time = GetExpiryTime(Instance);
+		Expiry.Actor = EntActor[InstEntity[Instance]].Get();
+		Expiry.Def = InstDef[Instance];
+		Expiry.Serial = InstSerial[Instance];
+		Expiries.HeapPush(Expiry);
+	}
+}
+
+// -------------------------
+// API
+// -------------------------
+void UStatusEffectSubsystem::ApplyEffect(AActor* Target, const UStatusEffectDataAsset* Effect, float Amount)
+{
+	const int32 Def = FindOrAddDefinition(Effect);
+	if (!IsValid(Target) || Def == INDEX_NONE)
+	{
+		return;
+	}
+
+	const FStatusEffectParams& P = Params[Def];
+	if (!P.bRefresh && Amount <= 0.0f)
+	{
+		return;
+	}
+
+	const double Now = GetNow();
+	const int32 Entity = FindOrAddEntity(Target);
+
+	int32 Instance = FindInstance(Entity, Def);
+	if (Instance == INDEX_NONE)
+	{
+		Instance = AddInstance(Entity, Def, Now);
+	}
+
+	const float Current = EvaluateMagnitude(Instance, Now);
+	const float NewValue = P.bRefresh ? FMath::Max(Current, P.ExposureAmount) : Current + Amount;
+
+	// Counts as exposure for one step, like the old per-frame flags
+	const double DecayStart = P.bPauseDecayWhileExposed
+		? FMath::Max(InstDecayStart[Instance], Now + 1.0 / FMath::Max(1.0f, StepHz))
+		: Now;
+
+	Rebase(Instance, NewValue, DecayStart);
+
+	if (UStatusEffectComponent* Component = EntComponent[Entity].Get())
+	{
+		Component->NotifyEffectsChanged();
+	}
+}
+
+void UStatusEffectSubsystem::ApplyEffect(AActor* Target, EStatusEffectType Type, float Amount)
+{
+	ApplyEffect(Target, GetDefinitionFor(Target, Type), Amount);
+}
+
+void UStatusEffectSubsystem::RemoveEffect(AActor* Target, const UStatusEffectDataAsset* Effect)
+{
+	const int32 Entity = FindEntity(Target);
+	const int32* Def = Effect ? DefinitionLookup.Find(Effect) : nullptr;
+	const int32 Instance = (Entity != INDEX_NONE && Def) ? FindInstance(Entity, *Def) : INDEX_NONE;
+	if (Instance == INDEX_NONE)
+	{
+		return;
+	}
+
+	UStatusEffectComponent* Component = EntComponent[Entity].Get();
+
+	RemoveInstanceAt(Instance);
+	RemoveEntityIfEmpty(Entity);
+
+	if (Component)
+	{
+		Component->NotifyEffectsChanged();
+	}
+}
+
+void UStatusEffectSubsystem::ClearEffects(AActor* Target)
+{
+	const int32 Entity = FindEntity(Target);
+	if (Entity == INDEX_NONE)
+	{
+		return;
+	}
+
+	UStatusEffectComponent* Component = EntComponent[Entity].Get();
+
+	while (EntInstances[Entity].Num() > 0)
+	{
+		RemoveInstanceAt(EntInstances[Entity].Last());
+	}
+	RemoveEntityIfEmpty(Entity);
+
+	if (Component)
+	{
+		Component->NotifyEffectsChanged();
+	}
+}
+
+void UStatusEffectSubsystem::HoldExposure(AActor* Target, const UStatusEffectDataAsset* Effect, float Seconds)
+{
+	const int32 Entity = FindEntity(Target);
+	const int32* Def = Effect ? DefinitionLookup.Find(Effect) : nullptr;
+	const int32 Instance = (Entity != INDEX_NONE && Def) ? FindInstance(Entity, *Def) : INDEX_NONE;
+	if (Instance == INDEX_NONE || !Params[*Def].bPauseDecayWhileExposed)
+	{
+		return;
+	}
+
+	// Freeze at the current value and start decaying again once the hold runs out
+	const double Now = GetNow();
+	const double HoldUntil = Now + Seconds;
+	if (HoldUntil > InstDecayStart[Instance])
+	{
+		Rebase(Instance, EvaluateMagnitude(Instance, Now), HoldUntil);
+	}
+}
+
+float UStatusEffectSubsystem::GetMagnitude(const AActor* Target, const UStatusEffectDataAsset* Effect) const
+{
+	const int32 Entity = FindEntity(Target);
+	const int32* Def = Effect ? DefinitionLookup.Find(Effect) : nullptr;
+	const int32 Instance = (Entity != INDEX_NONE && Def) ? FindInstance(Entity, *Def) : INDEX_NONE;
+	return Instance != INDEX_NONE ? EvaluateMagnitude(Instance, GetNow()) : 0.0f;
+}
+
+float UStatusEffectSubsystem::GetMoveSpeedPenalty(const AActor* Target) const
+{
+	const int32 Entity = FindEntity(Target);
+	if (Entity == INDEX_NONE)
+	{
+		return 0.0f;
+	}
+
+	const double Now = GetNow();
+	float Penalty = 0.0f;
+	for (const int32 Instance : EntInstances[Entity])
+	{
+		Penalty += EvaluateMagnitude(Instance, Now) * Params[InstDef[Instance]].MovePenaltyPerPoint;
+	}
+	return FMath::Max(0.0f, Penalty);
+}
+
+float UStatusEffectSubsystem::GetRegenPenalty(const AActor* Target) const
+{
+	const int32 Entity = FindEntity(Target);
+	if (Entity == INDEX_NONE)
+	{
+		return 0.0f;
+	}
+
+	const double Now = GetNow();
+	float Penalty = 0.0f;
+	for (const int32 Instance : EntInstances[Entity])
+	{
+		Penalty += EvaluateMagnitude(Instance, Now) * Params[InstDef[Instance]].RegenPenaltyPerPoint;
+	}
+	return FMath::Max(0.0f, Penalty);
+}
+
+// -------------------------
+// Update
+// -------------------------
+void UStatusEffectSubsystem::Tick(float DeltaTime)
+{
+	if (EntActor.Num() == 0)
+	{
+		// Nothing left for these to point at
+		Expiries.Reset();
+		StepAccumulator = 0.0f;
+		return;
+	}
+
+	const float Step = 1.0f / FMath::Max(1.0f, StepHz);
+	StepAccumulator += DeltaTime;
+
+	// Everything up to here has been simulated; the accumulator is the part that hasn't
+	double StepStart = GetNow() - StepAccumulator;
+
+	int32 Steps = 0;
+	while (StepAccumulator >= Step && Steps < MaxStepsPerFrame && EntActor.Num() > 0)
+	{
+		StepAccumulator -= Step;
+		++Steps;
+		StepEffects(StepStart, Step);
+		StepStart += Step;
+	}
+
+	// Drop the backlog after a hitch instead of spiralling
+	if (Steps >= MaxStepsPerFrame)
+	{
+		StepAccumulator = FMath::Min(StepAccumulator, Step);
+	}
+
+	ProcessExpiries(GetNow() - StepAccumulator);
+
+	TimeUntilPrune -= DeltaTime;
+	if (TimeUntilPrune <= 0.0f)
+	{
+		TimeUntilPrune = PruneInterval;
+
+		// Destroyed actors, plus anything emptied while write-back had removal on hold
+		for (int32 e = EntActor.Num() - 1; e >= 0; --e)
+		{
+			if (!EntActor[e].IsValid() || EntInstances[e].Num() == 0)
+			{
+				RemoveEntityAt(e);
+			}
+		}
+	}
+}
+
+void UStatusEffectSubsystem::StepEffects(double StepStart, float DeltaTime)
+{
+	CPPTESTS_SCOPE(STAT_CPPTests_StatusEffectStep, StatusEffect_Step);
+
+	++StepCounter;
+	StepTouched.Reset();
+
+	// Only effects that hurt are walked; decay-only ones (fear, penalties) cost nothing here
+	for (const int32 i : TickingInstances)
+	{
+		const int32 e = InstEntity[i];
+		const FStatusEffectParams& P = Params[InstDef[i]];
+
+		// First touch this step: snapshot what the update needs from the actor
+		if (EntStepStamp[e] != StepCounter)
+		{
+			EntStepStamp[e] = StepCounter;
+			StepTouched.Add(e);
+
+			const AActor* Actor = EntActor[e].Get();
+			const UPlayerStatsComponent* Stats = EntStats[e].Get();
+			EntHasStamina[e] = (Stats && Stats->Stamina > 0.0f) ? 1 : 0;
+			EntMoving[e] = (Actor && Actor->GetVelocity().SizeSquared2D() > 5.0f) ? 1 : 0;
+			EntHealthDelta[e] = 0.0f;
+			EntStaminaDelta[e] = 0.0f;
+		}
+
+		if (P.bOnlyWhileMoving && !EntMoving[e])
+		{
+			continue;
+		}
+
+		// Part of the step before the magnitude hits zero, sampled at its midpoint (exact for linear decay)
+		const float ActiveSeconds = float(FMath::Clamp(GetExpiryTime(i) - StepStart, 0.0, double(DeltaTime)));
+		if (ActiveSeconds <= 0.0f)
+		{
+			continue;
+		}
+
+		const float Mag = EvaluateMagnitude(i, StepStart + ActiveSeconds * 0.5);
+
+		float HealthRate = P.HealthPerSecond + P.HealthPerSecondPerPoint * Mag;
+		const float StaminaRate = P.StaminaPerSecond + P.StaminaPerSecondPerPoint * Mag;
+
+		if (EntHasStamina[e])
+		{
+			EntStaminaDelta[e] -= StaminaRate * ActiveSeconds;
+		}
+		else
+		{
+			HealthRate += P.HealthPerSecondWhenNoStamina;
+		}
+
+		EntHealthDelta[e] -= HealthRate * ActiveSeconds;
+	}
+
+	// Write back. Damage can kill an NPC and clear its effects; entity removal waits so the indices here stay put.
+	bDeferEntityRemoval = true;
+	for (const int32 e : StepTouched)
+	{
+		const float HealthDelta = EntHealthDelta[e];
+		const float StaminaDelta = EntStaminaDelta[e];
+
+		if (UPlayerStatsComponent* Stats = EntStats[e].Get())
+		{
+			FScopedStatTransaction StatTransaction(Stats);
+
+			if (HealthDelta != 0.0f)
+			{
+				Stats->ModifyHealth(HealthDelta);
+			}
+			if (StaminaDelta != 0.0f)
+			{
+				Stats->ModifyStamina(StaminaDelta);
+			}
+		}
+		else if (ANPCCharacter* NPC = EntNPC[e].Get())
+		{
+			if (HealthDelta < 0.0f && !NPC->IsDead())
+			{
+				UGameplayStatics::ApplyDamage(NPC, -HealthDelta, nullptr, nullptr, nullptr);
+			}
+		}
+	}
+	bDeferEntityRemoval = false;
+
+	// Highest first, so a swap never moves an entity we still have to look at
+	StepTouched.Sort(TGreater<int32>());
+	for (const int32 e : StepTouched)
+	{
+		RemoveEntityIfEmpty(e);
+	}
+
+	BroadcastObserved(StepStart + DeltaTime);
+}
+
+void UStatusEffectSubsystem::ProcessExpiries(double UpTo)
+{
+	while (Expiries.Num() > 0 && Expiries.HeapTop().Time <= UpTo)
+	{
+		FStatusEffectExpiry Expiry;
+		Expiries.HeapPop(Expiry, EAllowShrinking::No);
+
+		const int32* Found = EntityLookup.Find(Expiry.Actor);
+		const int32 Entity = Found ? *Found : INDEX_NONE;
+		const int32 Instance = Entity != INDEX_NONE ? FindInstance(Entity, Expiry.Def) : INDEX_NONE;
+		if (Instance == INDEX_NONE || InstSerial[Instance] != Expiry.Serial)
+		{
+			continue;
+		}
+
+		// Topped up or held since this was queued
+		const double ExpiryTime = GetExpiryTime(Instance);
+		if (ExpiryTime > Expiry.Time)
+		{
+			Expiry.Time = ExpiryTime;
+			Expiries.HeapPush(Expiry);
+			continue;
+		}
+
+		UStatusEffectComponent* Component = EntComponent[Entity].Get();
+
+		RemoveInstanceAt(Instance);
+		RemoveEntityIfEmpty(Entity);
+
+		if (Component)
+		{
+			Component->NotifyEffectsChanged();
+		}
+	}
+}
+
+void UStatusEffectSubsystem::BroadcastObserved(double Time)
+{
+	// Decay is invisible unless someone reads it: entities with a component get their snapshot refreshed, bound UIs a nudge
+	for (int32 o = Observed.Num() - 1; o >= 0; --o)
+	{
+		if (!Observed.IsValidIndex(o))
+		{
+			continue;
+		}
+
+		const int32 Entity = FindEntity(Observed[o].Get());
+		UStatusEffectComponent* Component = Entity != INDEX_NONE ? EntComponent[Entity].Get() : nullptr;
+		if (!Component)
+		{
+			continue;
+		}
+
+		bool bDecaying = false;
+		for (const int32 Instance : EntInstances[Entity])
+		{
+			bDecaying |= Params[InstDef[Instance]].DecayPerSecond > 0.0f && InstDecayStart[Instance] < Time;
+		}
+
+		if (bDecaying)
+		{
+			Component->NotifyEffectsChanged(Component->OnEffectsChanged.IsBound());
+		}
+	}
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "HAL/LowLevelMemTracker.h"
+
+// Game-side profiling. "stat CPPTests" in game; the same scopes show up as CPU events in Insights
+// and under the CPPTests category in CSV captures (csvprofile start/stop).
+DECLARE_STATS_GROUP(TEXT("CPP_Tests"), STATGROUP_CPPTests, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("NPC BrainTick"), STAT_CPPTests_BrainTick, STATGROUP_CPPTests, CPP_TESTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Forest RebuildForest"), STAT_CPPTests_RebuildForest, STATGROUP_CPPTests, CPP_TESTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Menu RefreshPlayerInventoryGrid"), STAT_CPPTests_RefreshInventoryGrid, STATGROUP_CPPTests, CPP_TESTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Menu ConfirmTrade"), STAT_CPPTests_ConfirmTrade, STATGROUP_CPPTests, CPP_TESTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Status Effect Step"), STAT_CPPTests_StatusEffectStep, STATGROUP_CPPTests, CPP_TESTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Hazard Apply"), STAT_CPPTests_HazardApply, STATGROUP_CPPTests, CPP_TESTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Player FindBestLockOnTarget"), STAT_CPPTests_FindLockOnTarget, STATGROUP_CPPTests, CPP_TESTS_API);
+
+// Live NPCs by brain mode (pooled and dead NPCs aren't counted)
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("NPCs Wandering"), STAT_CPPTests_NPCsWander, STATGROUP_CPPTests, CPP_TESTS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("NPCs Chasing"), STAT_CPPTests_NPCsChase, STATGROUP_CPPTests, CPP_TESTS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("NPCs Fleeing"), STAT_CPPTests_NPCsFlee, STATGROUP_CPPTests, CPP_TESTS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("NPCs Returning Home"), STAT_CPPTests_NPCsReturnHome, STATGROUP_CPPTests, CPP_TESTS_API);
+
+// Per frame
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Nav Queries"), STAT_CPPTests_NavQueries, STATGROUP_CPPTests, CPP_TESTS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Widget Rebuilds"), STAT_CPPTests_WidgetRebuilds, STATGROUP_CPPTests, CPP_TESTS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Widgets Created"), STAT_CPPTests_WidgetsCreated, STATGROUP_CPPTests, CPP_TESTS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Instances Generated"), STAT_CPPTests_InstancesGenerated, STATGROUP_CPPTests, CPP_TESTS_API);
+
+CSV_DECLARE_CATEGORY_EXTERN(CPPTests);
+
+// LLM tags, one per feature, all under CPPTests. Run with -llm (and -trace=memtag for Insights);
+// "stat LLMFULL" shows them live and CPPTests.LLM / memreport dump the totals.
+LLM_DECLARE_TAG_API(CPPTests, CPP_TESTS_API);
+LLM_DECLARE_TAG_API(CPPTests_Forest, CPP_TESTS_API);
+LLM_DECLARE_TAG_API(CPPTests_NPCs, CPP_TESTS_API);
+LLM_DECLARE_TAG_API(CPPTests_NPCNav, CPP_TESTS_API);
+LLM_DECLARE_TAG_API(CPPTests_NPCWidgets, CPP_TESTS_API);
+LLM_DECLARE_TAG_API(CPPTests_Menu, CPP_TESTS_API);
+LLM_DECLARE_TAG_API(CPPTests_Merchant, CPP_TESTS_API);
+LLM_DECLARE_TAG_API(CPPTests_StatusEffects, CPP_TESTS_API);
+LLM_DECLARE_TAG_API(CPPTests_Pickups, CPP_TESTS_API);
+
+// Cycle stat, Insights CPU event and CSV timing for one game system. Name is a bare identifier.
+#define CPPTESTS_SCOPE(Stat, Name) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(Name); \
+	CSV_SCOPED_TIMING_STAT(CPPTests, Name)
+
+// Bumps a per-frame counter stat and the matching CSV column
+#define CPPTESTS_COUNT(Stat, Name, Amount) \
+	INC_DWORD_STAT_BY(Stat, Amount); \
+	CSV_CUSTOM_STAT(CPPTests, Name, int32(Amount), ECsvCustomStatOp::Accumulate)
@@ -7,6 +7,7 @@
 
 class UBoxComponent;
 class ANPCCharacter;
+struct FHazardSubject;
 
 
 UCLASS()
@@ -19,16 +20,20 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
-	virtual void Tick(float DeltaSeconds) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components")
 	UBoxComponent* Box;
 
-	// What the volume applies while the player is inside it
+	// What the volume applies while the player (or an NPC) is inside it
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Hazard")
 	EStatusEffectType EffectType = EStatusEffectType::None;
 
+	// Optional; applied instead of EffectType so new effect assets can be placed without code
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Hazard")
+	TObjectPtr<UStatusEffectDataAsset> CustomEffect = nullptr;
+
 	// For direct damage + poison DoT tuning
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Hazard", meta=(ClampMin="0.0"))
 	float DamagePerSecond = 10.f;
@@ -37,7 +42,7 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Hazard", meta=(ClampMin="0.0"))
 	float PointsPerSecond = 5.f;
 
-	// Burn is special: it “sticks” until healed. This controls whether burn is applied on entry.
+	// Burn is special: it “sticks” until healed. This controls whether burn is applied on entry (players only).
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Hazard")
 	bool bApplyBurnOnEnter = true;
 
@@ -45,23 +50,18 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Debug")
 	bool bPrintDebug = false;
 
-private:
-	UPROPERTY()
-	TSet<TWeakObjectPtr<class ACPP_TestsCharacter>> OverlappingPlayers;
-
-	UPROPERTY()
-	TSet<TWeakObjectPtr<class ANPCCharacter>> OverlappingNPCs;
-
+	// Called by UHazardSubsystem's fixed-rate pass, which works out who is inside from its grid
+	void HandleSubjectEnter(const FHazardSubject& Subject);
+	void HandleSubjectExit(const FHazardSubject& Subject);
+	void ApplyToSubject(const FHazardSubject& Subject, float DeltaSeconds);
 
-	UFUNCTION()
-	void OnBoxBegin(UPrimitiveComponent* OverlappedComp, AActor* OtherActor,
-		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& Sweep);
+private:
+	// Only registered for Movable boxes; static hazards are baked once in BeginPlay
+	void OnBoxTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
 
-	UFUNCTION()
-	void OnBoxEnd(UPrimitiveComponent* OverlappedComp, AActor* OtherActor,
-		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+	void ApplyToPlayer(const FHazardSubject& Subject, float DeltaSeconds);
 
-	void ApplyToPlayer(class ACPP_TestsCharacter* Player, float DeltaSeconds);
+	void ApplyEffectTo(AActor* Target, float DeltaSeconds);
 
 	void ApplyToNPC(class ANPCCharacter* NPC, float DeltaSeconds);
 
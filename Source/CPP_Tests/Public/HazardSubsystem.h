@@ -0,0 +1,105 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "HazardSubsystem.generated.h"
+
+class ADamageTestVolume;
+class ACPP_TestsCharacter;
+class ANPCCharacter;
+class UPlayerStatsComponent;
+class UStatusEffectComponent;
+
+// A hazard volume baked into the grid: its (possibly rotated) box and the cells it covers
+struct FHazardShape
+{
+	TWeakObjectPtr<ADamageTestVolume> Volume;
+	FTransform BoxTransform = FTransform::Identity;
+	FVector Extent = FVector::ZeroVector;
+	FIntPoint MinCell = FIntPoint::ZeroValue;
+	FIntPoint MaxCell = FIntPoint::ZeroValue;
+
+	// Padding grows the box on each local axis, so a capsule counts as inside when any part of it is
+	bool Contains(const FVector& Location, const FVector& Padding = FVector::ZeroVector) const;
+};
+
+// Something hazards apply to; components are looked up once on registration
+struct FHazardSubject
+{
+	TWeakObjectPtr<AActor> Actor;
+	TWeakObjectPtr<ACPP_TestsCharacter> Player;
+	TWeakObjectPtr<ANPCCharacter> NPC;
+	TWeakObjectPtr<UPlayerStatsComponent> Stats;
+	TWeakObjectPtr<UStatusEffectComponent> Effects;
+
+	// Capsule radius / half-height; the actor location is the capsule centre, not the feet
+	FVector Padding = FVector::ZeroVector;
+
+	// Hazard ids the subject stood in at the last step
+	TArray<int32, TInlineAllocator<2>> Inside;
+};
+
+/**
+ * Hazard volumes baked into a coarse 2D grid, so "which hazards am I in" is one cell lookup plus a box test.
+ * Players and NPCs register as subjects; a fixed-rate pass works out enter/exit from the grid and applies effects.
+ * No physics overlaps involved, and AI can cheaply ask whether a spot is hazardous.
+ */
+UCLASS(Config=Game)
+class CPP_TESTS_API UHazardSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Bakes (or re-bins, if already known) the volume's box into the grid
+	void AddHazard(ADamageTestVolume* Volume);
+	void RemoveHazard(ADamageTestVolume* Volume);
+
+	void RegisterSubject(AActor* Actor);
+	void UnregisterSubject(AActor* Actor);
+
+	void GetHazardsAt(const FVector& Location, TArray<ADamageTestVolume*>& OutVolumes) const;
+
+	UFUNCTION(BlueprintPure, Category="Hazard")
+	bool IsLocationHazardous(const FVector& Location) const;
+
+	float GetApplyInterval() const { return FMath::Max(0.01f, ApplyInterval); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	UPROPERTY(Config, meta=(ClampMin="0.01", Units="s"))
+	float ApplyInterval = 0.1f;
+
+	// Caps how much time one pass can catch up after a hitch
+	UPROPERTY(Config, meta=(ClampMin="1"))
+	int32 MaxCatchUpSteps = 4;
+
+	UPROPERTY(Config, meta=(ClampMin="100.0", Units="cm"))
+	float CellSize = 1000.0f;
+
+	TMap<int32, FHazardShape> Hazards;
+	TMap<TObjectKey<ADamageTestVolume>, int32> VolumeToId;
+	TMap<FIntPoint, TArray<int32>> Cells;
+	int32 NextId = 1;
+
+	TArray<FHazardSubject> Subjects;
+	TArray<TWeakObjectPtr<AActor>> PendingSubjects;
+	bool bApplying = false;
+
+	float ApplyAccumulator = 0.0f;
+
+	FIntPoint ToCell(const FVector& Location) const;
+	void UnbinShape(int32 Id, const FHazardShape& Shape);
+	void FindHazardIds(const FVector& Location, TArray<int32, TInlineAllocator<2>>& OutIds, const FVector& Padding = FVector::ZeroVector) const;
+
+	void AddSubjectNow(AActor* Actor);
+	void ApplyAll(float StepSeconds);
+	void StepSubject(int32 SubjectIndex, float StepSeconds);
+};
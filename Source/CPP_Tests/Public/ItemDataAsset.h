@@ -5,6 +5,7 @@
 #include "ItemDataAsset.generated.h"
 
 class UTexture2D;
+class UStaticMesh;
 
 UCLASS(BlueprintType)
 class CPP_TESTS_API UItemDataAsset : public UDataAsset
@@ -22,6 +23,10 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Item")
 	TObjectPtr<UTexture2D> Icon = nullptr;
 
+	// How the item looks lying on the ground (instanced by UPickupSubsystem). Without one, drops stay real actors.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Item")
+	TObjectPtr<UStaticMesh> PickupMesh = nullptr;
+
 	// If true, we try to merge into existing stacks up to MaxStackSize.
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Item")
 	bool bStackable = true;
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PickupItemActor.h"
+#include "LootContainerActor.generated.h"
+
+// Default death-drop pile for NPCs with no LootContainerClass. Same as a pickup, but always has something to look at.
+UCLASS()
+class CPP_TESTS_API ALootContainerActor : public APickupItemActor
+{
+	GENERATED_BODY()
+
+public:
+	ALootContainerActor();
+};
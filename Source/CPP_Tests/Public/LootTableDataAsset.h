@@ -0,0 +1,97 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "InventoryComponent.h" // EItemRarity, FItemStack
+#include "LootTableDataAsset.generated.h"
+
+class UItemDataAsset;
+
+USTRUCT(BlueprintType)
+struct FLootTableEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Loot")
+	TObjectPtr<UItemDataAsset> Item = nullptr;
+
+	// Relative to the other entries (and NothingWeight)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Loot", meta=(ClampMin="0.0"))
+	float Weight = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Loot", meta=(ClampMin="1"))
+	int32 MinQuantity = 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Loot", meta=(ClampMin="1"))
+	int32 MaxQuantity = 1;
+
+	// Skip the rarity roll and always drop at FixedRarity
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Loot")
+	bool bFixedRarity = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Loot", meta=(EditCondition="bFixedRarity"))
+	EItemRarity FixedRarity = EItemRarity::Garbage;
+};
+
+// Walker/Vose alias table: O(n) build, O(1) weighted pick
+struct CPP_TESTS_API FLootAliasTable
+{
+	void Build(TConstArrayView<float> Weights);
+	int32 Sample(const FRandomStream& Rng) const;
+	bool IsEmpty() const { return Prob.Num() == 0; }
+
+private:
+	TArray<float> Prob;
+	TArray<int32> Alias;
+};
+
+UCLASS(BlueprintType)
+class CPP_TESTS_API ULootTableDataAsset : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Loot")
+	TArray<FLootTableEntry> Entries;
+
+	// Weight of a roll that drops nothing
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Loot", meta=(ClampMin="0.0"))
+	float NothingWeight = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Loot", meta=(ClampMin="0"))
+	int32 MinRolls = 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Loot", meta=(ClampMin="0"))
+	int32 MaxRolls = 1;
+
+	// Relative odds per rarity, indexed by EItemRarity (Garbage, Acceptable, Fair, Perfect)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Loot|Rarity", meta=(ClampMin="0.0"))
+	TArray<float> RarityWeights = { 50.0f, 30.0f, 15.0f, 5.0f };
+
+	// One kill's worth of loot, merged into stacks
+	UFUNCTION(BlueprintCallable, Category="Loot")
+	TArray<FItemStack> RollLoot() const;
+
+	// NumKills worth of loot in one pass (e.g. an area attack); results merged into one stack list
+	UFUNCTION(BlueprintCallable, Category="Loot")
+	TArray<FItemStack> RollLootBatch(int32 NumKills) const;
+
+	void RollLootInto(int32 NumKills, const FRandomStream& Rng, TArray<FItemStack>& OutStacks) const;
+	EItemRarity RollRarity(const FRandomStream& Rng) const;
+
+	// Adds to an existing Item+Rarity stack or appends a new one
+	static void MergeStack(TArray<FItemStack>& Stacks, UItemDataAsset* Item, int32 Quantity, EItemRarity Rarity);
+
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+	// Built from Entries/NothingWeight/RarityWeights; index Entries.Num() means "nothing"
+	mutable FLootAliasTable EntryTable;
+	mutable FLootAliasTable RarityTable;
+	mutable bool bTablesBuilt = false;
+
+	void BuildTables() const;
+};
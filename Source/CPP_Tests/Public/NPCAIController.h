@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AIController.h"
+#include "GameplayTagContainer.h"
+#include "NPCAIController.generated.h"
+
+class UStateTree;
+class UStateTreeAIComponent;
+
+/**
+ * Default controller for NPCs. Behaves like a plain AAIController unless the
+ * pawn hands it a behaviour StateTree to run.
+ */
+UCLASS()
+class CPP_TESTS_API ANPCAIController : public AAIController
+{
+	GENERATED_BODY()
+
+public:
+	ANPCAIController();
+
+	void RunBehaviorStateTree(UStateTree* StateTree);
+	void StopBehaviorStateTree();
+	bool IsRunningBehaviorStateTree() const;
+
+	void SendBehaviorEvent(const FGameplayTag& Tag);
+
+	UStateTreeAIComponent* GetStateTreeComponent() const { return StateTreeComponent; }
+
+private:
+	UPROPERTY(VisibleAnywhere, Category="AI")
+	TObjectPtr<UStateTreeAIComponent> StateTreeComponent;
+};
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NPCAmbientSubsystem.generated.h"
+
+class ANPCCharacter;
+class ANPCSafeZone;
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+class UNPCArchetype;
+
+// What an NPC carries while it's an ambient proxy
+struct FNPCAmbientState
+{
+	FVector Location = FVector::ZeroVector;
+	float Yaw = 0.0f;
+	float Health = 0.0f;
+	FVector HomeCenter = FVector::ZeroVector;
+	float WanderRadius = 0.0f;
+	float WanderSpeed = 0.0f;
+	TWeakObjectPtr<ANPCSafeZone> SafeZone;
+	TWeakObjectPtr<UNPCArchetype> Archetype;
+};
+
+/**
+ * Distant neutral wanderers as plain data + one instanced mesh per NPC class.
+ * Opt-in NPCs (bAllowAmbientProxy) turn into records when the player is far,
+ * and back into full actors when the player comes close.
+ */
+UCLASS(Config=Game)
+class CPP_TESTS_API UNPCAmbientSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Spawn straight into ambient form; becomes an actor only if the player walks up to it
+	UFUNCTION(BlueprintCallable, Category="NPC|Ambient")
+	void AddAmbientNPC(TSubclassOf<ANPCCharacter> NPCClass, FVector Location, ANPCSafeZone* Zone);
+
+	void RegisterCandidate(ANPCCharacter* NPC);
+	void UnregisterCandidate(ANPCCharacter* NPC);
+
+	UFUNCTION(BlueprintPure, Category="NPC|Ambient")
+	int32 GetNumAmbientNPCs() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// Actors further than this become proxies
+	UPROPERTY(Config)
+	float DemoteDistance = 6000.0f;
+
+	// Proxies closer than this become actors again (keep below DemoteDistance)
+	UPROPERTY(Config)
+	float PromoteDistance = 4500.0f;
+
+	UPROPERTY(Config)
+	float ConversionCheckInterval = 0.5f;
+
+	// Proxies are far away, no need to move them every frame
+	UPROPERTY(Config)
+	float MovementUpdateInterval = 0.1f;
+
+	UPROPERTY(Config)
+	int32 MaxConversionsPerCheck = 8;
+
+	UPROPERTY(Config)
+	float WanderWaitMin = 1.0f;
+
+	UPROPERTY(Config)
+	float WanderWaitMax = 4.0f;
+
+	// How far above/below a record to look for navmesh or ground when placing it
+	UPROPERTY(Config)
+	float GroundProbeDepth = 500.0f;
+
+	// One batch per NPC class: parallel arrays, record i == ISM instance i
+	struct FAmbientBatch
+	{
+		// Batch key: NPCClass + ProxyMesh + MeshOffset + HalfHeight
+		TSubclassOf<ANPCCharacter> NPCClass;
+		TObjectPtr<UStaticMesh> ProxyMesh = nullptr;
+		FTransform MeshOffset = FTransform::Identity;
+
+		// Records store actor (capsule centre) locations, this far above the ground
+		float HalfHeight = 0.0f;
+
+		TObjectPtr<UInstancedStaticMeshComponent> Mesh = nullptr;
+
+		TArray<FVector> Locations;
+		TArray<float> Yaws;
+		TArray<float> Healths;
+		TArray<FVector> HomeCenters;
+		TArray<float> WanderRadii;
+		TArray<float> WanderSpeeds;
+		TArray<TWeakObjectPtr<ANPCSafeZone>> SafeZones;
+		TArray<TWeakObjectPtr<UNPCArchetype>> Archetypes;
+		TArray<FVector> WanderTargets;
+		TArray<float> WaitUntil;
+
+		int32 Num() const { return Locations.Num(); }
+	};
+
+	TArray<FAmbientBatch> Batches;
+	TArray<TWeakObjectPtr<ANPCCharacter>> Candidates;
+
+	UPROPERTY(Transient)
+	TObjectPtr<AActor> ProxyHost = nullptr;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UInstancedStaticMeshComponent>> ProxyMeshes;
+
+	float TimeUntilConversionCheck = 0.0f;
+	float TimeUntilMovementUpdate = 0.0f;
+	TArray<FTransform> ScratchTransforms;
+
+	FAmbientBatch* FindOrAddBatch(TSubclassOf<ANPCCharacter> NPCClass, const ANPCCharacter* Source);
+	void AddRecord(FAmbientBatch& Batch, const FNPCAmbientState& State);
+	bool SnapToGround(const FAmbientBatch& Batch, FVector& InOutLocation) const;
+	void RemoveRecordAtSwap(FAmbientBatch& Batch, int32 Index);
+	FNPCAmbientState GetRecordState(const FAmbientBatch& Batch, int32 Index) const;
+
+	void DemoteFarActors(const FVector& PlayerLoc);
+	void PromoteNearProxies(const FVector& PlayerLoc);
+	void UpdateProxyMovement(float DeltaTime);
+
+	bool SpawnActorFromState(TSubclassOf<ANPCCharacter> NPCClass, const FNPCAmbientState& State);
+};
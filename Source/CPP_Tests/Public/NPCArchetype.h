@@ -0,0 +1,250 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "NPCArchetype.generated.h"
+
+class APickupItemActor;
+class ULootTableDataAsset;
+class UAnimMontage;
+class UNPCHealthBarWidget;
+class UStateTree;
+class UStaticMesh;
+
+// All the balance knobs an NPC reads at runtime. Shared through UNPCArchetype, never written per instance.
+USTRUCT(BlueprintType)
+struct CPP_TESTS_API FNPCTuning
+{
+	GENERATED_BODY()
+
+	// Text overrides skip the details panel's ClampMin/ClampMax, so ApplyOverrides runs this afterwards. Keep in sync with the metadata below.
+	void ClampToValidRanges();
+
+	// --- Health ---
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Health", meta=(ClampMin="1.0"))
+	float MaxHealth = 100.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Health")
+	bool bIsImmortal = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Health", meta=(ClampMin="0.0", ClampMax="1.0"))
+	float LowHealthSpeedThreshold = 0.25f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Health", meta=(ClampMin="0.0"))
+	float LowHealthMoveSpeedMultiplier = 0.5f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Health|AutoRestore")
+	bool bAutoRestoreHealthWhenCalm = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Health|AutoRestore", meta=(EditCondition="bAutoRestoreHealthWhenCalm", ClampMin="0.0", Units="s"))
+	float RestoreHealthDelaySeconds = 30.0f;
+
+	// --- Interaction ---
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Interaction", meta=(ClampMin="0.0", Units="s"))
+	float InteractionFaceSeconds = 10.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Interaction", meta=(ClampMin="0.0"))
+	float InteractionFaceInterpSpeed = 10.0f;
+
+	// --- Death ---
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Death")
+	bool bDestroyOnDeath = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Death", meta=(ClampMin="0.0", Units="s"))
+	float DestroyDelaySeconds = 6.0f;
+
+	// Go dormant in the NPC pool after DestroyDelaySeconds instead of being destroyed
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Death", meta=(EditCondition="bDestroyOnDeath"))
+	bool bReturnToPoolOnDeath = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Death")
+	TObjectPtr<ULootTableDataAsset> LootTable = nullptr;
+
+	// Legacy fixed drops; their item/quantity/rarity get merged into the same pile as the loot roll
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Death")
+	TArray<TSubclassOf<APickupItemActor>> DropsOnDeath;
+
+	// Spawn each DropsOnDeath Blueprint as its own actor instead of merging it into the pile (one actor per drop)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Death")
+	bool bSpawnDropsAsActors = false;
+
+	// One of these is spawned per death holding everything that dropped. None = the pile becomes an instanced ground record (UPickupSubsystem), or an ALootContainerActor if the items have no PickupMesh
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Death")
+	TSubclassOf<APickupItemActor> LootContainerClass;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Death", meta=(ClampMin="0.0", Units="cm"))
+	float DropScatterRadius = 60.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Death", meta=(ClampMin="-200.0", ClampMax="200.0", Units="cm"))
+	float DropSpawnZOffset = 20.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Death")
+	bool bRagdollOnDeath = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Death", meta=(EditCondition="bRagdollOnDeath", ClampMin="0.0"))
+	float RagdollImpulseStrength = 0.0f;
+
+	// Played instead of a ragdoll when the ragdoll budget says no (far away). Turn off auto blend out so it holds the last frame.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Death")
+	TObjectPtr<UAnimMontage> DeathMontage = nullptr;
+
+	// --- Merchant Economy ---
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Merchant", meta=(ClampMin="0"))
+	int32 MaxCurrency = 500;
+
+	// Points required to go from level N -> N+1 (expects 5 entries for levels 0..4)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Merchant|Relationship")
+	TArray<int32> RelationshipPointsToNextLevel = { 10, 15, 20, 25, 30 };
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Merchant", meta=(ClampMin="1.0"))
+	float PreferredItemSellMultiplier = 2.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Merchant|Economy", meta=(ClampMin="0.0"))
+	float SellMultiplier_Garbage = 0.5f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Merchant|Economy", meta=(ClampMin="0.0"))
+	float SellMultiplier_Acceptable = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Merchant|Economy", meta=(ClampMin="0.0"))
+	float SellMultiplier_Fair = 1.5f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Merchant|Economy", meta=(ClampMin="0.0"))
+	float SellMultiplier_Perfect = 2.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Merchant|Resale", meta=(ClampMin="1.0"))
+	float ResaleBuyPriceMultiplier = 2.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Merchant|Resale", meta=(ClampMin="0", ClampMax="5"))
+	int32 ResaleMinRelationshipLevel = 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Merchant|UI")
+	FLinearColor MerchantCurrencyTint = FLinearColor::White;
+
+	// --- Lock-on aim tuning ---
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="LockOn", meta=(ClampMin="0.0", ClampMax="1.0"))
+	float LockOnAimHeightRatio = 0.72f;
+
+	// --- Perception ---
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Perception", meta=(ClampMin="0.0", Units="cm"))
+	float ReactionRange = 900.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Perception", meta=(ClampMin="1.0", ClampMax="180.0", Units="deg"))
+	float NoticeFOVDegrees = 110.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Perception", meta=(ClampMin="0.0", Units="s"))
+	float LoseInterestSeconds = 4.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Perception", meta=(ClampMin="0.05", Units="s"))
+	float ReactionRepathInterval = 0.35f;
+
+	// Stop the brain timer while calmly wandering with the player far away
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Perception")
+	bool bAllowBrainSleep = true;
+
+	// Extra margin on the wake shell so the brain is already running when the player reaches ReactionRange
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Perception", meta=(EditCondition="bAllowBrainSleep", ClampMin="0.0", Units="cm"))
+	float SleepShellSlack = 300.0f;
+
+	// --- AI / Timing ---
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AI", meta=(ClampMin="0.05"))
+	float BrainTickSeconds = 0.15f;
+
+	// Optional shared behaviour tree (NPC tasks + role conditions). Empty = built-in mode switch.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AI")
+	TObjectPtr<UStateTree> BehaviorStateTree = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AI", meta=(ClampMin="50.0", Units="cm"))
+	float ChaseAcceptanceRadius = 150.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AI", meta=(ClampMin="100.0", Units="cm"))
+	float FleeDistance = 800.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AI", meta=(ClampMin="50.0", Units="cm"))
+	float ReturnHomeAcceptanceRadius = 120.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AI", meta=(ClampMin="0.0", Units="s"))
+	float StuckAbortSeconds = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AI", meta=(ClampMin="1"))
+	int32 FleeSampleTries = 8;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AI", meta=(ClampMin="0.0", ClampMax="180.0", Units="deg"))
+	float FleeAngleJitterDegrees = 90.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AI", meta=(ClampMin="10.0", Units="cm"))
+	float FleeNavSearchRadius = 300.0f;
+
+	// --- Wander ---
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Wander", meta=(ClampMin="50.0", Units="cm"))
+	float WanderRadius = 900.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Wander", meta=(ClampMin="10.0", Units="cm"))
+	float WanderAcceptanceRadius = 80.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Wander", meta=(ClampMin="0.0", Units="s"))
+	float WanderWaitMin = 0.8f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Wander", meta=(ClampMin="0.0", Units="s"))
+	float WanderWaitMax = 2.8f;
+
+	// --- Ambient proxy ---
+	// Far from the player the NPC can be swapped for an instanced mesh record. Neutral wanderers only.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Ambient")
+	bool bAllowAmbientProxy = false;
+
+	// Mesh drawn while in proxy form. Empty = placeholder VisualMesh.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Ambient", meta=(EditCondition="bAllowAmbientProxy"))
+	TObjectPtr<UStaticMesh> AmbientProxyMesh = nullptr;
+
+	// --- Speed / Turning ---
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Speed", meta=(ClampMin="0.0", Units="cm/s"))
+	float WanderSpeed = 400.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Speed", meta=(ClampMin="0.0", Units="cm/s"))
+	float MaxReactionSpeed = 600.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Speed", meta=(ClampMin="0.05", Units="s"))
+	float WanderRampSeconds = 2.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Speed", meta=(ClampMin="0.0"))
+	float RotationRateYaw = 540.0f;
+
+	// --- UI: Health bar ---
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="UI")
+	TSubclassOf<UNPCHealthBarWidget> HealthBarWidgetClass;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="UI", meta=(ClampMin="0.1"))
+	float HealthBarHideDelaySeconds = 5.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="UI")
+	FVector HealthBarWorldOffset = FVector(0.f, 0.f, 110.f);
+};
+
+// One-off tweak on top of an archetype. Value uses the property's text format (e.g. "1200", "true", "(X=0,Y=0,Z=90)").
+USTRUCT(BlueprintType)
+struct CPP_TESTS_API FNPCTuningOverride
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Tuning", meta=(GetOptions="GetTuningOverrideOptions"))
+	FName Property = NAME_None;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Tuning")
+	FString Value;
+};
+
+UCLASS(BlueprintType)
+class CPP_TESTS_API UNPCArchetype : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="NPC", meta=(ShowOnlyInnerProperties))
+	FNPCTuning Tuning;
+
+	// Used when an NPC has no archetype assigned
+	static const FNPCTuning& GetDefaultTuning();
+
+	// Copies Base and applies Overrides on top. Unknown names / bad values are logged and skipped.
+	static void ApplyOverrides(const FNPCTuning& Base, const TArray<FNPCTuningOverride>& Overrides, FNPCTuning& OutTuning, const UObject* LogContext);
+};
@@ -6,6 +6,9 @@
 #include "LockOnTargetable.h"
 #include "MerchantInventoryDataAsset.h"
 #include "InventoryComponent.h" // EItemRarity, FItemStack
+#include "NPCArchetype.h"
+#include "AITypes.h"
+#include "Navigation/PathFollowingComponent.h"
 #include "NPCCharacter.generated.h"
 
 class AAIController;
@@ -14,17 +17,28 @@ class UStaticMeshComponent;
 class UAnimInstance;
 class UItemDataAsset;
 class APickupItemActor;
-class UNPCHealthBarWidget;
-class UWidgetComponent;
 
 class UInventoryComponent;
 class UPlayerStatsComponent;
+class UStaticMesh;
+struct FGameplayTag;
+struct FNPCAmbientState;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnNPCDamaged, ANPCCharacter*, NPC, float, Damage, AActor*, DamageCauser);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnNPCDied, ANPCCharacter*, NPC, AActor*, Killer);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnMerchantInteracted, ANPCCharacter*, Merchant, AActor*, Interactor);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnMerchantRelationshipChanged, ANPCCharacter*, Merchant, int32, NewRelationship);
 
+// Where a returning NPC is headed. The built-in brain keeps one on the NPC; the StateTree task keeps its own.
+struct FNPCReturnHomeState
+{
+	bool bHasTarget = false;
+	FVector Target = FVector::ZeroVector;
+	float LastPickTime = -1000.0f;
+
+	void Reset() { *this = FNPCReturnHomeState(); }
+};
+
 USTRUCT(BlueprintType)
 struct FPreferredItemConfig
 {
@@ -50,6 +64,24 @@ class CPP_TESTS_API ANPCCharacter : public ACharacter, public IInteractable, pub
 public:
 	ANPCCharacter();
 
+	// Shared tuning (archetype + per-instance overrides). Falls back to struct defaults with no archetype.
+	const FNPCTuning& GetTuning() const
+	{
+		if (OverriddenTuning)
+		{
+			return *OverriddenTuning;
+		}
+		return Archetype ? Archetype->Tuning : UNPCArchetype::GetDefaultTuning();
+	}
+
+	UFUNCTION(BlueprintPure, Category="NPC|Archetype")
+	UNPCArchetype* GetArchetype() const { return Archetype; }
+
+	// Swaps the shared tuning (spawners/pool). Null goes back to the class default archetype.
+	void SetArchetype(UNPCArchetype* NewArchetype);
+
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
 	// -------------------------
 	// Interact
 	// -------------------------
@@ -69,13 +101,13 @@ public:
 	bool IsDead() const { return bIsDead; }
 
 	UFUNCTION(BlueprintCallable, Category="NPC|Health")
-	float GetMaxHealth() const { return MaxHealth; }
+	float GetMaxHealth() const { return FMath::Max(1.0f, GetTuning().MaxHealth); }
 
 	UFUNCTION(BlueprintCallable, Category="NPC|Health")
 	float GetCurrentHealth() const { return CurrentHealth; }
 
 	UFUNCTION(BlueprintCallable, Category="NPC|Health")
-	bool IsImmortal() const { return bIsImmortal; }
+	bool IsImmortal() const { return GetTuning().bIsImmortal; }
 
 	UFUNCTION(BlueprintCallable, Category="NPC|Health")
 	void ApplyDamageSimple(float Damage, AActor* DamageCauser = nullptr, AController* DamageInstigator = nullptr);
@@ -89,6 +121,9 @@ public:
 	UFUNCTION(BlueprintImplementableEvent, Category="NPC|Health")
 	void BP_OnDamaged(float Damage, AActor* DamageCauser);
 
+	// Fires OnNPCDamaged / BP_OnDamaged once for everything taken since the last flush (see UNPCDamageFlushSubsystem)
+	void FlushPendingDamage();
+
 	UFUNCTION(BlueprintImplementableEvent, Category="NPC|Death")
 	void BP_OnDied(AActor* Killer);
 
@@ -104,6 +139,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category="NPC|Role")
 	bool IsNeutral() const { return !bIsMerchant && !bIsAggressive && !bIsScaredOfPlayer; }
 
+	UFUNCTION(BlueprintCallable, Category="NPC|Role")
+	bool IsAggressive() const { return bIsAggressive; }
+
+	UFUNCTION(BlueprintCallable, Category="NPC|Role")
+	bool IsScaredOfPlayer() const { return bIsScaredOfPlayer; }
+
+	UFUNCTION(BlueprintCallable, Category="NPC|Role")
+	bool IsStationary() const { return bIsStationary; }
+
 	// -------------------------
 	// Identity (UI)
 	// -------------------------
@@ -114,7 +158,7 @@ public:
 	FText GetMerchantDisplayName() const { return GetNPCDisplayName(); }
 
 	UFUNCTION(BlueprintPure, Category="NPC|Merchant|UI")
-	FLinearColor GetMerchantCurrencyTint() const { return MerchantCurrencyTint; }
+	FLinearColor GetMerchantCurrencyTint() const { return GetTuning().MerchantCurrencyTint; }
 
 	// -------------------------
 	// Merchant API (all in NPC)
@@ -123,7 +167,7 @@ public:
 	bool CanTrade() const { return bIsMerchant && RelationshipLevel > 0; }
 
 	UFUNCTION(BlueprintCallable, Category="NPC|Merchant")
-	int32 GetMaxCurrency() const { return MaxCurrency; }
+	int32 GetMaxCurrency() const { return FMath::Max(0, GetTuning().MaxCurrency); }
 
 	UFUNCTION(BlueprintCallable, Category="NPC|Merchant")
 	int32 GetCurrentCurrency() const { return CurrentCurrency; }
@@ -191,6 +235,44 @@ public:
 	UFUNCTION(BlueprintImplementableEvent, Category="NPC|Merchant")
 	void BP_OnMerchantInteracted(AActor* Interactor);
 
+	// -------------------------
+	// Perception (brain sleep)
+	// -------------------------
+	// Restarts the brain if it was sleeping. Cheap to call when already awake.
+	void WakeBrain();
+
+	bool IsBrainAsleep() const { return bBrainAsleep; }
+
+	// -------------------------
+	// Ambient proxy (see UNPCAmbientSubsystem)
+	// -------------------------
+	bool CanBecomeAmbientProxy() const;
+	FNPCAmbientState CaptureAmbientState() const;
+	void RestoreFromAmbientState(const FNPCAmbientState& State);
+
+	UStaticMesh* GetAmbientProxyMesh() const;
+	FTransform GetAmbientProxyMeshOffset() const;
+
+	// -------------------------
+	// Pooling (see UNPCPoolSubsystem)
+	// -------------------------
+	void DeactivateForPool();
+	void ReactivateFromPool(const FTransform& SpawnTransform, ANPCSafeZone* Zone, bool bRegisterWithZone = true);
+	bool IsInPool() const { return bInPool; }
+
+	// Called by UNPCRagdollSubsystem once the body settles (or the budget needs its slot)
+	void FreezeRagdoll();
+
+	// Budget needed the slot while the body was still falling: cheap death if there's a montage, otherwise hide it
+	void AbandonRagdoll();
+
+	// Read every frame by UNPCMovementSpeedSubsystem while a speed ramp runs
+	float GetLowHealthMoveMultiplier() const;
+
+	// bRegisterWithZone=false only records the zone; the caller registers a whole batch via ANPCSafeZone::RegisterNPCs
+	void SetSafeZone(ANPCSafeZone* Zone, bool bRegisterWithZone = true);
+	ANPCSafeZone* GetSafeZone() const { return SafeZone; }
+
 	// -------------------------
 	// LockOnTargetable interface
 	// -------------------------
@@ -199,10 +281,134 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void OnConstruction(const FTransform& Transform) override;
-	virtual void Tick(float DeltaTime) override;
+	virtual void PostInitializeComponents() override;
+	virtual void PostLoad() override;
 
 private:
+	// --- Archetype ---
+	UPROPERTY(EditAnywhere, Category="NPC Config|Archetype")
+	TObjectPtr<UNPCArchetype> Archetype = nullptr;
+
+	// Only for one-off tweaks. Any entry here gives this NPC its own copy of the tuning.
+	UPROPERTY(EditAnywhere, Category="NPC Config|Archetype", meta=(TitleProperty="Property"))
+	TArray<FNPCTuningOverride> TuningOverrides;
+
+	TUniquePtr<FNPCTuning> OverriddenTuning;
+
+	void RebuildTuning();
+	void ApplyArchetypeSetup();
+
+	// Feeds the override dropdown. Hides merchant knobs on non-merchants and wander knobs on stationary NPCs, like the old per-NPC EditConditions did.
+	UFUNCTION()
+	TArray<FName> GetTuningOverrideOptions() const;
+
+#if WITH_EDITORONLY_DATA
+	// --- Pre-archetype tuning ---
+	// The per-NPC copies these knobs used to live in. Only read by PostLoad, which turns anything that isn't the C++ default into a TuningOverrides entry.
+	UPROPERTY()
+	float InteractionFaceSeconds_DEPRECATED = 10.0f;
+	UPROPERTY()
+	float InteractionFaceInterpSpeed_DEPRECATED = 10.0f;
+	UPROPERTY()
+	float MaxHealth_DEPRECATED = 100.0f;
+	UPROPERTY()
+	bool bIsImmortal_DEPRECATED = false;
+	UPROPERTY()
+	float LowHealthSpeedThreshold_DEPRECATED = 0.25f;
+	UPROPERTY()
+	float LowHealthMoveSpeedMultiplier_DEPRECATED = 0.5f;
+	UPROPERTY()
+	bool bAutoRestoreHealthWhenCalm_DEPRECATED = true;
+	UPROPERTY()
+	float RestoreHealthDelaySeconds_DEPRECATED = 30.0f;
+	UPROPERTY()
+	bool bDestroyOnDeath_DEPRECATED = true;
+	UPROPERTY()
+	float DestroyDelaySeconds_DEPRECATED = 6.0f;
+	UPROPERTY()
+	TArray<TSubclassOf<APickupItemActor>> DropsOnDeath_DEPRECATED;
+	UPROPERTY()
+	float DropScatterRadius_DEPRECATED = 60.0f;
+	UPROPERTY()
+	float DropSpawnZOffset_DEPRECATED = 20.0f;
+	UPROPERTY()
+	bool bRagdollOnDeath_DEPRECATED = true;
+	UPROPERTY()
+	float RagdollImpulseStrength_DEPRECATED = 0.0f;
+	UPROPERTY()
+	int32 MaxCurrency_DEPRECATED = 500;
+	UPROPERTY()
+	TArray<int32> RelationshipPointsToNextLevel_DEPRECATED = { 10, 15, 20, 25, 30 };
+	UPROPERTY()
+	float PreferredItemSellMultiplier_DEPRECATED = 2.0f;
+	UPROPERTY()
+	float SellMultiplier_Garbage_DEPRECATED = 0.5f;
+	UPROPERTY()
+	float SellMultiplier_Acceptable_DEPRECATED = 1.0f;
+	UPROPERTY()
+	float SellMultiplier_Fair_DEPRECATED = 1.5f;
+	UPROPERTY()
+	float SellMultiplier_Perfect_DEPRECATED = 2.0f;
+	UPROPERTY()
+	float ResaleBuyPriceMultiplier_DEPRECATED = 2.0f;
+	UPROPERTY()
+	int32 ResaleMinRelationshipLevel_DEPRECATED = 1;
+	UPROPERTY()
+	FLinearColor MerchantCurrencyTint_DEPRECATED = FLinearColor::White;
+	UPROPERTY()
+	float LockOnAimHeightRatio_DEPRECATED = 0.72f;
+	UPROPERTY()
+	float ReactionRange_DEPRECATED = 900.0f;
+	UPROPERTY()
+	float NoticeFOVDegrees_DEPRECATED = 110.0f;
+	UPROPERTY()
+	float LoseInterestSeconds_DEPRECATED = 4.0f;
+	UPROPERTY()
+	float ReactionRepathInterval_DEPRECATED = 0.35f;
+	UPROPERTY()
+	float BrainTickSeconds_DEPRECATED = 0.15f;
+	UPROPERTY()
+	float ChaseAcceptanceRadius_DEPRECATED = 150.0f;
+	UPROPERTY()
+	float FleeDistance_DEPRECATED = 800.0f;
+	UPROPERTY()
+	float ReturnHomeAcceptanceRadius_DEPRECATED = 120.0f;
+	UPROPERTY()
+	float StuckAbortSeconds_DEPRECATED = 1.0f;
+	UPROPERTY()
+	int32 FleeSampleTries_DEPRECATED = 8;
+	UPROPERTY()
+	float FleeAngleJitterDegrees_DEPRECATED = 90.0f;
+	UPROPERTY()
+	float FleeNavSearchRadius_DEPRECATED = 300.0f;
+	UPROPERTY()
+	float WanderRadius_DEPRECATED = 900.0f;
+	UPROPERTY()
+	float WanderAcceptanceRadius_DEPRECATED = 80.0f;
+	UPROPERTY()
+	float WanderWaitMin_DEPRECATED = 0.8f;
+	UPROPERTY()
+	float WanderWaitMax_DEPRECATED = 2.8f;
+	UPROPERTY()
+	float WanderSpeed_DEPRECATED = 400.0f;
+	UPROPERTY()
+	float MaxReactionSpeed_DEPRECATED = 600.0f;
+	UPROPERTY()
+	float WanderRampSeconds_DEPRECATED = 2.0f;
+	UPROPERTY()
+	float RotationRateYaw_DEPRECATED = 540.0f;
+	UPROPERTY()
+	TSubclassOf<UNPCHealthBarWidget> HealthBarWidgetClass_DEPRECATED;
+	UPROPERTY()
+	float HealthBarHideDelaySeconds_DEPRECATED = 5.0f;
+	UPROPERTY()
+	FVector HealthBarWorldOffset_DEPRECATED = FVector(0.f, 0.f, 110.f);
+
+	void MigrateDeprecatedTuning();
+#endif
+
 	// --- Interaction / Roles ---
 	UPROPERTY(EditAnywhere, Category="NPC Config|Interaction")
 	bool bIsInteractable = true;
@@ -210,12 +416,6 @@ private:
 	UPROPERTY(EditAnywhere, Category="NPC Config|Interaction", meta=(EditCondition="bIsInteractable", EditConditionHides))
 	bool bIsMerchant = false;
 
-	UPROPERTY(EditAnywhere, Category="NPC Config|Interaction", meta=(ClampMin="0.0", Units="s"))
-	float InteractionFaceSeconds = 10.0f;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|Interaction", meta=(ClampMin="0.0"))
-	float InteractionFaceInterpSpeed = 10.0f;
-
 	float InteractionPauseUntilTime = -1.0f;
 	TWeakObjectPtr<AActor> InteractionFaceTarget;
 
@@ -237,58 +437,9 @@ private:
 	UPROPERTY(EditAnywhere, Category="NPC Config|Identity")
 	FText NPCDisplayName;
 
-	// --- Health ---
-	UPROPERTY(EditAnywhere, Category="NPC Config|Health", meta=(ClampMin="1.0"))
-	float MaxHealth = 100.0f;
-
 	UPROPERTY(VisibleInstanceOnly, Category="NPC Runtime|Health")
 	float CurrentHealth = 0.0f;
 
-	UPROPERTY(EditAnywhere, Category="NPC Config|Health")
-	bool bIsImmortal = false;
-
-	// --- Low Health Movement Penalty ---
-	UPROPERTY(EditAnywhere, Category="NPC Config|Health", meta=(ClampMin="0.0", ClampMax="1.0"))
-	float LowHealthSpeedThreshold = 0.25f;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|Health", meta=(ClampMin="0.0"))
-	float LowHealthMoveSpeedMultiplier = 0.5f;
-
-	// --- Auto-restore health when calm ---
-	UPROPERTY(EditAnywhere, Category="NPC Config|Health|AutoRestore")
-	bool bAutoRestoreHealthWhenCalm = true;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|Health|AutoRestore",
-		meta=(EditCondition="bAutoRestoreHealthWhenCalm", ClampMin="0.0", Units="s"))
-	float RestoreHealthDelaySeconds = 30.0f;
-
-	// --- Death ---
-	UPROPERTY(EditAnywhere, Category="NPC Config|Death")
-	bool bDestroyOnDeath = true;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|Death", meta=(ClampMin="0.0", Units="s"))
-	float DestroyDelaySeconds = 6.0f;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|Death")
-	TArray<TSubclassOf<APickupItemActor>> DropsOnDeath;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|Death", meta=(ClampMin="0.0", Units="cm"))
-	float DropScatterRadius = 60.0f;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|Death", meta=(ClampMin="-200.0", ClampMax="200.0", Units="cm"))
-	float DropSpawnZOffset = 20.0f;
-
-	// --- Ragdoll on death ---
-	UPROPERTY(EditAnywhere, Category="NPC Config|Death")
-	bool bRagdollOnDeath = true;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|Death", meta=(EditCondition="bRagdollOnDeath", ClampMin="0.0"))
-	float RagdollImpulseStrength = 0.0f;
-
-	// --- Merchant Economy ---
-	UPROPERTY(EditAnywhere, Category="NPC Config|Merchant", meta=(EditCondition="bIsMerchant", ClampMin="0"))
-	int32 MaxCurrency = 500;
-
 	UPROPERTY(VisibleInstanceOnly, Category="NPC Runtime|Merchant", meta=(EditCondition="bIsMerchant", ClampMin="0"))
 	int32 CurrentCurrency = 0;
 
@@ -299,10 +450,6 @@ private:
 	UPROPERTY(VisibleInstanceOnly, Category="NPC Runtime|Merchant", meta=(EditCondition="bIsMerchant", ClampMin="0"))
 	int32 RelationshipPoints = 0;
 
-	// Points required to go from level N -> N+1 (expects 5 entries for levels 0..4)
-	UPROPERTY(EditAnywhere, Category="NPC Config|Merchant|Relationship", meta=(EditCondition="bIsMerchant"))
-	TArray<int32> RelationshipPointsToNextLevel;
-
 	// New preferred item config (includes relationship points)
 	UPROPERTY(EditAnywhere, Category="NPC Config|Merchant", meta=(EditCondition="bIsMerchant"))
 	TArray<FPreferredItemConfig> PreferredItemConfigs;
@@ -311,33 +458,6 @@ private:
 	UPROPERTY(EditAnywhere, Category="NPC Config|Merchant", meta=(EditCondition="bIsMerchant"))
 	TArray<TObjectPtr<UItemDataAsset>> PreferredItems;
 
-	UPROPERTY(EditAnywhere, Category="NPC Config|Merchant", meta=(EditCondition="bIsMerchant", ClampMin="1.0"))
-	float PreferredItemSellMultiplier = 2.0f;
-
-	// Rarity multipliers (sell value)
-	UPROPERTY(EditAnywhere, Category="NPC Config|Merchant|Economy", meta=(EditCondition="bIsMerchant", ClampMin="0.0"))
-	float SellMultiplier_Garbage = 0.5f;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|Merchant|Economy", meta=(EditCondition="bIsMerchant", ClampMin="0.0"))
-	float SellMultiplier_Acceptable = 1.0f;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|Merchant|Economy", meta=(EditCondition="bIsMerchant", ClampMin="0.0"))
-	float SellMultiplier_Fair = 1.5f;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|Merchant|Economy", meta=(EditCondition="bIsMerchant", ClampMin="0.0"))
-	float SellMultiplier_Perfect = 2.0f;
-
-	// Resale behavior
-	UPROPERTY(EditAnywhere, Category="NPC Config|Merchant|Resale", meta=(EditCondition="bIsMerchant", ClampMin="1.0"))
-	float ResaleBuyPriceMultiplier = 2.0f;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|Merchant|Resale", meta=(EditCondition="bIsMerchant", ClampMin="0", ClampMax="5"))
-	int32 ResaleMinRelationshipLevel = 1;
-
-	// Optional UI tint per merchant (so you can test/configure it)
-	UPROPERTY(EditAnywhere, Category="NPC Config|Merchant|UI", meta=(EditCondition="bIsMerchant"))
-	FLinearColor MerchantCurrencyTint = FLinearColor::White;
-
 	UPROPERTY(EditAnywhere, Category="NPC Config|Merchant", meta=(EditCondition="bIsMerchant"))
 	TObjectPtr<UMerchantInventoryDataAsset> MerchantInventoryData = nullptr;
 
@@ -345,77 +465,9 @@ private:
 	UPROPERTY(EditAnywhere, Category="NPC Config|Merchant", meta=(EditCondition="bIsMerchant"))
 	bool bQuickSellAllOnInteract = false;
 
-	// --- Lock-on aim tuning ---
-	UPROPERTY(EditAnywhere, Category="NPC Config|LockOn", meta=(ClampMin="0.0", ClampMax="1.0"))
-	float LockOnAimHeightRatio = 0.72f;
-
-	// --- Perception ---
-	UPROPERTY(EditAnywhere, Category="NPC Config|Perception", meta=(ClampMin="0.0", Units="cm"))
-	float ReactionRange = 900.0f;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|Perception", meta=(ClampMin="1.0", ClampMax="180.0", Units="deg"))
-	float NoticeFOVDegrees = 110.0f;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|Perception", meta=(ClampMin="0.0", Units="s"))
-	float LoseInterestSeconds = 4.0f;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|Perception", meta=(ClampMin="0.05", Units="s"))
-	float ReactionRepathInterval = 0.35f;
-
-	// --- AI / Timing ---
-	UPROPERTY(EditAnywhere, Category="NPC Config|AI", meta=(ClampMin="0.05"))
-	float BrainTickSeconds = 0.15f;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|AI", meta=(ClampMin="50.0", Units="cm"))
-	float ChaseAcceptanceRadius = 150.0f;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|AI", meta=(ClampMin="100.0", Units="cm"))
-	float FleeDistance = 800.0f;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|AI", meta=(ClampMin="50.0", Units="cm"))
-	float ReturnHomeAcceptanceRadius = 120.0f;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|AI", meta=(ClampMin="0.0", Units="s"))
-	float StuckAbortSeconds = 1.0f;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|AI", meta=(ClampMin="1"))
-	int32 FleeSampleTries = 8;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|AI", meta=(ClampMin="0.0", ClampMax="180.0", Units="deg"))
-	float FleeAngleJitterDegrees = 90.0f;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|AI", meta=(ClampMin="10.0", Units="cm"))
-	float FleeNavSearchRadius = 300.0f;
-
-	// --- Wander ---
-	UPROPERTY(EditAnywhere, Category="NPC Config|Wander", meta=(EditCondition="!bIsStationary", ClampMin="50.0", Units="cm"))
-	float WanderRadius = 900.0f;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|Wander", meta=(EditCondition="!bIsStationary", ClampMin="10.0", Units="cm"))
-	float WanderAcceptanceRadius = 80.0f;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|Wander", meta=(EditCondition="!bIsStationary", ClampMin="0.0", Units="s"))
-	float WanderWaitMin = 0.8f;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|Wander", meta=(EditCondition="!bIsStationary", ClampMin="0.0", Units="s"))
-	float WanderWaitMax = 2.8f;
-
 	UPROPERTY(EditInstanceOnly, Category="NPC Config|Wander", meta=(EditCondition="!bIsStationary"))
 	TObjectPtr<ANPCSafeZone> SafeZone;
 
-	// --- Speed / Turning ---
-	UPROPERTY(EditAnywhere, Category="NPC Config|Speed", meta=(ClampMin="0.0", Units="cm/s"))
-	float WanderSpeed = 400.0f;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|Speed", meta=(ClampMin="0.0", Units="cm/s"))
-	float MaxReactionSpeed = 600.0f;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|Speed", meta=(ClampMin="0.05", Units="s"))
-	float WanderRampSeconds = 2.0f;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|Speed", meta=(ClampMin="0.0"))
-	float RotationRateYaw = 540.0f;
-
 	// --- Animation ---
 	UPROPERTY(EditAnywhere, Category="NPC Config|Animation")
 	TSubclassOf<UAnimInstance> NPCAnimBlueprintClass;
@@ -436,30 +488,29 @@ private:
 	UPROPERTY(VisibleAnywhere, Category="NPC Config|Visual")
 	TObjectPtr<UStaticMeshComponent> VisualMesh;
 
-	// -------------------------
-	// UI: Health bar
-	// -------------------------
-	UPROPERTY(VisibleAnywhere, Category="NPC|UI")
-	TObjectPtr<UWidgetComponent> HealthBarComponent = nullptr;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|UI")
-	TSubclassOf<UNPCHealthBarWidget> HealthBarWidgetClass;
-
-	UPROPERTY(EditAnywhere, Category="NPC Config|UI", meta=(ClampMin="0.1"))
-	float HealthBarHideDelaySeconds = 5.0f;
+	float PendingDamage = 0.0f;
+	TWeakObjectPtr<AActor> PendingDamageCauser;
+	bool bDamageFlushQueued = false;
 
-	UPROPERTY(EditAnywhere, Category="NPC Config|UI")
-	FVector HealthBarWorldOffset = FVector(0.f, 0.f, 110.f);
+	FTimerHandle PoolReturnTimerHandle;
 
-	FTimerHandle HealthBarHideTimerHandle;
+	bool bInPool = false;
+	TWeakObjectPtr<AController> PooledController;
+	FName PreRagdollMeshProfile = NAME_None;
 
+	// Health bar is drawn by UNPCHealthBarSubsystem
 	void ShowHealthBarNow();
-	void FadeHealthBar();
+	void HideHealthBar();
 
 	// ------------------------------------------------------------
 	// Runtime state
 	// ------------------------------------------------------------
 	FTimerHandle BrainTimerHandle;
+	bool bStateTreeDriven = false;
+	FTimerHandle SleepWanderTimerHandle;
+	FTimerHandle SleepRestoreTimerHandle;
+	FTimerHandle SleepStuckTimerHandle;
+	bool bBrainAsleep = false;
 
 	FVector HomeLocation = FVector::ZeroVector;
 	TWeakObjectPtr<ANPCSafeZone> LastRegisteredZone;
@@ -474,22 +525,20 @@ private:
 
 	ENPCMode CurrentMode = ENPCMode::Wander;
 
+	// Mode changes go through here so the per-mode NPC stats stay right
+	void SetMode(ENPCMode NewMode);
+	void SetModeCounted(bool bCounted);
+	static void AdjustModeStat(ENPCMode Mode, int32 Delta);
+	bool bModeCounted = false;
+
 	float OutOfRangeStartTime = -1.0f;
 	float NextWanderAllowedTime = 0.0f;
 	bool bWasMovingLastTick = false;
 
-	bool bSpeedRamping = false;
-	float RampStartTime = 0.0f;
-	float RampDuration = 0.0f;
-	float RampStartSpeed = 0.0f;
-	float RampTargetSpeed = 0.0f;
-
 	float LastReactionMoveTime = -1000.0f;
 	float StuckStartTime = -1.0f;
 
-	bool bHasReturnTarget = false;
-	FVector CachedReturnTarget = FVector::ZeroVector;
-	float LastReturnTargetPickTime = -1000.0f;
+	FNPCReturnHomeState ReturnHomeState;
 
 	bool bIsDead = false;
 
@@ -504,11 +553,32 @@ private:
 	// Helpers
 	// ------------------------------------------------------------
 	void BrainTick();
+	void SendBehaviorEvent(const FGameplayTag& Tag);
+
+	// StateTree tasks drive the same helpers the built-in brain uses; their per-state timers and
+	// targets live in the task instance data, not here
+	friend struct FNPCWanderTask;
+	friend struct FNPCChaseTask;
+	friend struct FNPCFleeTask;
+	friend struct FNPCReturnHomeTask;
+
+	bool CanBrainSleep(const APawn* PlayerPawn) const;
+	float GetSleepShellRadius() const;
+	void EnterBrainSleep(AAIController* AIC);
+	void ExitBrainSleep();
+	void ScheduleSleepWander();
+	void SleepWanderTick();
+	void StartSleepStuckCheck();
+	void SleepStuckCheck();
+
+	UFUNCTION()
+	void HandleSleepMoveCompleted(FAIRequestID RequestID, EPathFollowingResult::Type Result);
 
 	void Wander(AAIController* AIC);
 	void ChasePlayer(AAIController* AIC, APawn* PlayerPawn);
 	void FleeFromPlayer(AAIController* AIC, APawn* PlayerPawn);
-	void ReturnHome(AAIController* AIC);
+	// True once back inside the zone (mode is Wander again)
+	bool ReturnHome(AAIController* AIC, FNPCReturnHomeState& State);
 
 	bool CanNoticePlayerCone(const APawn* PlayerPawn) const;
 	bool IsPlayerInReactionRange(const APawn* PlayerPawn) const;
@@ -522,13 +592,13 @@ private:
 	void SetSpeedImmediate(float Speed);
 
 	float GetHealthPercent01() const;
-	float GetLowHealthMoveMultiplier() const;
 	void CancelSpeedRamp();
 	void ReapplyMoveSpeedFromLastRequest();
 
 	void TryAutoRestoreHealth(float NowSeconds);
 
 	bool IsAIMoving(const AAIController* AIC) const;
+	void MoveToLocationCached(AAIController* AIC, const FVector& Dest, float AcceptanceRadius);
 	bool FindFleeDestination(APawn* PlayerPawn, FVector& OutDest) const;
 
 	bool IsInsideSafeZone2D() const;
@@ -542,7 +612,12 @@ private:
 	void HandleDeath(AActor* Killer);
 	void SpawnDrops();
 
-	void EnterRagdoll(AActor* DamageCauser);
+	bool EnterRagdoll(AActor* DamageCauser);
+	void ExitRagdoll();
+	void PlayCheapDeath();
+	void ReturnToPool();
+	void BindToSafeZone(ANPCSafeZone* Zone);
+	void StartBrainTimer();
 
 	int32 FindMerchantEntryIndex_Runtime(const UItemDataAsset* Item) const;
 
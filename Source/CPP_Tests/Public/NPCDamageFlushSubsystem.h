@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NPCDamageFlushSubsystem.generated.h"
+
+class ANPCCharacter;
+
+/**
+ * Batches the side effects of NPC damage (delegates, BP event, speed reapply, health bar).
+ * Health is still applied per hit; NPCs with pending damage are flushed once per frame
+ * or every FlushInterval seconds with the summed amount.
+ */
+UCLASS(Config=Game)
+class CPP_TESTS_API UNPCDamageFlushSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// NPC calls this the first time it takes damage since its last flush
+	void QueueFlush(ANPCCharacter* NPC);
+
+	void FlushAll();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// 0 = flush every frame
+	UPROPERTY(Config)
+	float FlushInterval = 0.0f;
+
+	TArray<TWeakObjectPtr<ANPCCharacter>> Pending;
+	TArray<TWeakObjectPtr<ANPCCharacter>> Flushing;
+
+	float TimeUntilFlush = 0.0f;
+};
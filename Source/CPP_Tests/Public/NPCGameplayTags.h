@@ -0,0 +1,9 @@
+#pragma once
+
+#include "NativeGameplayTags.h"
+
+// Events the NPC sends to its behaviour StateTree
+namespace NPCTags
+{
+	CPP_TESTS_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Event_PlayerNoticed);
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NPCHealthBarSubsystem.generated.h"
+
+class ANPCCharacter;
+class UNPCHealthBarWidget;
+
+USTRUCT()
+struct FNPCHealthBarSlot
+{
+	GENERATED_BODY()
+
+	TWeakObjectPtr<ANPCCharacter> NPC;
+
+	// Null while the NPC is off screen; the bar keeps counting down without a widget
+	UPROPERTY()
+	TObjectPtr<UNPCHealthBarWidget> Widget = nullptr;
+
+	float Percent = 1.0f;
+	float HideTime = 0.0f;
+	bool bFading = false;
+};
+
+USTRUCT()
+struct FNPCHealthBarWidgetList
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<UNPCHealthBarWidget>> Widgets;
+};
+
+/**
+ * One viewport layer for every NPC health bar.
+ * Only recently damaged, on-screen NPCs get a widget (from a small pool); positions are
+ * projected together once per frame using a single view-projection matrix.
+ */
+UCLASS(Config=Game)
+class CPP_TESTS_API UNPCHealthBarSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Shows (or refreshes) the NPC's bar and restarts its hide countdown
+	void ShowBar(ANPCCharacter* NPC, float Percent);
+	void HideBar(ANPCCharacter* NPC);
+	bool IsBarShown(const ANPCCharacter* NPC) const;
+
+	int32 GetNumActiveBars() const { return Active.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	UPROPERTY(Config)
+	int32 MaxVisibleBars = 24;
+
+	// Spare widgets kept in the viewport (hidden) per widget class
+	UPROPERTY(Config)
+	int32 MaxPooledWidgets = 16;
+
+	UPROPERTY(Config)
+	int32 ViewportZOrder = -10;
+
+	UPROPERTY(Transient)
+	TArray<FNPCHealthBarSlot> Active;
+
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UClass>, FNPCHealthBarWidgetList> FreeWidgets;
+
+	int32 FindSlot(const ANPCCharacter* NPC) const;
+	UNPCHealthBarWidget* AcquireWidget(const ANPCCharacter* NPC);
+	void ReleaseWidget(FNPCHealthBarSlot& Slot);
+};
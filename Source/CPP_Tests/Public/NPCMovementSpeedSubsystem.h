@@ -0,0 +1,49 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "NPCMovementSpeedSubsystem.generated.h"
+
+class ANPCCharacter;
+class UCharacterMovementComponent;
+
+/**
+ * Drives every NPC MaxWalkSpeed ramp from one set of packed arrays, so NPCs never need actor Tick.
+ * The low-health multiplier is applied to the target each frame. Taking damage cancels the ramp
+ * (ReapplyMoveSpeedFromLastRequest) and snaps straight to the scaled target speed.
+ */
+UCLASS()
+class CPP_TESTS_API UNPCMovementSpeedSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// BaseTargetSpeed is before the low-health multiplier
+	void StartRamp(ANPCCharacter* NPC, float BaseTargetSpeed, float DurationSeconds, bool bFromZero);
+	void CancelRamp(const ANPCCharacter* NPC);
+	bool IsRamping(const ANPCCharacter* NPC) const { return SlotOf.Contains(NPC); }
+
+	int32 GetNumRamps() const { return NPCs.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// Parallel arrays, swap-removed; SlotOf maps NPC -> index
+	TArray<TWeakObjectPtr<ANPCCharacter>> NPCs;
+	TArray<TWeakObjectPtr<UCharacterMovementComponent>> Movers;
+	TArray<float> StartTimes;
+	TArray<float> InvDurations;
+	TArray<float> StartSpeeds;
+	TArray<float> BaseTargets;
+
+	TMap<TObjectKey<ANPCCharacter>, int32> SlotOf;
+
+	void RemoveAtSwap(int32 Index);
+};
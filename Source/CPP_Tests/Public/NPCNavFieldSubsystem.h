@@ -0,0 +1,126 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NPCNavFieldSubsystem.generated.h"
+
+/**
+ * Coarse Dijkstra map centered on the player, shared by every reacting NPC.
+ * Chasers walk downhill toward the player, fleers walk uphill away from it,
+ * so the per-NPC cost is a few array lookups no matter how many are reacting.
+ *
+ * Queries read the last finished field. When the player changes cell a new one is expanded in the
+ * background a budget of nodes per tick and swapped in when done; cells that become walkable are
+ * patched into both in place.
+ */
+UCLASS(Config=Game)
+class CPP_TESTS_API UNPCNavFieldSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Next waypoint toward the player. False when the field can't answer or we're already close (use a direct move then).
+	bool GetChaseWaypoint(const FVector& From, FVector& OutWaypoint);
+
+	// Point roughly DesiredDistance further from the player along the field. False when cornered or off-field.
+	bool GetFleeWaypoint(const FVector& From, float DesiredDistance, FVector& OutWaypoint);
+
+	bool IsFieldValid() const { return bFieldValid; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	UPROPERTY(Config)
+	float CellSize = 150.0f;
+
+	// Field covers (2 * HalfExtentCells + 1)^2 cells around the player
+	UPROPERTY(Config)
+	int32 HalfExtentCells = 32;
+
+	UPROPERTY(Config)
+	float MaxStepHeight = 60.0f;
+
+	// Navmesh projections allowed per tick when new cells scroll into the window
+	UPROPERTY(Config)
+	int32 ProjectionBudgetPerTick = 256;
+
+	UPROPERTY(Config)
+	float MinRebuildInterval = 0.2f;
+
+	// Dijkstra node expansions per tick for the background rebuild
+	UPROPERTY(Config)
+	int32 ExpansionBudgetPerTick = 1024;
+
+	// Stop maintaining the field when nobody has asked for it in this long
+	UPROPERTY(Config)
+	float IdleTimeoutSeconds = 2.0f;
+
+	UPROPERTY(Config)
+	int32 ChaseLookaheadCells = 3;
+
+	struct FNavFieldCell
+	{
+		float Z = 0.0f;
+		bool bWalkable = false;
+	};
+
+	// World-anchored walkability, kept while the player moves so only new cells get projected
+	TMap<FIntPoint, FNavFieldCell> WalkableCache;
+	TArray<FIntPoint> PendingProjection;
+
+	struct FFieldOpenNode
+	{
+		float Cost;
+		int32 Index;
+	};
+
+	// Window the player is in now; new cells get projected against this
+	FIntPoint WindowMin = FIntPoint::ZeroValue;
+	FIntPoint PlayerCell = FIntPoint(MAX_int32, MAX_int32);
+
+	// Cost-to-player row-major, indexed from the origin it was built with (not WindowMin)
+	TArray<float> Cost;
+	FIntPoint FieldMin = FIntPoint::ZeroValue;
+	TArray<FFieldOpenNode> RepairOpen;
+
+	// Field being expanded for the player's latest cell
+	TArray<float> BuildCost;
+	FIntPoint BuildMin = FIntPoint::ZeroValue;
+	TArray<FFieldOpenNode> BuildOpen;
+	bool bBuilding = false;
+
+	bool bFieldValid = false;
+	bool bFieldDirty = false;
+	float LastQueryTime = -1000.0f;
+	float LastRebuildTime = -1000.0f;
+
+	FDelegateHandle NavDirtyHandle;
+
+	int32 GetWindowWidth() const { return HalfExtentCells * 2 + 1; }
+	FIntPoint WorldToCell(const FVector& Location) const;
+	FVector CellToWorld(const FIntPoint& Cell) const;
+	int32 CellToIndex(const FIntPoint& Cell, const FIntPoint& Min) const;
+	FIntPoint IndexToCell(int32 Index, const FIntPoint& Min) const;
+
+	const FNavFieldCell* FindWalkableCell(const FIntPoint& Cell) const;
+	bool CanStep(const FIntPoint& From, const FIntPoint& To) const;
+
+	void MoveWindowTo(const FIntPoint& NewPlayerCell);
+	void ProjectPendingCells();
+	void StartRebuild();
+	void FinishRebuild();
+	void PatchWalkableCell(const FIntPoint& Cell);
+	void RelaxInto(TArray<float>& Costs, const FIntPoint& Min, TArray<FFieldOpenNode>& Open, const FIntPoint& Cell);
+	bool ExpandField(TArray<float>& Costs, const FIntPoint& Min, TArray<FFieldOpenNode>& Open, int32 Budget);
+	void PruneWalkableCache();
+
+	void MarkQueried();
+	void HandleNavigationDirty(const FBox& DirtyBounds);
+};
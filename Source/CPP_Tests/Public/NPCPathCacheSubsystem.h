@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NavigationSystemTypes.h"
+#include "NPCPathCacheSubsystem.generated.h"
+
+class AAIController;
+
+struct FNPCPathCacheStats
+{
+	int32 Queries = 0;
+	int32 Hits = 0;
+	int32 Misses = 0;
+	int32 PathfindCalls = 0;
+	int32 Evictions = 0;
+
+	float GetHitRate() const { return Queries > 0 ? float(Hits) / float(Queries) : 0.0f; }
+};
+
+/**
+ * Short-lived path cache shared by all NPCs in a world.
+ * Keyed on the nav polys the start and goal land on; a hit reuses the cached
+ * corridor with the first/last points swapped for the caller's real endpoints.
+ */
+UCLASS(Config=Game)
+class CPP_TESTS_API UNPCPathCacheSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Issues a pathfinding move for AIC. False if no path could be produced (caller can fall back to MoveToLocation).
+	bool RequestCachedMove(AAIController* AIC, const FVector& Goal, float AcceptanceRadius);
+
+	const FNPCPathCacheStats& GetStats() const { return Stats; }
+	void ResetStats() { Stats = FNPCPathCacheStats(); }
+	void LogStats() const;
+
+	void ClearCache();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	UPROPERTY(Config)
+	float EntryTTLSeconds = 2.0f;
+
+	UPROPERTY(Config)
+	int32 MaxEntries = 256;
+
+	struct FCachedPath
+	{
+		TArray<FVector> Points;
+		FBox Bounds = FBox(ForceInit);
+		float CreatedTime = 0.0f;
+	};
+
+	TMap<TPair<NavNodeRef, NavNodeRef>, FCachedPath> Cache;
+	FNPCPathCacheStats Stats;
+
+	FDelegateHandle NavDirtyHandle;
+
+	void EvictOldest();
+	void HandleNavigationDirty(const FBox& DirtyBounds);
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NPCPerceptionSubsystem.generated.h"
+
+class ANPCCharacter;
+
+/**
+ * Wakes sleeping NPC brains when the player walks into their proximity shell.
+ * Shells live in a coarse 2D hash, so each check only looks at the player's cell.
+ */
+UCLASS(Config=Game)
+class CPP_TESTS_API UNPCPerceptionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Shell is a 2D disc; the NPC is woken once the player is inside it
+	void RegisterSleeper(ANPCCharacter* NPC, const FVector& Center, float Radius);
+	void UnregisterSleeper(ANPCCharacter* NPC);
+
+	int32 GetNumSleepers() const { return Shells.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	UPROPERTY(Config)
+	float CellSize = 2000.0f;
+
+	UPROPERTY(Config)
+	float CheckInterval = 0.2f;
+
+	struct FSleeperShell
+	{
+		FVector2D Center = FVector2D::ZeroVector;
+		float Radius = 0.0f;
+		FIntPoint MinCell = FIntPoint::ZeroValue;
+		FIntPoint MaxCell = FIntPoint::ZeroValue;
+	};
+
+	TMap<TWeakObjectPtr<ANPCCharacter>, FSleeperShell> Shells;
+	TMap<FIntPoint, TArray<TWeakObjectPtr<ANPCCharacter>>> Cells;
+
+	float TimeUntilCheck = 0.0f;
+
+	FIntPoint ToCell2D(const FVector2D& Location) const;
+	void RemoveSleeper(const TWeakObjectPtr<ANPCCharacter>& NPC);
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NPCPoolSubsystem.generated.h"
+
+class ANPCCharacter;
+class ANPCSafeZone;
+class UNPCArchetype;
+
+USTRUCT()
+struct FNPCPoolBucket
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<ANPCCharacter>> Dormant;
+};
+
+/**
+ * Recycles dead NPCs instead of destroying them.
+ * Dormant NPCs are hidden, collision-free and brainless until AcquireNPC hands them out again.
+ */
+UCLASS(Config=Game)
+class CPP_TESTS_API UNPCPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Reuses a dormant NPC of exactly this class when there is one, otherwise spawns a new one.
+	// Archetype overrides the class default for this NPC only.
+	UFUNCTION(BlueprintCallable, Category="NPC|Pool")
+	ANPCCharacter* AcquireNPC(TSubclassOf<ANPCCharacter> NPCClass, const FTransform& SpawnTransform, ANPCSafeZone* Zone = nullptr, UNPCArchetype* Archetype = nullptr);
+
+	// Same, but the zone's NPC list is left alone so the caller can register a whole batch with ANPCSafeZone::RegisterNPCs
+	ANPCCharacter* AcquireNPCUnregistered(TSubclassOf<ANPCCharacter> NPCClass, const FTransform& SpawnTransform, ANPCSafeZone* Zone, UNPCArchetype* Archetype);
+
+	// Puts the NPC to sleep in the pool (or destroys it if the pool is full)
+	UFUNCTION(BlueprintCallable, Category="NPC|Pool")
+	void ReleaseNPC(ANPCCharacter* NPC);
+
+	// Spawn ahead of time so a wave doesn't pay for construction mid-fight
+	UFUNCTION(BlueprintCallable, Category="NPC|Pool")
+	void PrewarmPool(TSubclassOf<ANPCCharacter> NPCClass, int32 Count);
+
+	UFUNCTION(BlueprintPure, Category="NPC|Pool")
+	int32 GetNumDormant(TSubclassOf<ANPCCharacter> NPCClass) const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	UPROPERTY(Config)
+	int32 MaxDormantPerClass = 32;
+
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UClass>, FNPCPoolBucket> Buckets;
+
+	ANPCCharacter* Acquire(TSubclassOf<ANPCCharacter> NPCClass, const FTransform& SpawnTransform, ANPCSafeZone* Zone, UNPCArchetype* Archetype, bool bRegisterWithZone);
+	ANPCCharacter* SpawnFresh(TSubclassOf<ANPCCharacter> NPCClass, const FTransform& SpawnTransform, ANPCSafeZone* Zone, UNPCArchetype* Archetype, bool bRegisterWithZone);
+};
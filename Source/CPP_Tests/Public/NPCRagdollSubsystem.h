@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NPCRagdollSubsystem.generated.h"
+
+class ANPCCharacter;
+
+/**
+ * Caps how many NPC ragdolls simulate at once.
+ * Bodies freeze in place once they settle. If the cap is hit, the oldest body that is slow enough is frozen early;
+ * if every body is still falling the oldest drops to the cheap death instead, so nothing freezes in mid-air.
+ * Deaths far from the player skip physics entirely and use the NPC's death montage.
+ */
+UCLASS(Config=Game)
+class CPP_TESTS_API UNPCRagdollSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// False means the death is too far away to be worth simulating
+	bool ShouldUseFullRagdoll(const ANPCCharacter* NPC) const;
+
+	// Call once the NPC is simulating; may end an older ragdoll early to stay under budget
+	void AddRagdoll(ANPCCharacter* NPC);
+	void RemoveRagdoll(ANPCCharacter* NPC);
+
+	int32 GetNumSimulating() const { return Active.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	UPROPERTY(Config)
+	int32 MaxSimulatingRagdolls = 6;
+
+	UPROPERTY(Config)
+	float FullRagdollDistance = 4000.0f;
+
+	// Root body speed (cm/s) under which a ragdoll counts as settled
+	UPROPERTY(Config)
+	float SettleSpeed = 12.0f;
+
+	UPROPERTY(Config)
+	float SettleHoldSeconds = 0.4f;
+
+	// Simulation ends after this long even if the body never settled
+	UPROPERTY(Config)
+	float MaxSimulateSeconds = 5.0f;
+
+	// Fastest a body may still be moving and get frozen in place when it's cut short (budget or timeout)
+	UPROPERTY(Config)
+	float FreezeMaxSpeed = 100.0f;
+
+	UPROPERTY(Config)
+	float CheckInterval = 0.1f;
+
+	struct FActiveRagdoll
+	{
+		TWeakObjectPtr<ANPCCharacter> NPC;
+		float StartTime = 0.0f;
+		float SettledSince = -1.0f;
+	};
+
+	// Oldest first
+	TArray<FActiveRagdoll> Active;
+
+	float TimeUntilCheck = 0.0f;
+
+	bool CanFreezeInPlace(const ANPCCharacter* NPC) const;
+
+	// Freezes the body if it's slow enough, otherwise swaps it for the cheap death
+	void EndRagdollEarly(ANPCCharacter* NPC) const;
+};
@@ -21,14 +21,23 @@ public:
 	UFUNCTION(BlueprintCallable, Category="SafeZone")
 	bool GetRandomReachablePointInZone(FVector& OutLocation, float RadiusOverride = -1.0f) const;
 
+	// O(1) pick from the pre-sampled pool, falls back to a live nav query when the pool can't serve it
+	UFUNCTION(BlueprintCallable, Category="SafeZone")
+	bool TakeReachablePoint(FVector& OutLocation, float RadiusOverride = -1.0f);
+
 	UFUNCTION(BlueprintCallable, Category="SafeZone")
 	float GetZoneRadius() const { return ZoneRadius; }
 
 	void RegisterNPC(ANPCCharacter* NPC);
 	void UnregisterNPC(ANPCCharacter* NPC);
 
+	// One pass for a spawn batch instead of an AddUnique scan per NPC
+	void RegisterNPCs(TConstArrayView<ANPCCharacter*> NPCs);
+
 protected:
 	virtual void OnConstruction(const FTransform& Transform) override;
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
 	UPROPERTY(VisibleAnywhere, Category="SafeZone")
@@ -42,4 +51,32 @@ private:
 
 	UPROPERTY(EditAnywhere, Category="SafeZone", meta=(ClampMin="100.0", Units="cm"))
 	float ZoneRadius = 1200.0f;
+
+	// --- Reachable point pool (shared by every bound NPC) ---
+	// 0 disables the pool and every pick goes straight to the navmesh
+	UPROPERTY(EditAnywhere, Category="SafeZone|Pool", meta=(ClampMin="0", ClampMax="256"))
+	int32 ReachablePointPoolSize = 32;
+
+	UPROPERTY(EditAnywhere, Category="SafeZone|Pool", meta=(ClampMin="1", ClampMax="32"))
+	int32 PoolSamplesPerRefill = 4;
+
+	UPROPERTY(EditAnywhere, Category="SafeZone|Pool", meta=(ClampMin="0.05", Units="s"))
+	float PoolRefillInterval = 0.5f;
+
+	// Ring buffer: new samples overwrite the oldest, reads cycle through what's there
+	TArray<FVector> PointPool;
+	int32 PoolWriteIndex = 0;
+	int32 PoolReadIndex = 0;
+
+	// Reads since the last refill; once the pool is full, only these get resampled
+	int32 PointsTakenSinceRefill = 0;
+
+	FTimerHandle PoolRefillTimerHandle;
+	FDelegateHandle NavDirtyHandle;
+
+	void RefillPointPool();
+	// Runs the refill timer only while bound NPCs are using a pool that needs topping up
+	void UpdateRefillTimer();
+	void InvalidatePointPool();
+	void HandleNavigationDirty(const FBox& DirtyBounds);
 };
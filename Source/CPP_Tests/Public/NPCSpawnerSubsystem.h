@@ -0,0 +1,115 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NPCSpawnerSubsystem.generated.h"
+
+class ANPCCharacter;
+class ANPCSafeZone;
+class UNPCArchetype;
+
+USTRUCT(BlueprintType)
+struct FNPCSpawnBatch
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Spawn")
+	TSubclassOf<ANPCCharacter> NPCClass;
+
+	// Optional; null keeps the class default archetype
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Spawn")
+	TObjectPtr<UNPCArchetype> Archetype = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Spawn")
+	TArray<FTransform> Transforms;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Spawn")
+	TObjectPtr<ANPCSafeZone> SafeZone = nullptr;
+};
+
+USTRUCT()
+struct FNPCPendingSpawnBatch
+{
+	GENERATED_BODY()
+
+	int32 Id = 0;
+	int32 NextIndex = 0;
+
+	UPROPERTY()
+	FNPCSpawnBatch Request;
+
+	// Held here until the batch finishes so the zone gets them all at once
+	UPROPERTY()
+	TArray<TObjectPtr<ANPCCharacter>> Spawned;
+};
+
+struct FNPCSpawnerStats
+{
+	int32 BatchesQueued = 0;
+	int32 BatchesFinished = 0;
+	int32 Spawned = 0;
+	int32 Reused = 0;
+	int32 Failed = 0;
+	int32 FramesSpawning = 0;
+	double SpawnSeconds = 0.0;
+	double PeakFrameSeconds = 0.0;
+
+	double GetSpawnsPerSecond() const { return SpawnSeconds > 0.0 ? double(Spawned + Reused) / SpawnSeconds : 0.0; }
+	double GetAverageSpawnMs() const { return (Spawned + Reused) > 0 ? SpawnSeconds * 1000.0 / double(Spawned + Reused) : 0.0; }
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnNPCSpawnBatchFinished, int32, BatchId, const TArray<ANPCCharacter*>&, NPCs);
+
+/**
+ * Spreads NPC spawns across frames under a time budget.
+ * Spawns go through the NPC pool, and each batch is registered with its safe zone in one pass when it finishes.
+ */
+UCLASS(Config=Game)
+class CPP_TESTS_API UNPCSpawnerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Returns a batch id (0 if there was nothing to spawn)
+	UFUNCTION(BlueprintCallable, Category="NPC|Spawner")
+	int32 QueueSpawnBatch(const FNPCSpawnBatch& Batch);
+
+	// Drops whatever hasn't spawned yet; NPCs already out stay in the world
+	UFUNCTION(BlueprintCallable, Category="NPC|Spawner")
+	void CancelSpawnBatch(int32 BatchId);
+
+	UFUNCTION(BlueprintPure, Category="NPC|Spawner")
+	int32 GetNumPendingSpawns() const;
+
+	UPROPERTY(BlueprintAssignable, Category="NPC|Spawner")
+	FOnNPCSpawnBatchFinished OnSpawnBatchFinished;
+
+	const FNPCSpawnerStats& GetStats() const { return Stats; }
+	void ResetStats() { Stats = FNPCSpawnerStats(); }
+	void LogStats() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	UPROPERTY(Config)
+	float SpawnBudgetMs = 2.0f;
+
+	// Hard cap even when spawns are cheap (pool hits) so BeginPlay work is spread too
+	UPROPERTY(Config)
+	int32 MaxSpawnsPerFrame = 8;
+
+	UPROPERTY(Transient)
+	TArray<FNPCPendingSpawnBatch> Queue;
+	int32 NextBatchId = 1;
+
+	FNPCSpawnerStats Stats;
+
+	bool SpawnOne(FNPCPendingSpawnBatch& Batch);
+	void FinishBatch(FNPCPendingSpawnBatch& Batch);
+};
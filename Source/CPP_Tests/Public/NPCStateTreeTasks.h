@@ -0,0 +1,152 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StateTreeTaskBase.h"
+#include "StateTreeConditionBase.h"
+#include "NPCCharacter.h"
+#include "NPCStateTreeTasks.generated.h"
+
+class AAIController;
+
+/*
+ * Shared NPC behaviour tree (set as BehaviorStateTree on the archetype; schema: StateTree AI Component,
+ * Context Actor = ANPCCharacter, AIController = ANPCAIController). With no tree set the NPC runs the
+ * built-in mode switch in BrainTick instead. The tree it expects:
+ *
+ *   Root
+ *     Wander        NPC Wander
+ *                   -> React on event NPC.Event.PlayerNoticed
+ *     React         (no task, child is picked by NPC Role)
+ *       Chase       enter if NPC Role = Aggressive;     NPC Chase Player
+ *       Flee        enter if NPC Role = ScaredOfPlayer; NPC Flee Player
+ *                   Chase/Flee succeed when the player stayed out of range for LoseInterestSeconds
+ *                   -> ReturnHome on state succeeded
+ *     ReturnHome    NPC Return Home
+ *                   -> Wander on state succeeded; -> React on event NPC.Event.PlayerNoticed
+ *
+ * Any task failing (dead NPC, lost controller) should go to Wander. BrainTick keeps sensing while the
+ * tree runs and sends NPC.Event.PlayerNoticed; everything per-state (repath and lose-interest timers,
+ * return target) lives in the task instance data below.
+ */
+
+// Shared by every NPC task: just the two context objects
+USTRUCT()
+struct CPP_TESTS_API FNPCStateTreeTaskInstanceData
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category="Context")
+	TObjectPtr<ANPCCharacter> NPC = nullptr;
+
+	UPROPERTY(EditAnywhere, Category="Context")
+	TObjectPtr<AAIController> AIController = nullptr;
+};
+
+USTRUCT()
+struct CPP_TESTS_API FNPCReactionTaskInstanceData : public FNPCStateTreeTaskInstanceData
+{
+	GENERATED_BODY()
+
+	float NextRepathTime = 0.0f;
+
+	// When the player left reaction range; -1 while in range
+	float OutOfRangeStartTime = -1.0f;
+};
+
+USTRUCT()
+struct CPP_TESTS_API FNPCReturnHomeTaskInstanceData : public FNPCStateTreeTaskInstanceData
+{
+	GENERATED_BODY()
+
+	FNPCReturnHomeState ReturnHome;
+};
+
+/** Calm wandering inside the safe zone. Movement itself is driven by the NPC's idle brain, so this task never ticks. */
+USTRUCT(meta=(DisplayName="NPC Wander", Category="NPC"))
+struct CPP_TESTS_API FNPCWanderTask : public FStateTreeTaskCommonBase
+{
+	GENERATED_BODY()
+
+	using FInstanceDataType = FNPCStateTreeTaskInstanceData;
+
+	FNPCWanderTask();
+
+	virtual const UStruct* GetInstanceDataType() const override { return FInstanceDataType::StaticStruct(); }
+	virtual EStateTreeRunStatus EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+};
+
+/** Chase the player, repathing every ReactionRepathInterval. Succeeds when the NPC loses interest. */
+USTRUCT(meta=(DisplayName="NPC Chase Player", Category="NPC"))
+struct CPP_TESTS_API FNPCChaseTask : public FStateTreeTaskCommonBase
+{
+	GENERATED_BODY()
+
+	using FInstanceDataType = FNPCReactionTaskInstanceData;
+
+	virtual const UStruct* GetInstanceDataType() const override { return FInstanceDataType::StaticStruct(); }
+	virtual EStateTreeRunStatus EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+	virtual EStateTreeRunStatus Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const override;
+};
+
+/** Run away from the player, repathing every ReactionRepathInterval. Succeeds when the NPC loses interest. */
+USTRUCT(meta=(DisplayName="NPC Flee Player", Category="NPC"))
+struct CPP_TESTS_API FNPCFleeTask : public FStateTreeTaskCommonBase
+{
+	GENERATED_BODY()
+
+	using FInstanceDataType = FNPCReactionTaskInstanceData;
+
+	virtual const UStruct* GetInstanceDataType() const override { return FInstanceDataType::StaticStruct(); }
+	virtual EStateTreeRunStatus EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+	virtual EStateTreeRunStatus Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const override;
+};
+
+/** Walk back into the safe zone. Succeeds once inside, so the state can transition back to Wander. */
+USTRUCT(meta=(DisplayName="NPC Return Home", Category="NPC"))
+struct CPP_TESTS_API FNPCReturnHomeTask : public FStateTreeTaskCommonBase
+{
+	GENERATED_BODY()
+
+	using FInstanceDataType = FNPCReturnHomeTaskInstanceData;
+
+	virtual const UStruct* GetInstanceDataType() const override { return FInstanceDataType::StaticStruct(); }
+	virtual EStateTreeRunStatus EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+	virtual EStateTreeRunStatus Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const override;
+};
+
+UENUM()
+enum class ENPCRoleCheck : uint8
+{
+	Aggressive,
+	ScaredOfPlayer,
+	Stationary,
+	Merchant,
+	Neutral
+};
+
+USTRUCT()
+struct CPP_TESTS_API FNPCRoleConditionInstanceData
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category="Context")
+	TObjectPtr<ANPCCharacter> NPC = nullptr;
+};
+
+/** Branches a single shared tree on the NPC's role flags. */
+USTRUCT(meta=(DisplayName="NPC Role", Category="NPC"))
+struct CPP_TESTS_API FNPCRoleCondition : public FStateTreeConditionCommonBase
+{
+	GENERATED_BODY()
+
+	using FInstanceDataType = FNPCRoleConditionInstanceData;
+
+	virtual const UStruct* GetInstanceDataType() const override { return FInstanceDataType::StaticStruct(); }
+	virtual bool TestCondition(FStateTreeExecutionContext& Context) const override;
+
+	UPROPERTY(EditAnywhere, Category="Parameter")
+	ENPCRoleCheck Role = ENPCRoleCheck::Aggressive;
+
+	UPROPERTY(EditAnywhere, Category="Parameter")
+	bool bInvert = false;
+};
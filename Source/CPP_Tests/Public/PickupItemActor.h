@@ -22,7 +22,12 @@ public:
 	// This overrides the INTERFACE function (name/signature must match your Interactable.h)
 	virtual void Interact_Implementation(AActor* Interactor) override;
 
+	// ItemData/Quantity plus Contents, merged
+	void GetAllStacks(TArray<FItemStack>& OutStacks) const;
+
 protected:
+	virtual void BeginPlay() override;
+
 	UPROPERTY(VisibleAnywhere)
 	TObjectPtr<USceneComponent> Root = nullptr;
 
@@ -44,4 +49,12 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Pickup")
 	bool bDestroyOnPickup = true;
+
+	// Container mode: every stack here is handed over on interact (ItemData/Quantity are still added too if set)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Pickup")
+	TArray<FItemStack> Contents;
+
+	// Hand this pickup to UPickupSubsystem on BeginPlay and destroy the actor (needs an item PickupMesh)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Pickup")
+	bool bStoreAsRecord = false;
 };
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "InventoryComponent.h" // FItemStack
+#include "PickupSubsystem.generated.h"
+
+class APickupItemActor;
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+
+USTRUCT()
+struct FPickupRecord
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FItemStack> Stacks;
+
+	FTransform Transform = FTransform::Identity;
+
+	UPROPERTY()
+	TObjectPtr<UStaticMesh> Mesh = nullptr;
+
+	int32 InstanceIndex = INDEX_NONE;
+	FIntPoint Cell = FIntPoint::ZeroValue;
+};
+
+USTRUCT()
+struct FPickupMeshBatch
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<UInstancedStaticMeshComponent> ISM = nullptr;
+
+	// ISM instance i belongs to record InstanceToRecord[i]
+	TArray<int32> InstanceToRecord;
+};
+
+/**
+ * Ground items as plain records drawn through one ISM per item mesh.
+ * No collision: interaction finds records with a grid lookup along the interact trace,
+ * and an APickupItemActor is only spawned for the moment someone actually picks one up.
+ */
+UCLASS(Config=Game)
+class CPP_TESTS_API UPickupSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Returns a record id, or 0 if these stacks can't be drawn as a record (no PickupMesh) and need a real actor
+	int32 AddPickup(const TArray<FItemStack>& Stacks, const FTransform& Transform);
+	bool RemovePickup(int32 Id, FPickupRecord* OutRecord = nullptr);
+
+	// Closest record to Start whose location is within InteractRadius of the segment; 0 if none
+	int32 FindPickupAlongSegment(const FVector& Start, const FVector& End) const;
+
+	// Spawns the actor form and runs its normal Interact; leftovers (full inventory) go back to being a record
+	bool InteractWithPickup(int32 Id, AActor* Interactor);
+
+	APickupItemActor* MaterializePickup(int32 Id);
+
+	// Turns a plain pickup actor into a record and destroys the actor
+	bool AbsorbActor(APickupItemActor* Pickup);
+
+	UFUNCTION(BlueprintPure, Category="Pickup")
+	int32 GetNumPickupRecords() const { return Records.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	UPROPERTY(Config)
+	float CellSize = 250.0f;
+
+	UPROPERTY(Config)
+	float InteractRadius = 60.0f;
+
+	// Spawned by MaterializePickup; plain APickupItemActor when unset
+	UPROPERTY(Config)
+	TSoftClassPtr<APickupItemActor> MaterializeClass;
+
+	UPROPERTY(Transient)
+	TMap<int32, FPickupRecord> Records;
+
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UStaticMesh>, FPickupMeshBatch> Batches;
+
+	UPROPERTY(Transient)
+	TObjectPtr<AActor> ISMHost = nullptr;
+
+	TMap<FIntPoint, TArray<int32>> Cells;
+	int32 NextId = 1;
+
+	FIntPoint ToCell(const FVector& Location) const;
+	FPickupMeshBatch* FindOrAddBatch(UStaticMesh* Mesh);
+};
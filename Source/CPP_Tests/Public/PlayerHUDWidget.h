@@ -7,12 +7,15 @@
 class UProgressBar;
 class UImage;
 class UHorizontalBox;
+class UInvalidationBox;
+class URetainerBox;
 class UPlayerStatsComponent;
 class UStatusEffectComponent;
 class USizeBox;
 class UTextBlock;
 
-UCLASS()
+// Event-driven: nothing here runs per frame. Bars refresh on OnStatsChanged and animate on a throttled timer.
+UCLASS(meta=(DisableNativeTick))
 class CPP_TESTS_API UPlayerHUDWidget : public UUserWidget
 {
 	GENERATED_BODY()
@@ -41,6 +44,19 @@ protected:
 	// TextBlock named "Currency" in WBP_PlayerHUD
 	UPROPERTY(meta=(BindWidgetOptional)) UTextBlock* Currency;
 
+	// Wrap the bars / currency in these in WBP_PlayerHUD so unchanged parts are cached instead of re-painted
+	UPROPERTY(meta=(BindWidgetOptional)) UInvalidationBox* BarsInvalidationBox;
+	UPROPERTY(meta=(BindWidgetOptional)) UInvalidationBox* StatusInvalidationBox;
+	UPROPERTY(meta=(BindWidgetOptional)) URetainerBox* HUDRetainer;
+
+	// How often bars move while the displayed stats blend between fixed steps; 0 snaps on each change
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="HUD|Performance", meta=(ClampMin="0.0", Units="Hz"))
+	float BarAnimationHz = 30.f;
+
+	// With HUDRetainer bound: redraw it every N frames (1 = every frame)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="HUD|Performance", meta=(ClampMin="1"))
+	int32 RetainerPhaseCount = 1;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="HUD|Bar Width", meta=(ClampMin="0.0"))
 	float BaseHealthWidth = 220.f;
 
@@ -62,22 +78,38 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="HUD|Bar Width", meta=(ClampMin="0.0"))
 	float MaxWidthClamp = 0.f;
 
+	virtual void NativeOnInitialized() override;
 	virtual void NativeDestruct() override;
-	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
 
 private:
 	UPROPERTY() UPlayerStatsComponent* Stats = nullptr;
 	UPROPERTY() UStatusEffectComponent* Effects = nullptr;
 
-	UFUNCTION() void HandleStatsChanged();
+	UFUNCTION() void HandleStatsChanged(int32 ChangedStats);
 	UFUNCTION() void HandleEffectsChanged();
 
 	void RefreshBars();
+	void RefreshBarFills();
+	void RefreshBarWidths();
 	void RefreshStatusIcons();
-
-	// NEW: robust currency refresh
 	void RefreshCurrencyOnly();
+
+	void StartBarAnimation();
+	void TickBarAnimation();
+	FTimerHandle BarAnimationTimer;
+
+	// Last values pushed to Slate; setters are skipped when nothing moved so the invalidation boxes stay clean
 	int32 LastCurrencyShown = INT32_MIN;
+	float LastHealthPercent = -1.f;
+	float LastMagicPercent = -1.f;
+	float LastStaminaPercent = -1.f;
+	float LastStaminaAvailPercent = -1.f;
+	float LastHealthWidth = -1.f;
+	float LastStaminaWidth = -1.f;
+	float LastMagicWidth = -1.f;
+
+	static void SetBarPercent(UProgressBar* Bar, float& LastPercent, float Percent);
+	static void SetBoxWidth(USizeBox* Box, float& LastWidth, float Width);
 
 	float ApplyOptionalClamp(float Width) const;
 };
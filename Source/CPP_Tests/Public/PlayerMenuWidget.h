@@ -224,7 +224,7 @@ private:
 	TMap<TObjectPtr<UItemDataAsset>, FBuyLine> BuyCart;
 
 	// Events
-	UFUNCTION() void HandleStatsChanged();
+	UFUNCTION() void HandleStatsChanged(int32 ChangedStats);
 	UFUNCTION() void HandleEffectsChanged();
 	UFUNCTION() void HandleInventoryChanged();
 
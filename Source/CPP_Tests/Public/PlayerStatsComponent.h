@@ -2,9 +2,73 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "UObject/ObjectKey.h"
 #include "PlayerStatsComponent.generated.h"
 
-DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnStatsChanged);
+// Which stats an OnStatsChanged broadcast covers
+UENUM(BlueprintType, meta=(Bitflags, UseEnumValuesAsMaskValuesInEditor="true"))
+enum class EPlayerStatFlags : uint8
+{
+	None       = 0 UMETA(Hidden),
+	Health     = 1 << 0,
+	Stamina    = 1 << 1,
+	Magic      = 1 << 2,
+	Currency   = 1 << 3,
+	// Attributes, max values and combat numbers
+	Attributes = 1 << 4,
+
+	All        = Health | Stamina | Magic | Currency | Attributes UMETA(Hidden)
+};
+ENUM_CLASS_FLAGS(EPlayerStatFlags);
+
+// Base attributes first, then the ones derived from them; derived rules may only read attributes above them
+UENUM(BlueprintType)
+enum class EPlayerAttribute : uint8
+{
+	Strength,
+	Endurance,
+	Willpower,
+	Luck,
+	MaxHealth,
+	MaxStamina,
+	MaxMagic,
+	DamageOutput,
+	DamageReduction,
+
+	Count UMETA(Hidden)
+};
+
+UENUM(BlueprintType)
+enum class EAttributeModifierOp : uint8
+{
+	// Added to the base value
+	Add,
+	// Multiplies (base + adds); 1.1 = +10%
+	Multiply,
+};
+
+// Attribute gets Base + PerPoint * Source. Several rules on one attribute add up.
+USTRUCT(BlueprintType)
+struct FDerivedAttributeRule
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	EPlayerAttribute Attribute = EPlayerAttribute::MaxHealth;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	EPlayerAttribute Source = EPlayerAttribute::Strength;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float Base = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float PerPoint = 0.f;
+};
+
+// ChangedStats is an EPlayerStatFlags mask. This used to have no params; a Blueprint event bound to the old
+// version needs "Refresh Nodes" (or re-creating) to pick up the new signature.
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnStatsChanged, UPARAM(meta=(Bitmask, BitmaskEnum="/Script/CPP_Tests.EPlayerStatFlags")) int32, ChangedStats);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnDamaged, float, DamageAmount, AActor*, DamageInstigator);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnDied);
 
@@ -25,13 +89,13 @@ public:
 	UPROPERTY(BlueprintAssignable, Category="Stats|Combat")
 	FOnDied OnDied;
 
-	// Upgradable stats
+	// Upgradable stats (base values; modifiers apply on top, see GetAttribute)
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Stats|Upgradable") int32 Strength = 5;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Stats|Upgradable") int32 Endurance = 5;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Stats|Upgradable") int32 Willpower = 5;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Stats|Upgradable") int32 Luck = 5;
 
-	// Derived max values
+	// Derived max values, cached from the attribute rules and modifiers
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Stats|Derived") float MaxHealth = 100.f;
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Stats|Derived") float MaxStamina = 100.f;
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Stats|Derived") float MaxMagic = 100.f;
@@ -41,8 +105,8 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Stats|Current") float Stamina = 100.f;
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Stats|Current") float Magic = 100.f;
 
-	// Economy
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Stats|Economy", meta=(ClampMin="0"))
+	// Economy. Read-only to Blueprints so every change goes through ModifyCurrency/SpendCurrency and broadcasts.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Stats|Economy", meta=(ClampMin="0"))
 	int32 Currency = 0;
 
 	UFUNCTION(BlueprintCallable, Category="Stats|Economy")
@@ -57,9 +121,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Stats|Economy")
 	bool SpendCurrency(int32 Cost);
 
-	// Base combat numbers
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Stats|Combat") float BaseDamageOutput = 10.f;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Stats|Combat") float BaseDamageReduction = 0.f;
+	// Base combat numbers, cached like the max values
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Stats|Combat") float BaseDamageOutput = 10.f;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Stats|Combat") float BaseDamageReduction = 0.f;
+
+	// How derived attributes follow the base ones
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Stats|Attributes")
+	TArray<FDerivedAttributeRule> DerivedRules;
 
 	// Sprint / regen tuning
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Stats|Stamina") float StaminaDrainPerSecond_Sprinting = 20.f;
@@ -79,8 +147,29 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Stats|Stamina") float GetAvailableStaminaMax() const;
 	UFUNCTION(BlueprintCallable, Category="Stats|Stamina") float GetStaminaPercentOfAvailable() const;
 
+	// Marks every base attribute dirty; call after writing Strength etc. directly
 	UFUNCTION(BlueprintCallable, Category="Stats") void RecalculateDerivedStats(bool bKeepCurrentPercents = true);
 
+	// Cached final value (base or derived, modifiers included)
+	UFUNCTION(BlueprintPure, Category="Stats|Attributes")
+	float GetAttribute(EPlayerAttribute Attribute) const { return Attribute < EPlayerAttribute::Count ? AttributeValues[uint8(Attribute)] : 0.f; }
+
+	// Only recomputes this attribute and what derives from it
+	UFUNCTION(BlueprintCallable, Category="Stats|Attributes")
+	void SetBaseAttribute(EPlayerAttribute Attribute, int32 Value);
+
+	// Returns a handle for RemoveModifier
+	UFUNCTION(BlueprintCallable, Category="Stats|Attributes")
+	int32 AddModifier(EPlayerAttribute Attribute, EAttributeModifierOp Op, float Magnitude, UObject* Source = nullptr);
+
+	UFUNCTION(BlueprintCallable, Category="Stats|Attributes")
+	bool RemoveModifier(int32 Handle);
+
+	// Drops everything a piece of equipment, buff etc. added; returns how many went
+	UFUNCTION(BlueprintCallable, Category="Stats|Attributes")
+	int32 RemoveModifiersFromSource(UObject* Source);
+
+	// Inside an FScopedStatTransaction these only accumulate; the transaction applies them all at once
 	UFUNCTION(BlueprintCallable, Category="Stats") void ModifyHealth(float Delta);
 	UFUNCTION(BlueprintCallable, Category="Stats") void ModifyStamina(float Delta);
 	UFUNCTION(BlueprintCallable, Category="Stats") void ModifyMagic(float Delta);
@@ -94,14 +183,102 @@ public:
 	void TickStamina(float DeltaSeconds, bool bWantsSprint, bool bIsMoving, float RegenMultiplier);
 	void TickMagic(float DeltaSeconds, float RegenMultiplier);
 
+	// Regen runs on a fixed step; these blend between the last two steps for smooth bars
+	UFUNCTION(BlueprintPure, Category="Stats|Display") float GetDisplayHealth() const { return FMath::Lerp(DisplayPrevHealth, Health, DisplayAlpha); }
+	UFUNCTION(BlueprintPure, Category="Stats|Display") float GetDisplayStamina() const { return FMath::Lerp(DisplayPrevStamina, Stamina, DisplayAlpha); }
+	UFUNCTION(BlueprintPure, Category="Stats|Display") float GetDisplayMagic() const { return FMath::Lerp(DisplayPrevMagic, Magic, DisplayAlpha); }
+
+	bool IsDisplayInterpolating() const;
+
+	// Called by whoever runs the fixed step: snapshot before each step, alpha every frame
+	void CaptureDisplaySnapshot();
+	void SetDisplayAlpha(float Alpha) { DisplayAlpha = FMath::Clamp(Alpha, 0.f, 1.f); }
+
 protected:
 	virtual void BeginPlay() override;
 
 private:
+	friend struct FScopedStatTransaction;
+
 	static float SafePercent(float Current, float Max);
 	static float ClampToRange(float Value, float Max);
 
-	void ClampStaminaToAvailable(bool& bDidChange);
-
 	bool bHasDiedBroadcast = false;
+
+	float DisplayPrevHealth = 100.f;
+	float DisplayPrevStamina = 100.f;
+	float DisplayPrevMagic = 100.f;
+	float DisplayAlpha = 1.f;
+
+	// --- Attributes ---
+	struct FAttributeModifier
+	{
+		int32 Handle = 0;
+		EAttributeModifierOp Op = EAttributeModifierOp::Add;
+		float Magnitude = 0.f;
+		// Key rather than weak pointer: a source on its way out (EndPlay, Destroyed) still matches when it cleans up
+		FObjectKey Source;
+	};
+
+	static constexpr int32 NumAttributes = int32(EPlayerAttribute::Count);
+
+	TArray<FAttributeModifier> ModifierStacks[NumAttributes];
+	float AttributeValues[NumAttributes] = { 5.f, 5.f, 5.f, 5.f, 100.f, 100.f, 100.f, 10.f, 0.f };
+
+	// Bit per attribute: who has to recompute when this one changes
+	uint32 AttributeDependents[NumAttributes] = {};
+	uint32 DirtyAttributes = 0;
+	int32 NextModifierHandle = 1;
+	bool bAttributeGraphBuilt = false;
+	bool bKeepPercentsOnFlush = true;
+
+	void BuildAttributeGraph();
+	void MarkAttributeDirty(EPlayerAttribute Attribute);
+	int32* GetBaseAttributeField(EPlayerAttribute Attribute);
+	float ComputeAttribute(EPlayerAttribute Attribute);
+	void FlushAttributes(EPlayerStatFlags& Changed);
+
+	// --- Transactions ---
+	int32 TransactionDepth = 0;
+	float PendingHealthDelta = 0.f;
+	float PendingStaminaDelta = 0.f;
+	float PendingMagicDelta = 0.f;
+	EPlayerStatFlags PendingChanges = EPlayerStatFlags::None;
+
+	void BeginTransaction();
+	void EndTransaction();
+	void CommitTransaction();
+
+	// For fields written directly (currency, attributes): broadcasts now, or with the open transaction
+	void MarkChanged(EPlayerStatFlags Flags);
+};
+
+/**
+ * Batches stat edits: ModifyHealth/Stamina/Magic inside the scope only add up deltas.
+ * When the outermost transaction ends, everything is clamped once, death is checked once
+ * and OnStatsChanged fires once with the combined EPlayerStatFlags.
+ */
+struct CPP_TESTS_API FScopedStatTransaction
+{
+	explicit FScopedStatTransaction(UPlayerStatsComponent* InStats)
+		: Stats(InStats)
+	{
+		if (Stats)
+		{
+			Stats->BeginTransaction();
+		}
+	}
+
+	~FScopedStatTransaction()
+	{
+		if (Stats)
+		{
+			Stats->EndTransaction();
+		}
+	}
+
+	UE_NONCOPYABLE(FScopedStatTransaction);
+
+private:
+	UPlayerStatsComponent* Stats = nullptr;
 };
@@ -2,21 +2,14 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "StatusEffectDataAsset.h" // EStatusEffectType
 #include "StatusEffectComponent.generated.h"
 
-DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnEffectsChanged);
+class UStatusEffectSubsystem;
 
-UENUM(BlueprintType)
-enum class EStatusEffectType : uint8
-{
-    None   UMETA(DisplayName="None"),
-    Poison UMETA(DisplayName="Poison"),
-    Fear   UMETA(DisplayName="Fear"),
-    Burn   UMETA(DisplayName="Burn"),
-    Frost  UMETA(DisplayName="Frost"),
-    Bleed  UMETA(DisplayName="Bleed")
-};
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnEffectsChanged);
 
+// Per-actor view of UStatusEffectSubsystem; the effects themselves live (and tick) there
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class CPP_TESTS_API UStatusEffectComponent : public UActorComponent
 {
@@ -28,6 +21,7 @@ public:
     UPROPERTY(BlueprintAssignable, Category="Status")
     FOnEffectsChanged OnEffectsChanged;
 
+    // Snapshots of the subsystem's values, refreshed whenever OnEffectsChanged fires (and every effect step while decaying)
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Status|Poison")
     float PoisonTimeRemaining = 0.f;
 
@@ -43,13 +37,14 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Status|Bleed")
     float BleedPoints = 0.f;
 
-    UFUNCTION(BlueprintPure, Category="Status|UI") float GetPoisonTimeRemaining() const { return PoisonTimeRemaining; }
-    UFUNCTION(BlueprintPure, Category="Status|UI") float GetFearPoints() const { return FearPoints; }
-    UFUNCTION(BlueprintPure, Category="Status|UI") bool IsBurned() const { return bBurned; }
-    UFUNCTION(BlueprintPure, Category="Status|UI") float GetFrostPoints() const { return FrostPoints; }
-    UFUNCTION(BlueprintPure, Category="Status|UI") float GetBleedPoints() const { return BleedPoints; }
+    UFUNCTION(BlueprintPure, Category="Status|UI") float GetPoisonTimeRemaining() const { return GetMagnitude(EStatusEffectType::Poison); }
+    UFUNCTION(BlueprintPure, Category="Status|UI") float GetFearPoints() const { return GetMagnitude(EStatusEffectType::Fear); }
+    UFUNCTION(BlueprintPure, Category="Status|UI") bool IsBurned() const { return GetMagnitude(EStatusEffectType::Burn) > 0.f; }
+    UFUNCTION(BlueprintPure, Category="Status|UI") float GetFrostPoints() const { return GetMagnitude(EStatusEffectType::Frost); }
+    UFUNCTION(BlueprintPure, Category="Status|UI") float GetBleedPoints() const { return GetMagnitude(EStatusEffectType::Bleed); }
 
-    // Tuning
+    // Tuning. Anything changed from these defaults gives this actor its own copy of that built-in effect
+    // (based on the configured asset, if any). Changes at runtime take effect after ApplyTuning().
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Poison", meta=(ClampMin="0.0"))
     float PoisonDamagePerSecond = 3.f;
 
@@ -89,8 +84,26 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tuning|Global", meta=(ClampMin="0.05", ClampMax="1.0"))
     float MinMoveMultiplier = 0.25f;
 
+    // Rebuilds this actor's tuned effect copies from the Tuning fields
+    UFUNCTION(BlueprintCallable, Category="Status|Tuning")
+    void ApplyTuning();
+
+    // This actor's version of a built-in effect: its tuned copy if it has one, otherwise the shared definition
+    const UStatusEffectDataAsset* GetDefinition(EStatusEffectType Type) const;
+
+    // Called by UStatusEffectSubsystem: refreshes the snapshot fields, then broadcasts if asked
+    void NotifyEffectsChanged(bool bBroadcast = true);
+
 public:
-    void TickEffects(float DeltaSeconds, class UPlayerStatsComponent* Stats, bool bIsMoving);
+    // Generic path: any effect asset, no code needed
+    UFUNCTION(BlueprintCallable, Category="Status|Apply")
+    void ApplyEffect(UStatusEffectDataAsset* Effect, float Amount);
+
+    UFUNCTION(BlueprintCallable, Category="Status|Apply")
+    void RemoveEffect(UStatusEffectDataAsset* Effect);
+
+    UFUNCTION(BlueprintPure, Category="Status")
+    float GetEffectMagnitude(UStatusEffectDataAsset* Effect) const;
 
     UFUNCTION(BlueprintCallable, Category="Status|Apply")
     void ApplyPoisonExposure();
@@ -107,6 +120,9 @@ public:
     UFUNCTION(BlueprintCallable, Category="Status|Apply")
     void AddBleedPoints(float Points);
 
+    // Keeps decay paused for a while, for sources that add points less often than every frame
+    void HoldExposure(EStatusEffectType Type, float Seconds);
+
     // Generic helper (tools can call this)
     UFUNCTION(BlueprintCallable, Category="Status|Apply")
     void AddStatusPoints(EStatusEffectType Type, float Points);
@@ -122,9 +138,10 @@ protected:
     virtual void BeginPlay() override;
 
 private:
-    bool bFearExposedThisFrame = false;
-    bool bFrostExposedThisFrame = false;
-    bool bBleedExposedThisFrame = false;
+    // Indexed by EStatusEffectType; null = use the shared definition
+    UPROPERTY(Transient)
+    TObjectPtr<UStatusEffectDataAsset> TunedDefinitions[6];
 
-    void BroadcastIfChanged(bool& bAnyChanged);
+    UStatusEffectSubsystem* GetEffectSubsystem() const;
+    float GetMagnitude(EStatusEffectType Type) const;
 };
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "StatusEffectDataAsset.generated.h"
+
+class UTexture2D;
+
+UENUM(BlueprintType)
+enum class EStatusEffectType : uint8
+{
+	None   UMETA(DisplayName="None"),
+	Poison UMETA(DisplayName="Poison"),
+	Fear   UMETA(DisplayName="Fear"),
+	Burn   UMETA(DisplayName="Burn"),
+	Frost  UMETA(DisplayName="Frost"),
+	Bleed  UMETA(DisplayName="Bleed")
+};
+
+UENUM(BlueprintType)
+enum class EStatusEffectStacking : uint8
+{
+	// Applying adds the amount on top (build-up meters)
+	Add,
+	// Applying resets the magnitude to ExposureAmount (timers, on/off effects)
+	Refresh
+};
+
+/**
+ * One status effect, described entirely by numbers. UStatusEffectSubsystem runs every effect
+ * through the same update, so a new effect is just a new asset.
+ * "Magnitude" is whatever the effect counts: build-up points, seconds left, or 1 for on/off.
+ */
+UCLASS(BlueprintType)
+class CPP_TESTS_API UStatusEffectDataAsset : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Effect")
+	FText DisplayName;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Effect")
+	TObjectPtr<UTexture2D> Icon = nullptr;
+
+	// Which of the built-in slots (hazard volumes, menu readouts) this asset fills; None for new effects
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Effect")
+	EStatusEffectType LegacyType = EStatusEffectType::None;
+
+	// --- Magnitude ---
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Magnitude")
+	EStatusEffectStacking Stacking = EStatusEffectStacking::Add;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Magnitude", meta=(ClampMin="0.0", EditCondition="Stacking==EStatusEffectStacking::Refresh"))
+	float ExposureAmount = 1.0f;
+
+	// 0 = no cap
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Magnitude", meta=(ClampMin="0.0"))
+	float MaxMagnitude = 0.0f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Magnitude", meta=(ClampMin="0.0"))
+	float DecayPerSecond = 1.0f;
+
+	// Build-up doesn't drain while the source is still being applied
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Magnitude")
+	bool bPauseDecayWhileExposed = true;
+
+	// --- Damage over time ---
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Damage", meta=(ClampMin="0.0"))
+	float HealthDamagePerSecond = 0.0f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Damage", meta=(ClampMin="0.0"))
+	float HealthDamagePerSecondPerPoint = 0.0f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Damage", meta=(ClampMin="0.0"))
+	float StaminaDrainPerSecond = 0.0f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Damage", meta=(ClampMin="0.0"))
+	float StaminaDrainPerSecondPerPoint = 0.0f;
+
+	// Replaces the stamina drain once stamina is empty (NPCs have none, so they always take this)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Damage", meta=(ClampMin="0.0"))
+	float HealthDamagePerSecondWhenNoStamina = 0.0f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Damage")
+	bool bDamageOnlyWhileMoving = false;
+
+	// --- Penalties ---
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Penalties", meta=(ClampMin="0.0"))
+	float MoveSpeedPenaltyPerPoint = 0.0f;
+
+	// Stamina and magic regen
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Penalties", meta=(ClampMin="0.0"))
+	float RegenPenaltyPerPoint = 0.0f;
+};
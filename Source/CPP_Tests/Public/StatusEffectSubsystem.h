@@ -0,0 +1,170 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "StatusEffectDataAsset.h"
+#include "StatusEffectSubsystem.generated.h"
+
+class ANPCCharacter;
+class UPlayerStatsComponent;
+class UStatusEffectComponent;
+
+// The numbers the update reads, copied out of UStatusEffectDataAsset so the loop never touches a UObject
+struct FStatusEffectParams
+{
+	float ExposureAmount = 1.0f;
+	float MaxMagnitude = 0.0f;
+	float DecayPerSecond = 0.0f;
+	float HealthPerSecond = 0.0f;
+	float HealthPerSecondPerPoint = 0.0f;
+	float StaminaPerSecond = 0.0f;
+	float StaminaPerSecondPerPoint = 0.0f;
+	float HealthPerSecondWhenNoStamina = 0.0f;
+	float MovePenaltyPerPoint = 0.0f;
+	float RegenPenaltyPerPoint = 0.0f;
+	bool bRefresh = false;
+	bool bPauseDecayWhileExposed = true;
+	bool bOnlyWhileMoving = false;
+
+	// Touches health or stamina, so it has to run in the fixed step; everything else is evaluated on demand
+	bool bTicks = false;
+};
+
+// When an instance's magnitude reaches zero. Holds only push the time later, so one pending entry per instance is enough.
+struct FStatusEffectExpiry
+{
+	double Time = 0.0;
+	TObjectKey<AActor> Actor;
+	int32 Def = INDEX_NONE;
+	uint32 Serial = 0;
+
+	bool operator<(const FStatusEffectExpiry& Other) const { return Time < Other.Time; }
+};
+
+/**
+ * Active status effects for every player and NPC, kept in flat parallel arrays.
+ * Magnitudes are stored as (value, decay start) and evaluated in closed form when read; only effects that
+ * deal damage or drain stamina run in the fixed step, and removal at zero is scheduled on a heap.
+ * Effects are UStatusEffectDataAssets; the five built-in types fall back to code defaults when no asset is configured.
+ * UStatusEffectComponent is just a per-actor view onto this.
+ */
+UCLASS(Config=Game)
+class CPP_TESTS_API UStatusEffectSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Add effects add Amount; Refresh effects ignore it and reset to their ExposureAmount
+	void ApplyEffect(AActor* Target, const UStatusEffectDataAsset* Effect, float Amount);
+	void ApplyEffect(AActor* Target, EStatusEffectType Type, float Amount);
+
+	void RemoveEffect(AActor* Target, const UStatusEffectDataAsset* Effect);
+	void ClearEffects(AActor* Target);
+
+	// Pauses decay for a while, for sources that apply less often than every frame
+	void HoldExposure(AActor* Target, const UStatusEffectDataAsset* Effect, float Seconds);
+
+	float GetMagnitude(const AActor* Target, const UStatusEffectDataAsset* Effect) const;
+	float GetMoveSpeedPenalty(const AActor* Target) const;
+	float GetRegenPenalty(const AActor* Target) const;
+
+	const UStatusEffectDataAsset* GetDefinition(EStatusEffectType Type) const;
+
+	// Same, but honours a per-actor tuned copy on the target's UStatusEffectComponent
+	const UStatusEffectDataAsset* GetDefinitionFor(const AActor* Target, EStatusEffectType Type) const;
+
+	int32 GetNumActiveEffects() const { return InstEntity.Num(); }
+	int32 GetNumTickingEffects() const { return TickingInstances.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// Assets for the built-in types (and any extras to register up front)
+	UPROPERTY(Config)
+	TArray<TSoftObjectPtr<UStatusEffectDataAsset>> DefaultEffects;
+
+	// Effects advance on a fixed step so results don't depend on framerate
+	UPROPERTY(Config, meta=(ClampMin="1.0", Units="Hz"))
+	float StepHz = 20.0f;
+
+	UPROPERTY(Config, meta=(ClampMin="1"))
+	int32 MaxStepsPerFrame = 4;
+
+	// How often entities whose actor is gone get dropped
+	UPROPERTY(Config, meta=(ClampMin="0.1", Units="s"))
+	float PruneInterval = 1.0f;
+
+	float StepAccumulator = 0.0f;
+	float TimeUntilPrune = 0.0f;
+	int32 StepCounter = 0;
+	uint32 NextSerial = 0;
+	bool bDeferEntityRemoval = false;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UStatusEffectDataAsset>> Definitions;
+
+	TArray<FStatusEffectParams> Params;
+	TMap<TObjectKey<UStatusEffectDataAsset>, int32> DefinitionLookup;
+	int32 LegacyDefinitions[6] = { INDEX_NONE, INDEX_NONE, INDEX_NONE, INDEX_NONE, INDEX_NONE, INDEX_NONE };
+
+	// --- Per entity (parallel) ---
+	TArray<TWeakObjectPtr<AActor>> EntActor;
+	TArray<TWeakObjectPtr<UPlayerStatsComponent>> EntStats;
+	TArray<TWeakObjectPtr<ANPCCharacter>> EntNPC;
+	TArray<TWeakObjectPtr<UStatusEffectComponent>> EntComponent;
+	TArray<TArray<int32, TInlineAllocator<4>>> EntInstances;
+	TArray<int32> EntStepStamp;
+	TArray<uint8> EntHasStamina;
+	TArray<uint8> EntMoving;
+	TArray<float> EntHealthDelta;
+	TArray<float> EntStaminaDelta;
+	TMap<TObjectKey<AActor>, int32> EntityLookup;
+
+	// Entities with a UStatusEffectComponent, whose UI wants to hear about decay
+	TArray<TWeakObjectPtr<AActor>> Observed;
+
+	// --- Per active effect (parallel) ---
+	TArray<int32> InstEntity;
+	TArray<int32> InstDef;
+	TArray<float> InstValue;
+	TArray<double> InstDecayStart;
+	TArray<uint32> InstSerial;
+	TArray<int32> InstTickSlot;
+
+	// Instances with bTicks set; the only thing the fixed step walks
+	TArray<int32> TickingInstances;
+	TArray<int32> StepTouched;
+
+	// Min-heap on Time
+	TArray<FStatusEffectExpiry> Expiries;
+
+	int32 FindOrAddDefinition(const UStatusEffectDataAsset* Effect);
+	void AddDefinition(UStatusEffectDataAsset* Effect);
+	UStatusEffectDataAsset* MakeBuiltInDefinition(EStatusEffectType Type);
+
+	int32 FindEntity(const AActor* Target) const;
+	int32 FindOrAddEntity(AActor* Target);
+	void RemoveEntityAt(int32 Entity);
+	void RemoveEntityIfEmpty(int32 Entity);
+
+	int32 FindInstance(int32 Entity, int32 Def) const;
+	int32 AddInstance(int32 Entity, int32 Def, double Now);
+	void RemoveInstanceAt(int32 Instance);
+
+	double GetNow() const;
+	float EvaluateMagnitude(int32 Instance, double Time) const;
+	double GetExpiryTime(int32 Instance) const;
+	void Rebase(int32 Instance, float NewValue, double DecayStart);
+
+	void StepEffects(double StepStart, float StepSeconds);
+	void ProcessExpiries(double UpTo);
+	void BroadcastObserved(double Time);
+};